@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_bench.hpp
+ *
+ * Timing helpers shared by the wrapper micro-benchmarks
+ *
+ */
+#ifndef _GNSDK_BENCH_HPP_
+#define _GNSDK_BENCH_HPP_
+
+#include "gnsdk_base.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace gracenote
+{
+	/**
+	 * Monotonic time in nanoseconds
+	 */
+	inline double
+	gn_bench_now_ns()
+	{
+#if defined(_WIN32)
+		LARGE_INTEGER count, frequency;
+
+		QueryPerformanceCounter(&count);
+		QueryPerformanceFrequency(&frequency);
+		return (double)count.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+	}
+
+	/**
+	 * Iteration count from the first command line argument, or the default
+	 * @param argc			[in] Argument count passed to main
+	 * @param argv			[in] Arguments passed to main
+	 * @param defaultCount	[in] Count used when no argument is given
+	 */
+	inline gnsdk_uint32_t
+	gn_bench_iterations(int argc, char** argv, gnsdk_uint32_t defaultCount)
+	{
+		if (argc > 1)
+		{
+			int count = atoi(argv[1]);
+			if (count > 0)
+			{
+				return (gnsdk_uint32_t)count;
+			}
+		}
+		return defaultCount;
+	}
+
+	/**
+	 * Results are added here so the compiler cannot drop the measured work
+	 */
+	inline volatile gnsdk_size_t&
+	gn_bench_sink()
+	{
+		static volatile gnsdk_size_t sink = 0;
+		return sink;
+	}
+
+}     // namespace gracenote
+
+#endif // _GNSDK_BENCH_HPP_
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_bench_chunk.cpp
+ *
+ * Counts the audio reads, and so the GNSDK fingerprint writes, needed for
+ * one track with the old fixed 1024 byte chunk and the duration based
+ * chunk sizes of GnMusicId, GnMusicIdStream and GnMusicIdFileInfo.
+ *
+ */
+#include "gnsdk_bench.hpp"
+#include "gnsdk_audiobuffer.hpp"
+
+#include <string.h>
+
+using namespace gracenote;
+
+
+/* Silent PCM of a fixed length */
+class silence_source : public IGnAudioSource
+{
+public:
+	silence_source(gnsdk_uint32_t rate, gnsdk_uint32_t bits, gnsdk_uint32_t channels, gnsdk_uint32_t seconds) :
+		rate_(rate), bits_(bits), channels_(channels),
+		total_((gnsdk_uint64_t)rate * (bits / 8) * channels * seconds), left_(0) { }
+
+	gnsdk_uint32_t	SourceInit()		{ left_ = total_; return 0; }
+	void			SourceClose()		{ }
+	gnsdk_uint32_t	SamplesPerSecond()	{ return rate_; }
+	gnsdk_uint32_t	SampleSizeInBits()	{ return bits_; }
+	gnsdk_uint32_t	NumberOfChannels()	{ return channels_; }
+
+	gnsdk_size_t
+	GetData(gnsdk_byte_t* dataBuffer, gnsdk_size_t dataSize)
+	{
+		if (dataSize > left_)
+		{
+			dataSize = (gnsdk_size_t)left_;
+		}
+		memset(dataBuffer, 0, dataSize);
+		left_ -= dataSize;
+		return dataSize;
+	}
+
+private:
+	gnsdk_uint32_t	rate_;
+	gnsdk_uint32_t	bits_;
+	gnsdk_uint32_t	channels_;
+	gnsdk_uint64_t	total_;
+	gnsdk_uint64_t	left_;
+};
+
+
+/* Reads the whole source the way FingerprintFromSource does, returns the number of reads */
+static gnsdk_uint32_t
+_read_all(IGnAudioSource& source, gnsdk_size_t chunkSize)
+{
+	const gnsdk_byte_t*	data;
+	gnsdk_uint32_t		reads = 0;
+
+	source.SourceInit();
+	{
+		gn_audio_reader reader(source, chunkSize);
+
+		while (reader.read(&data) > 0)
+		{
+			gn_bench_sink() += data[0];
+			reads++;
+		}
+	}
+	source.SourceClose();
+
+	return reads;
+}
+
+
+int
+main(int argc, char** argv)
+{
+	static const struct
+	{
+		gnsdk_uint32_t	rate;
+		gnsdk_uint32_t	bits;
+		gnsdk_uint32_t	channels;
+	} formats[] =
+	{
+		{ 44100, 16, 2 },
+		{ 48000, 16, 2 },
+		{ 22050, 16, 1 },
+		{ 11025,  8, 1 },
+	};
+	static const struct
+	{
+		const char*		name;
+		gnsdk_uint32_t	duration_ms;
+	} paths[] =
+	{
+		{ "stream 100 ms",  100  },
+		{ "musicid 1000 ms", 1000 },
+		{ "file 4000 ms",   4000 },
+	};
+	gnsdk_uint32_t	seconds = gn_bench_iterations(argc, argv, 240);
+	gnsdk_size_t	f, p;
+
+	printf("reads for %u s of audio, old 1024 byte chunk against duration based chunks\n", seconds);
+	printf("%-16s %10s", "format", "1024 B");
+	for (p = 0; p < sizeof(paths) / sizeof(paths[0]); p++)
+	{
+		printf(" %16s", paths[p].name);
+	}
+	printf("\n");
+
+	for (f = 0; f < sizeof(formats) / sizeof(formats[0]); f++)
+	{
+		silence_source	source(formats[f].rate, formats[f].bits, formats[f].channels, seconds);
+		gnsdk_uint32_t	reads;
+		char			name[32];
+
+		sprintf(name, "%u/%u/%u", formats[f].rate, formats[f].bits, formats[f].channels);
+
+		reads = _read_all(source, 1024);
+		printf("%-16s %10u", name, reads);
+		for (p = 0; p < sizeof(paths) / sizeof(paths[0]); p++)
+		{
+			gnsdk_size_t chunk = gn_audio_reader::chunk_size(source, paths[p].duration_ms);
+
+			reads = _read_all(source, chunk);
+			printf(" %16u", reads);
+		}
+		printf("\n");
+	}
+
+	return 0;
+}
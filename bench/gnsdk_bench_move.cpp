@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_bench_move.cpp
+ *
+ * Counts the gnsdk_handle_addref calls made by a typical album response
+ * walk. Build once as C++98 and once as C++11 to compare copies with moves.
+ *
+ * The GNSDK handle and GDO entry points used by the walk are defined here,
+ * so they count calls and serve a fake response instead of calling GNSDK.
+ *
+ */
+#include "gnsdk_bench.hpp"
+#include "gnsdk.hpp"
+
+#include <string.h>
+
+using namespace gracenote;
+using namespace gracenote::metadata;
+
+
+#define BENCH_ALBUMS	10
+#define BENCH_TRACKS	12
+
+static gnsdk_uint32_t	s_addrefs;
+static gnsdk_uint32_t	s_releases;
+static gnsdk_byte_t		s_gdo;
+
+
+extern "C"
+{
+
+gnsdk_error_t GNSDK_API
+gnsdk_handle_addref(gnsdk_handle_t handle)
+{
+	(void)handle;
+	s_addrefs++;
+	return GNSDK_SUCCESS;
+}
+
+gnsdk_error_t GNSDK_API
+gnsdk_handle_release(gnsdk_handle_t handle)
+{
+	(void)handle;
+	s_releases++;
+	return GNSDK_SUCCESS;
+}
+
+gnsdk_error_t GNSDK_API
+gnsdk_manager_gdo_release(gnsdk_gdo_handle_t gdo_handle)
+{
+	(void)gdo_handle;
+	return GNSDK_SUCCESS;
+}
+
+gnsdk_error_t GNSDK_API
+gnsdk_manager_gdo_child_count(gnsdk_gdo_handle_t gdo_handle, gnsdk_cstr_t child_key, gnsdk_uint32_t* p_count)
+{
+	(void)gdo_handle;
+	if (0 == strcmp(child_key, GNSDK_GDO_CHILD_ALBUM))
+	{
+		*p_count = BENCH_ALBUMS;
+	}
+	else if (0 == strcmp(child_key, GNSDK_GDO_CHILD_TRACK))
+	{
+		*p_count = BENCH_TRACKS;
+	}
+	else
+	{
+		*p_count = 1;
+	}
+	return GNSDK_SUCCESS;
+}
+
+gnsdk_error_t GNSDK_API
+gnsdk_manager_gdo_child_get(gnsdk_gdo_handle_t gdo_handle, gnsdk_cstr_t child_key, gnsdk_uint32_t ordinal, gnsdk_gdo_handle_t* p_gdo_handle)
+{
+	(void)gdo_handle; (void)child_key; (void)ordinal;
+	*p_gdo_handle = (gnsdk_gdo_handle_t)&s_gdo;
+	return GNSDK_SUCCESS;
+}
+
+gnsdk_error_t GNSDK_API
+gnsdk_manager_gdo_value_get(gnsdk_gdo_handle_t gdo_handle, gnsdk_cstr_t value_key, gnsdk_uint32_t ordinal, gnsdk_cstr_t* p_value)
+{
+	(void)gdo_handle; (void)value_key; (void)ordinal;
+	*p_value = "Paranoid Android";
+	return GNSDK_SUCCESS;
+}
+
+}
+
+
+/* Reads the album and track titles and artists of a response */
+static void
+_walk(const GnResponseAlbums& response)
+{
+	album_iterable	albums   = response.Albums();
+	album_iterator	album_it = albums.begin();
+
+	for (; album_it != albums.end(); ++album_it)
+	{
+		GnAlbum			album    = *album_it;
+		track_iterable	tracks   = album.Tracks();
+		track_iterator	track_it = tracks.begin();
+
+		gn_bench_sink() += album.Title().Display()[0];
+		gn_bench_sink() += album.Artist().Name().Display()[0];
+
+		for (; track_it != tracks.end(); ++track_it)
+		{
+			GnTrack track = *track_it;
+
+			gn_bench_sink() += track.Title().Display()[0];
+			gn_bench_sink() += track.Artist().Name().Display()[0];
+		}
+	}
+}
+
+
+int
+main(int argc, char** argv)
+{
+	gnsdk_uint32_t	walks = gn_bench_iterations(argc, argv, 100000);
+	gnsdk_uint32_t	i;
+	double			start, ns;
+
+	GnResponseAlbums response((gnsdk_gdo_handle_t)&s_gdo);
+
+	s_addrefs  = 0;
+	s_releases = 0;
+	_walk(response);
+	printf("move semantics %s, %u albums of %u tracks\n", GNWRAPPER_MOVE_SEMANTICS ? "on" : "off", BENCH_ALBUMS, BENCH_TRACKS);
+	printf("gnsdk_handle_addref per walk:  %u\n", s_addrefs);
+	printf("gnsdk_handle_release per walk: %u\n", s_releases);
+
+	start = gn_bench_now_ns();
+	for (i = 0; i < walks; i++)
+	{
+		_walk(response);
+	}
+	ns = gn_bench_now_ns() - start;
+	printf("wrapper time per walk:         %.0f ns\n", ns / walks);
+
+	return 0;
+}
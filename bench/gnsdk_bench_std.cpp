@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_bench_std.cpp
+ *
+ * gnstd string primitives on metadata string lengths, against the byte at
+ * a time loops they replaced and against the C library.
+ *
+ */
+#include "gnsdk_bench.hpp"
+
+#include <string.h>
+
+using namespace gracenote;
+
+
+/* The byte at a time implementations gnstd used before */
+static int
+_byte_strcmp(gnsdk_cstr_t lhs, gnsdk_cstr_t rhs)
+{
+	while (*lhs == *rhs)
+	{
+		if (*lhs == '\0')
+		{
+			return 0;
+		}
+		++lhs;
+		++rhs;
+	}
+	return *lhs - *rhs;
+}
+
+static gnsdk_size_t
+_byte_strlen(gnsdk_cstr_t s)
+{
+	gnsdk_size_t i = 0;
+
+	while (*(volatile const char*)(s + i))
+	{
+		i++;
+	}
+	return i;
+}
+
+static gnsdk_size_t
+_byte_strcpy(char* dest, gnsdk_size_t dest_size, gnsdk_cstr_t src)
+{
+	gnsdk_size_t count = 0;
+
+	while ((count < dest_size) && (*dest++ = *src++))
+	{
+		count++;
+	}
+	return count;
+}
+
+
+/* Hides the argument from the optimizer so every call is made */
+static gnsdk_cstr_t
+_opaque(gnsdk_cstr_t str)
+{
+	return *(gnsdk_cstr_t volatile*)&str;
+}
+
+
+int
+main(int argc, char** argv)
+{
+	static const gnsdk_cstr_t values[] =
+	{
+		"eng",
+		"Rock",
+		"Paranoid Android",
+		"Gracenote Music Genre",
+		"7097865-0C5E2F3BDC3E8CBFE1C12E2E8D29A02B",
+		"The Smashing Pumpkins - Mellon Collie and the Infinite Sadness (Remastered Deluxe)",
+	};
+	gnsdk_uint32_t	count = gn_bench_iterations(argc, argv, 10000000);
+	gnsdk_char_t	copy[128];
+	gnsdk_char_t	dest[128];
+	gnsdk_size_t	v;
+	gnsdk_uint32_t	i;
+
+	printf("ns per call, byte loop / gnstd / libc, %u iterations\n", count);
+	printf("%6s %22s %22s %22s\n", "length", "strlen", "strcmp", "strcpy");
+
+	for (v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+	{
+		gnsdk_cstr_t	str = values[v];
+		double			ns[9];
+		double			start;
+
+		/* an equal string at another address, so strcmp scans it all */
+		gnstd::gn_strcpy(copy, sizeof(copy), str);
+
+		start = gn_bench_now_ns();
+		for (i = 0; i < count; i++) { gn_bench_sink() += _byte_strlen(_opaque(str)); }
+		ns[0] = gn_bench_now_ns() - start; start += ns[0];
+		for (i = 0; i < count; i++) { gn_bench_sink() += gnstd::gn_strlen(_opaque(str)); }
+		ns[1] = gn_bench_now_ns() - start; start += ns[1];
+		for (i = 0; i < count; i++) { gn_bench_sink() += strlen(_opaque(str)); }
+		ns[2] = gn_bench_now_ns() - start; start += ns[2];
+
+		for (i = 0; i < count; i++) { gn_bench_sink() += _byte_strcmp(_opaque(str), copy); }
+		ns[3] = gn_bench_now_ns() - start; start += ns[3];
+		for (i = 0; i < count; i++) { gn_bench_sink() += gnstd::gn_strcmp(_opaque(str), copy); }
+		ns[4] = gn_bench_now_ns() - start; start += ns[4];
+		for (i = 0; i < count; i++) { gn_bench_sink() += strcmp(_opaque(str), copy); }
+		ns[5] = gn_bench_now_ns() - start; start += ns[5];
+
+		for (i = 0; i < count; i++) { gn_bench_sink() += _byte_strcpy(dest, sizeof(dest), _opaque(str)); }
+		ns[6] = gn_bench_now_ns() - start; start += ns[6];
+		for (i = 0; i < count; i++) { gn_bench_sink() += gnstd::gn_strcpy(dest, sizeof(dest), _opaque(str)); }
+		ns[7] = gn_bench_now_ns() - start; start += ns[7];
+		for (i = 0; i < count; i++) { strcpy(dest, _opaque(str)); gn_bench_sink() += dest[0]; }
+		ns[8] = gn_bench_now_ns() - start;
+
+		printf("%6u", (unsigned)strlen(str));
+		for (i = 0; i < 9; i += 3)
+		{
+			printf("   %5.1f / %5.1f / %5.1f", ns[i] / count, ns[i + 1] / count, ns[i + 2] / count);
+		}
+		printf("\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_bench_string.cpp
+ *
+ * Construct and copy throughput of GnString for typical metadata values,
+ * against a string that copies to the heap the way GnString used to, and
+ * of strings made with GnString::intern().
+ *
+ */
+#include "gnsdk_bench.hpp"
+
+using namespace gracenote;
+
+
+/* GnString before inline storage: every construction and copy allocates */
+class heap_string
+{
+public:
+	heap_string(gnsdk_cstr_t str)			: m_str(GNSDK_NULL) { set_(str); }
+	heap_string(const heap_string& str)		: m_str(GNSDK_NULL) { set_(str.m_str); }
+	~heap_string()							{ delete[] m_str; }
+
+	const char*
+	c_str() const { return m_str; }
+
+private:
+	void
+	set_(gnsdk_cstr_t str)
+	{
+		gnsdk_size_t len = gnstd::gn_strlen(str);
+
+		m_str = new char[len + 1];
+		gnstd::gn_strcpy(m_str, len + 1, str);
+	}
+
+	gnsdk_str_t m_str;
+
+	heap_string& operator = (const heap_string&);
+};
+
+
+/* GnString made with intern(), constructed from a value already in the table */
+class interned_string : public GnString
+{
+public:
+	interned_string(gnsdk_cstr_t str) : GnString(GnString::intern(str)) { }
+};
+
+
+/* Construct and copy time of one string type, in ns */
+template<typename StringType>
+static void
+_measure(gnsdk_cstr_t value, gnsdk_uint32_t count, double* pConstructNs, double* pCopyNs)
+{
+	StringType		source(value);
+	gnsdk_uint32_t	i;
+	double			start;
+
+	start = gn_bench_now_ns();
+	for (i = 0; i < count; i++)
+	{
+		StringType str(value);
+		gn_bench_sink() += str.c_str()[0];
+	}
+	*pConstructNs = (gn_bench_now_ns() - start) / count;
+
+	start = gn_bench_now_ns();
+	for (i = 0; i < count; i++)
+	{
+		StringType str(source);
+		gn_bench_sink() += str.c_str()[1];
+	}
+	*pCopyNs = (gn_bench_now_ns() - start) / count;
+}
+
+
+int
+main(int argc, char** argv)
+{
+	static const gnsdk_cstr_t values[] =
+	{
+		"Rock",
+		"GN_ID_0123456789",
+		"Alternative & Punk",
+		"7097865-0C5E2F3BDC3E8CB",
+		"The Smashing Pumpkins - Mellon Collie",
+		"A very long album title that exceeds the inline size by far",
+	};
+	gnsdk_uint32_t	count = gn_bench_iterations(argc, argv, 2000000);
+	gnsdk_size_t	v;
+
+	printf("ns per construct / copy, %u iterations\n", count);
+	printf("%6s %24s %24s %24s\n", "length", "heap copy", "GnString", "GnString::intern");
+
+	for (v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+	{
+		double heap_construct, heap_copy, construct, copy, intern_construct, intern_copy;
+
+		_measure<heap_string>(values[v], count, &heap_construct, &heap_copy);
+		_measure<GnString>(values[v], count, &construct, &copy);
+		_measure<interned_string>(values[v], count, &intern_construct, &intern_copy);
+
+		printf("%6u %12.1f / %9.1f %12.1f / %9.1f %12.1f / %9.1f\n", (unsigned)gnstd::gn_strlen(values[v]),
+			heap_construct, heap_copy, construct, copy, intern_construct, intern_copy);
+	}
+
+	return 0;
+}
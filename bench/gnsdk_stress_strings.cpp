@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_stress_strings.cpp
+ *
+ * Threads intern, copy, share and release GnString values at random, so
+ * references to the same string table entries are dropped concurrently.
+ * Meant to run under ThreadSanitizer or AddressSanitizer. Exits non-zero
+ * if a string reads back wrong or the table is not empty at the end.
+ *
+ */
+#include "gnsdk_bench.hpp"
+#include "gnsdk_thread.hpp"
+
+#include <string.h>
+
+using namespace gracenote;
+
+
+#define STRESS_VALUES	40
+#define STRESS_SLOTS	64
+#define STRESS_THREADS	8
+
+static gnsdk_char_t		s_values[STRESS_VALUES][64];
+static GnString			s_slots[STRESS_SLOTS];
+static gn_mutex			s_slot_locks[STRESS_SLOTS];
+static gn_atomic_uint32	s_errors;
+
+
+/* Values are "string table stress value NN ...", a few short enough to be stored inline */
+static void
+_make_values()
+{
+	for (gnsdk_uint32_t i = 0; i < STRESS_VALUES; i++)
+	{
+		if (i % 8)
+		{
+			sprintf(s_values[i], "string table stress value %02u padded to a long string", i);
+		}
+		else
+		{
+			sprintf(s_values[i], "short %02u", i);
+		}
+	}
+}
+
+static void
+_check(const GnString& str)
+{
+	gnsdk_cstr_t	digits;
+	gnsdk_uint32_t	index;
+
+	if (str.IsEmpty())
+	{
+		return;
+	}
+
+	digits = strchr(str.c_str(), ' ');
+	index  = digits ? (gnsdk_uint32_t)atoi(strpbrk(digits, "0123456789")) : STRESS_VALUES;
+	if ((index >= STRESS_VALUES) || gnstd::gn_strcmp(str.c_str(), s_values[index]) || (str.size() != strlen(s_values[index])))
+	{
+		s_errors.fetch_add(1);
+	}
+}
+
+
+class stress_task : public gn_task
+{
+public:
+	stress_task(gnsdk_uint32_t seed, gnsdk_uint32_t count) : seed_(seed), count_(count) { }
+
+	void
+	run()
+	{
+		for (gnsdk_uint32_t i = 0; i < count_; i++)
+		{
+			gnsdk_uint32_t	r     = _next();
+			gnsdk_uint32_t	value = r % STRESS_VALUES;
+			gnsdk_uint32_t	slot  = (r >> 8) % STRESS_SLOTS;
+
+			switch ((r >> 16) % 4)
+			{
+			case 0:
+				{
+					GnString	str = GnString::intern(s_values[value]);
+					gn_lock		lock(s_slot_locks[slot]);
+
+					s_slots[slot] = str;
+				}
+				break;
+
+			case 1:
+				{
+					GnString	str(s_values[value]);
+					gn_lock		lock(s_slot_locks[slot]);
+
+					s_slots[slot] = str;
+				}
+				break;
+
+			case 2:
+				{
+					GnString str;
+					{
+						gn_lock lock(s_slot_locks[slot]);
+
+						str = s_slots[slot];
+					}
+					_check(str);
+				}
+				break;
+
+			default:
+				{
+					GnString first  = GnString::intern(s_values[value]);
+					GnString second = GnString::intern(s_values[value]);
+
+					_check(first);
+					if ((first.size() >= 24) && (first.c_str() != second.c_str()))
+					{
+						s_errors.fetch_add(1);
+					}
+				}
+				break;
+			}
+		}
+	}
+
+private:
+	/* xorshift */
+	gnsdk_uint32_t
+	_next()
+	{
+		seed_ ^= seed_ << 13;
+		seed_ ^= seed_ >> 17;
+		seed_ ^= seed_ << 5;
+		return seed_;
+	}
+
+	gnsdk_uint32_t	seed_;
+	gnsdk_uint32_t	count_;
+};
+
+
+int
+main(int argc, char** argv)
+{
+	gnsdk_uint32_t	count = gn_bench_iterations(argc, argv, 200000);
+	stress_task*	tasks[STRESS_THREADS];
+	gn_thread		threads[STRESS_THREADS];
+	gnsdk_uint32_t	i;
+
+	_make_values();
+
+	for (i = 0; i < STRESS_THREADS; i++)
+	{
+		tasks[i] = new stress_task(2463534242u + i * 7919, count);
+		threads[i].start(tasks[i]);
+	}
+	for (i = 0; i < STRESS_THREADS; i++)
+	{
+		threads[i].join();
+		delete tasks[i];
+	}
+
+	for (i = 0; i < STRESS_SLOTS; i++)
+	{
+		_check(s_slots[i]);
+		s_slots[i] = GnString();
+	}
+
+	printf("%u threads x %u operations: %u bad strings, %u interned strings left\n", STRESS_THREADS, count, s_errors.load(), gn_string_table::count());
+
+	return (s_errors.load() || gn_string_table::count()) ? 1 : 0;
+}
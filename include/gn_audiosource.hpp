@@ -18,9 +18,12 @@
 #endif
 
 #include "gnsdk.h"
+#include <string.h>
 
 namespace gracenote
 {
+	class IGnAudioSpanSource;
+
 	/**
 	 * Delegate interface for retrieving audio data from an audio source such as a microphone, audio file
 	 * or Internet stream.
@@ -93,6 +96,111 @@ namespace gracenote
 		 */
 		virtual gnsdk_size_t
 		GetData(gnsdk_byte_t* dataBuffer, gnsdk_size_t dataSize) = 0;
+
+		/**
+		 * Return the number of bytes GetData can deliver without blocking. Consumers that service
+		 * many audio sources from a few threads, such as GnMusicIdStreamPool, use this to skip sources
+		 * with nothing to deliver. Return kDataReadyUnknown if this cannot be determined, in which
+		 * case GetData may block. Once the source has no more data it should return a non-zero value
+		 * so the consumer calls GetData and sees the end of the audio.
+		 * Implementing this method is optional.
+		 * @return Number of bytes ready, or kDataReadyUnknown
+		 */
+		virtual gnsdk_size_t
+		DataReady() { return kDataReadyUnknown; }
+
+		/**
+		 * Consumers use this to discover sources that can lend their own buffers. Implementations of
+		 * IGnAudioSpanSource return themselves; other sources must not override it.
+		 * @return Span source interface, or GNSDK_NULL
+		 */
+		virtual IGnAudioSpanSource*
+		SpanSource() { return GNSDK_NULL; }
+
+		static const gnsdk_size_t kDataReadyUnknown = (gnsdk_size_t)-1;
+	};
+
+
+	/**
+	 * Delegate interface for audio sources that already hold decoded audio in their own memory, such
+	 * as a ring buffer or a memory mapped file. Instead of copying audio into a buffer provided by the
+	 * consumer the source lends a span of its memory, which the consumer passes straight to GNSDK and
+	 * then releases.
+	 * Gracenote consumers such as GnMusicIdStream, GnMusicId and GnMusicIdFileInfo detect span sources
+	 * and use SpanAcquire and SpanRelease. Consumers only understanding IGnAudioSource call GetData,
+	 * which this interface implements by copying from spans.
+	 */
+	class IGnAudioSpanSource : public IGnAudioSource
+	{
+	public:
+		IGnAudioSpanSource() : span_data_(GNSDK_NULL), span_size_(0), span_offset_(0) { }
+		virtual ~IGnAudioSpanSource() {};
+
+		/**
+		 * Lend the next span of audio data. This is a blocking call meaning it should not return until
+		 * there is data available. The span must remain valid and unchanged until it is released.
+		 * A consumer releases each span before acquiring the next.
+		 * To signal the audio source is unable to deliver anymore data return zero. The
+		 * consumer will then stop requesting data and close the audio source.
+		 * @param pSpanData 	[out] Receives the start of the span
+		 * @return Number of bytes in the span. Return zero to indicate
+		 * 		   no more data can be delivered via the audio source.
+		 */
+		virtual gnsdk_size_t
+		SpanAcquire(const gnsdk_byte_t** pSpanData) = 0;
+
+		/**
+		 * Take back a span lent by SpanAcquire once the consumer no longer uses it.
+		 * @param spanData 		[in] Start of the span as returned by SpanAcquire
+		 * @param spanSize 		[in] Size of the span as returned by SpanAcquire
+		 */
+		virtual void
+		SpanRelease(const gnsdk_byte_t* spanData, gnsdk_size_t spanSize) = 0;
+
+		IGnAudioSpanSource*
+		SpanSource() { return this; }
+
+		/**
+		 * Copies audio from lent spans for consumers that do not use spans. A span is released
+		 * once all of it has been copied.
+		 */
+		virtual gnsdk_size_t
+		GetData(gnsdk_byte_t* dataBuffer, gnsdk_size_t dataSize)
+		{
+			gnsdk_size_t copySize;
+
+			if (0 == span_size_)
+			{
+				span_size_ = SpanAcquire(&span_data_);
+				span_offset_ = 0;
+				if (0 == span_size_)
+				{
+					return 0;
+				}
+			}
+
+			copySize = span_size_ - span_offset_;
+			if (copySize > dataSize)
+			{
+				copySize = dataSize;
+			}
+			memcpy(dataBuffer, span_data_ + span_offset_, copySize);
+
+			span_offset_ += copySize;
+			if (span_offset_ == span_size_)
+			{
+				SpanRelease(span_data_, span_size_);
+				span_data_ = GNSDK_NULL;
+				span_size_ = 0;
+			}
+
+			return copySize;
+		}
+
+	private:
+		const gnsdk_byte_t*	span_data_;
+		gnsdk_size_t		span_size_;
+		gnsdk_size_t		span_offset_;
 	};
 
 }  // namespace gracenote
@@ -26,13 +26,24 @@
 #include "gnsdk_list.hpp"
 #include "gnsdk_locale.hpp"
 #include "gnsdk_manager.hpp"
+#include "gnsdk_warmup.hpp"
+#include "gnsdk_parallel.hpp"
+#include "gnsdk_queryprofile.hpp"
+#include "gnsdk_querypool.hpp"
+#include "gnsdk_future.hpp"
 
 #if GNSDK_MUSICID
 	#include "gnsdk_musicid.hpp"
+	#include "gnsdk_musicidbatch.hpp"
+	#include "metadata_snapshot.hpp"
 #endif
 
 #if GNSDK_MUSICID_FILE
 	#include "gnsdk_musicidfile.hpp"
+	#include "gnsdk_musicidfileprefetch.hpp"
+	#include "gnsdk_musicidfilecache.hpp"
+	#include "gnsdk_musicidfilemanifest.hpp"
+	#include "gnsdk_musicidfilescan.hpp"
 #endif
 
 #if GNSDK_MUSICID_STREAM
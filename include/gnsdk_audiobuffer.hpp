@@ -0,0 +1,212 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_audiobuffer.hpp: Reusable audio buffers for wrapper audio processing */
+
+#ifndef _GNSDK_AUDIOBUFFER_HPP_
+#define _GNSDK_AUDIOBUFFER_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_thread.hpp"
+#include "gn_audiosource.hpp"
+
+
+namespace gracenote
+{
+	/**
+	 * Pool of audio buffers used by the wrapper to move audio from an IGnAudioSource to GNSDK,
+	 * for example by GnMusicIdStream::AudioProcessStart and the FingerprintFromSource methods.
+	 * Buffers are grouped by sample format and size; a buffer returned to the pool is handed out
+	 * again to the next consumer of the same format instead of being freed, so back to back files
+	 * or restarted streams do not allocate.
+	 * <p><b>Remarks:</b></p>
+	 * The wrapper uses the Default pool. Applications can inspect its counters to see how often
+	 * buffers were reused and call Trim to release cached memory.
+	 */
+	class GnAudioBufferPool
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * Construct an audio buffer pool
+		 * @param maxCachedPerFormat	[in] Maximum number of idle buffers kept for each sample format and size
+		 */
+		explicit
+		GnAudioBufferPool(gnsdk_uint32_t maxCachedPerFormat = 4);
+
+		/**
+		 * Frees cached buffers. Borrowed buffers must have been returned.
+		 */
+		~GnAudioBufferPool();
+
+		/**
+		 * Process wide pool used by the wrapper
+		 * @return Pool
+		 */
+		static GnAudioBufferPool&
+		Default();
+
+		/**
+		 * Borrow a buffer for audio of the given format
+		 * @param samplesPerSecond	[in] Number of samples per second
+		 * @param bitsPerSample		[in] Number of bits per sample
+		 * @param numberOfChannels	[in] Number of channels
+		 * @param size				[in] Buffer size in bytes
+		 * @return Buffer, must be given back with Return
+		 */
+		gnsdk_byte_t*
+		Borrow(gnsdk_uint32_t samplesPerSecond, gnsdk_uint32_t bitsPerSample, gnsdk_uint32_t numberOfChannels, gnsdk_size_t size);
+
+		/**
+		 * Give back a buffer obtained from Borrow. Null is ignored.
+		 * @param buffer	[in] Buffer
+		 */
+		void
+		Return(gnsdk_byte_t* buffer);
+
+		/**
+		 * Free all idle buffers
+		 */
+		void
+		Trim();
+
+		/**
+		 * Number of buffers handed out by Borrow
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		BorrowCount() const;
+
+		/**
+		 * Number of Borrow calls satisfied with a previously returned buffer
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		ReuseCount() const;
+
+		/**
+		 * Number of buffers allocated from the heap
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		AllocationCount() const;
+
+		/**
+		 * Number of idle buffers currently held by the pool
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		CachedCount() const;
+
+	private:
+		struct slab;
+		union header;
+
+		mutable gn_mutex	mutex_;
+		slab*				slabs_;
+		gnsdk_uint32_t		max_cached_;
+		gnsdk_uint32_t		borrowed_;
+		gnsdk_uint32_t		reused_;
+		gnsdk_uint32_t		allocated_;
+		gnsdk_uint32_t		cached_;
+
+		DISALLOW_COPY_AND_ASSIGN(GnAudioBufferPool);
+	};
+
+
+	/**
+	 * GNSDK internal class. Holds a buffer borrowed from a GnAudioBufferPool for its lifetime.
+	 */
+	class gn_audio_buffer
+	{
+	public:
+		gn_audio_buffer(gnsdk_uint32_t samplesPerSecond, gnsdk_uint32_t bitsPerSample, gnsdk_uint32_t numberOfChannels, gnsdk_size_t size,
+						GnAudioBufferPool& pool = GnAudioBufferPool::Default()) :
+			pool_(pool), data_(pool.Borrow(samplesPerSecond, bitsPerSample, numberOfChannels, size)), size_(size) { }
+
+		~gn_audio_buffer() { pool_.Return(data_); }
+
+		gnsdk_byte_t*
+		data() { return data_; }
+
+		gnsdk_size_t
+		size() const { return size_; }
+
+	private:
+		GnAudioBufferPool&	pool_;
+		gnsdk_byte_t*		data_;
+		gnsdk_size_t		size_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_audio_buffer);
+	};
+
+
+	/**
+	 * GNSDK internal class. Retrieves audio from an initialized audio source for writing to GNSDK.
+	 * Spans lent by an IGnAudioSpanSource are passed through without copying; other sources copy
+	 * into a buffer borrowed from the default GnAudioBufferPool.
+	 */
+	class gn_audio_reader
+	{
+	public:
+		/**
+		 * @param audioSource	[in] Initialized audio source
+		 * @param chunkSize		[in] Bytes requested per read from sources that copy
+		 */
+		gn_audio_reader(IGnAudioSource& audioSource, gnsdk_size_t chunkSize);
+
+		/**
+		 * Releases the span or buffer of the last read
+		 */
+		~gn_audio_reader();
+
+		/**
+		 * Retrieve the next block of audio, releasing the previous one. Blocks like IGnAudioSource::GetData.
+		 * @param pData		[out] Receives the audio, valid until the next read or destruction
+		 * @param maxSize	[in] Upper bound for sources that copy, 0 for the chunk size. Spans are
+		 *					always returned whole.
+		 * @return Number of bytes, zero once the source has no more data
+		 */
+		gnsdk_size_t
+		read(const gnsdk_byte_t** pData, gnsdk_size_t maxSize = 0);
+
+		/**
+		 * Number of bytes holding the given duration of audio in the source's format, rounded down
+		 * to whole sample frames and never less than one frame
+		 * @param audioSource	[in] Initialized audio source
+		 * @param durationMs	[in] Duration in milliseconds
+		 * @return Chunk size in bytes, zero if the source reports no format
+		 */
+		static gnsdk_size_t
+		chunk_size(IGnAudioSource& audioSource, gnsdk_uint32_t durationMs);
+
+	private:
+		void
+		_release_span();
+
+		IGnAudioSource&			source_;
+		IGnAudioSpanSource*		span_source_;
+		const gnsdk_byte_t*		span_data_;
+		gnsdk_size_t			span_size_;
+		gnsdk_byte_t*			buffer_;
+		gnsdk_size_t			chunk_size_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_audio_reader);
+	};
+
+
+}     // namespace gracenote
+
+#endif // _GNSDK_AUDIOBUFFER_HPP_
@@ -34,6 +34,44 @@
 	TypeName(const TypeName &);            \
 	void operator = (const TypeName&)
 
+/* Handle wrappers are moved rather than copied where the compiler supports it, a move
+ * transfers the native handle without the addref and release of a copy */
+#if !defined(GNWRAPPER_MOVE_SEMANTICS)
+	#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+		#define GNWRAPPER_MOVE_SEMANTICS	1
+	#else
+		#define GNWRAPPER_MOVE_SEMANTICS	0
+	#endif
+#endif
+
+/* Declaring a destructor suppresses the implicit move operations, classes that do so
+ * restore them, together with the copy operations a declared move would delete */
+#if GNWRAPPER_MOVE_SEMANTICS && !defined(SWIG)
+	#define GNSDK_MOVABLE(TypeName)                       \
+		TypeName(const TypeName&) = default;              \
+		TypeName& operator = (const TypeName&) = default; \
+		TypeName(TypeName&&) = default;                   \
+		TypeName& operator = (TypeName&&) = default;
+#else
+	#define GNSDK_MOVABLE(TypeName)
+#endif
+
+/* Hands over a value that is not used again, copies it when moves are off */
+#if GNWRAPPER_MOVE_SEMANTICS && !defined(SWIG)
+	#define GNSDK_MOVE(TypeName, value)	static_cast<TypeName&&>(value)
+#else
+	#define GNSDK_MOVE(TypeName, value)	(value)
+#endif
+
+/* Wrapper iterators declare their standard iterator category, which needs <iterator>.
+ * Define as 0 to build without it */
+#if !defined(GNWRAPPER_STD_ITERATORS)
+	#define GNWRAPPER_STD_ITERATORS		1
+#endif
+#if GNWRAPPER_STD_ITERATORS && !defined(SWIG)
+	#include <iterator>
+#endif
+
 
 #define GNSDK_CHECKED_CAST(TypeName, gdoType)                                              \
 	static gnsdk_cstr_t GnType() { return gdoType; }                                       \
@@ -515,6 +553,13 @@ namespace gracenote
 		GnObject&
 		operator= (const GnObject& rhs) throw (GnError);
 
+#if GNWRAPPER_MOVE_SEMANTICS && !defined(SWIG)
+		GnObject(GnObject&& other) throw () : handle_(other.handle_) { other.handle_ = GNSDK_NULL; }
+
+		GnObject&
+		operator= (GnObject&& rhs) throw (GnError);
+#endif
+
 		void
 		AcceptOwnership(gnsdk_handle_t handle) throw (GnError);
 
@@ -531,8 +576,140 @@ namespace gracenote
 	};
 
 
+	/**
+	 * Non-owning view of a string, a pointer and its length. The viewed string must outlive the
+	 * view. Views made from a null terminated string, a GnString or a GDO value are null terminated.
+	 */
+	class GnStringView
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * Construct a view of the empty string
+		 */
+		GnStringView() : data_(gnstd::kEmptyString), size_(0) { }
+
+		/**
+		 * Construct a view of a null terminated string
+		 * @param str [in] Native string, null is viewed as empty
+		 */
+		GnStringView(gnsdk_cstr_t str) : data_(str ? str : gnstd::kEmptyString), size_(gnstd::gn_strlen(str)) { }
+
+		/**
+		 * Construct a view of part of a string
+		 * @param str	[in] First character
+		 * @param size	[in] Number of characters
+		 */
+		GnStringView(gnsdk_cstr_t str, gnsdk_size_t size) : data_(str ? str : gnstd::kEmptyString), size_(str ? size : 0) { }
+
+		/**
+		 * Get first character
+		 * @return Pointer to the viewed characters
+		 */
+		gnsdk_cstr_t
+		data() const { return data_; }
+
+		/**
+		 * Get length
+		 * @return Number of characters
+		 */
+		gnsdk_size_t
+		size() const { return size_; }
+
+		/**
+		 * Get flag indicating if the view contains no characters
+		 * @return True if empty, false otherwise
+		 */
+		bool
+		IsEmpty() const { return 0 == size_; }
+
+		bool
+		operator==(const GnStringView& rhs) const
+		{
+			if (size_ != rhs.size_)
+				return false;
+			if (data_ == rhs.data_)
+				return true;
+			for (gnsdk_size_t i = 0; i < size_; i++)
+			{
+				if (data_[i] != rhs.data_[i])
+					return false;
+			}
+			return true;
+		}
+
+		bool
+		operator!=(const GnStringView& rhs) const { return !(*this == rhs); }
+
+	private:
+		gnsdk_cstr_t	data_;
+		gnsdk_size_t	size_;
+	};
+
+
+	/**
+	 * GNSDK internal class. Process wide table of reference counted, immutable strings. Equal
+	 * strings interned while the first is still referenced share one buffer, a string is freed
+	 * when its last reference is released. Copies made with copy() are reference counted the
+	 * same way but never looked up. Thread safe.
+	 */
+	class gn_string_table
+	{
+	public:
+		/**
+		 * Get a reference to the shared copy of a string, creating it if needed
+		 * @param str	[in] String, null is treated as empty
+		 * @return Shared copy, release with release()
+		 */
+		static gnsdk_cstr_t
+		intern(gnsdk_cstr_t str);
+
+		/**
+		 * Get a reference to a new copy of a string that is not shared with equal strings. Costs
+		 * one allocation and no lookup, for strings unlikely to repeat
+		 * @param str	[in] String, null is treated as empty
+		 * @return Copy, release with release()
+		 */
+		static gnsdk_cstr_t
+		copy(gnsdk_cstr_t str);
+
+		/**
+		 * Add a reference to a shared copy
+		 * @param interned	[in] String returned by intern() or copy()
+		 * @return interned
+		 */
+		static gnsdk_cstr_t
+		retain(gnsdk_cstr_t interned);
+
+		/**
+		 * Drop a reference to a shared copy, null is ignored
+		 * @param interned	[in] String returned by intern() or copy()
+		 */
+		static void
+		release(gnsdk_cstr_t interned);
+
+		/**
+		 * Length of a shared copy, without scanning it
+		 * @param interned	[in] String returned by intern() or copy()
+		 * @return Number of characters
+		 */
+		static gnsdk_size_t
+		length(gnsdk_cstr_t interned);
+
+		/**
+		 * Number of distinct interned strings currently held
+		 * @return Count
+		 */
+		static gnsdk_uint32_t
+		count();
+	};
+
+
 	/**
 	 * Managed immutable string as returned by GNSDK.
+	 * Short strings are stored inside the object, longer ones in a reference counted buffer shared
+	 * by copies of the object. Strings made with intern() also share it with equal interned strings.
 	 */
 	class GnString : public GnObject
 	{
@@ -542,28 +719,68 @@ namespace gracenote
 		/**
 		 * Construct an empty GnString object
 		 */
-		GnString() : m_cstr_ref(GNSDK_NULL), m_cstr(GNSDK_NULL), m_str(GNSDK_NULL) { }
+		GnString() : m_cstr_ref(GNSDK_NULL), m_cstr(GNSDK_NULL), m_str(GNSDK_NULL), m_size(0) { }
 
 		/**
 		 * Construct a GnString object from a native constant string
 		 * @param str [in] Native string
 		 */
-		GnString(gnsdk_cstr_t str) : m_cstr_ref(GNSDK_NULL), m_cstr(GNSDK_NULL), m_str(GNSDK_NULL) { set_(str); }
+		GnString(gnsdk_cstr_t str) : m_cstr_ref(GNSDK_NULL), m_cstr(GNSDK_NULL), m_str(GNSDK_NULL), m_size(0) { set_(str); }
 
 		/**
 		 * Construct a GnString object from an existing GnString object
 		 * @param str [in] GnString object
 		 */
-		GnString(const GnString& str) : GnObject(str), m_cstr_ref(str.m_cstr_ref), m_cstr(str.m_cstr_ref), m_str(GNSDK_NULL)
+		GnString(const GnString& str) : GnObject(str), m_cstr_ref(str.m_cstr_ref), m_cstr(str.m_cstr_ref), m_str(GNSDK_NULL), m_size(str.m_size)
 		{
 			if (!str.m_cstr_ref)
-				set_(str.m_str);
+				take_(str);
 		}
 
+#if GNWRAPPER_MOVE_SEMANTICS && !defined(SWIG)
+		/**
+		 * Construct a GnString object taking over the string of another, which is left empty
+		 * @param str [in] GnString object
+		 */
+		GnString(GnString&& str) throw () : GnObject(static_cast<GnObject&&>(str)), m_cstr_ref(str.m_cstr_ref), m_cstr(str.m_cstr), m_str(str.m_str), m_size(str.m_size)
+		{
+			if (str.m_cstr == str.m_inline)
+				inline_(str.m_inline, str.m_size);
+
+			str.m_cstr_ref = GNSDK_NULL;
+			str.m_cstr     = GNSDK_NULL;
+			str.m_str      = GNSDK_NULL;
+			str.m_size     = 0;
+		}
+
+		GnString&
+		operator=(GnString&& str)
+		{
+			if (this != &str)
+			{
+				GnObject::operator=(static_cast<GnObject&&>(str));
+				gn_string_table::release(m_str);
+
+				m_cstr_ref = str.m_cstr_ref;
+				m_cstr     = str.m_cstr;
+				m_str      = str.m_str;
+				m_size     = str.m_size;
+				if (str.m_cstr == str.m_inline)
+					inline_(str.m_inline, str.m_size);
+
+				str.m_cstr_ref = GNSDK_NULL;
+				str.m_cstr     = GNSDK_NULL;
+				str.m_str      = GNSDK_NULL;
+				str.m_size     = 0;
+			}
+			return *this;
+		}
+#endif
+
 		virtual
 		~GnString()
 		{
-			delete[] m_str;
+			gn_string_table::release(m_str);
 		}
 
 		GnString&
@@ -576,14 +793,21 @@ namespace gracenote
 					GnObject::operator=(str);
 					m_cstr_ref = str.m_cstr_ref;
 					m_cstr = m_cstr_ref;
+					m_size = str.m_size;
 
-					delete[] m_str;
+					gn_string_table::release(m_str);
 					m_str = GNSDK_NULL;
 				}
 			}
-			else
+			else if (this != &str)
 			{
-				set_(str.m_cstr);
+				take_(str);
+
+				if (m_cstr_ref)
+				{
+					this->AcceptOwnership(GNSDK_NULL);
+					m_cstr_ref = GNSDK_NULL;
+				}
 			}
 			return *this;
 		}
@@ -613,6 +837,13 @@ namespace gracenote
 		const char*
 		c_str() const { return m_cstr; }
 
+		/**
+		 * Get length, without scanning the string
+		 * @return Number of characters
+		 */
+		gnsdk_size_t
+		size() const { return m_size; }
+
 		/**
 		 * Get flag indicating if string object contains no string
 		 * @return True of empty, false otherwise
@@ -620,9 +851,17 @@ namespace gracenote
 		bool
 		IsEmpty() const
 		{
-			if (m_cstr && *m_cstr)
-				return false;
-			return true;
+			return (0 == m_size);
+		}
+
+		/**
+		 * Get a view of the string, valid while this object holds it
+		 * @return String view
+		 */
+		GnStringView
+		View() const
+		{
+			return GnStringView(m_cstr, m_size);
 		}
 
 		/**
@@ -636,33 +875,100 @@ namespace gracenote
 			return GnString(str, true);
 		}
 
+		/**
+		 * Construct a GnString that shares its buffer with equal strings made by intern(). Worth it
+		 * for values that repeat often, such as genres or option values, other strings only pay for
+		 * the table lookup.
+		 * @param str [in] Native string
+		 * @return String object
+		 */
+		static GnString
+		intern(gnsdk_cstr_t str)
+		{
+			GnString interned;
+
+			interned.set_(str, true);
+			return interned;
+		}
+
 	private:
+		/* strings shorter than this are stored in m_inline */
+		static const gnsdk_uint32_t kInlineSize = 24;
+
 		GnString(gnsdk_cstr_t str, bool bManaged) :
-			m_cstr_ref(str), m_cstr(str), m_str(GNSDK_NULL)
+			m_cstr_ref(str), m_cstr(str), m_str(GNSDK_NULL), m_size(gnstd::gn_strlen(str))
 		{
 			(void)bManaged;
 			this->AcceptOwnership((gnsdk_handle_t)str);
 		}
 
 		void
-		set_(gnsdk_cstr_t str)
+		set_(gnsdk_cstr_t str, bool bIntern = false)
 		{
-			delete[] m_str;
+			gnsdk_size_t len = 0;
 
-			gnsdk_size_t len = gnstd::gn_strlen(str);
-			m_str = new char[len+1];
-			if (m_str)
+			while (str && (len < kInlineSize) && str[len])
 			{
-				gnstd::gn_strcpy(m_str, len+1, str);
-				m_str[len] = 0;
+				len++;
 			}
 
-			m_cstr = m_str;
+			/* copy before releasing, str may point into the released buffer */
+			if (len < kInlineSize)
+			{
+				inline_(str, len);
+				gn_string_table::release(m_str);
+				m_str = GNSDK_NULL;
+			}
+			else
+			{
+				/* interning saves memory only when the value repeats, and costs a lookup when it does not */
+				gnsdk_cstr_t buffer = bIntern ? gn_string_table::intern(str) : gn_string_table::copy(str);
+
+				gn_string_table::release(m_str);
+				m_str  = buffer;
+				m_cstr = m_str;
+				m_size = gn_string_table::length(m_str);
+			}
+		}
+
+		/* take the unmanaged string of another object, inline strings are copied and shared ones referenced */
+		void
+		take_(const GnString& str)
+		{
+			if (str.m_str)
+			{
+				gn_string_table::retain(str.m_str);
+				gn_string_table::release(m_str);
+				m_str  = str.m_str;
+				m_cstr = m_str;
+				m_size = str.m_size;
+			}
+			else
+			{
+				inline_(str.m_cstr, str.m_size);
+				gn_string_table::release(m_str);
+				m_str = GNSDK_NULL;
+			}
+		}
+
+		void
+		inline_(gnsdk_cstr_t str, gnsdk_size_t len)
+		{
+			for (gnsdk_size_t i = 0; i < len; i++)
+			{
+				m_inline[i] = str[i];
+			}
+			m_inline[len] = 0;
+
+			m_cstr = m_inline;
+			m_size = len;
 		}
 
 		gnsdk_cstr_t	m_cstr_ref;
 		gnsdk_cstr_t	m_cstr;
-		gnsdk_str_t		m_str;
+		gnsdk_cstr_t	m_str;
+		gnsdk_size_t	m_size;
+		gnsdk_char_t	m_inline[kInlineSize];
 	};
 
 
@@ -1046,46 +1352,164 @@ namespace gracenote
 		enum { value  = v}; 
 	};
 
+	/*
+	 * Iterators made by gn_iterable_container know their end position, they stop without
+	 * fetching past it and compare against end() by position. Iterators made without an end
+	 * position compare against end() by value, as before.
+	 */
 	template<typename T, typename _Provider>
 	class gn_facade_range_iterator
 	{
 	public:
 		// typedefs for iterator_traits
 		typedef T                value_type;
-		typedef gnsdk_uint32_t   difference_type;
+		typedef gnsdk_int32_t    difference_type;
 		typedef T*               pointer;
 		typedef T&               reference;
+#if GNWRAPPER_STD_ITERATORS && !defined(SWIG)
+		typedef std::random_access_iterator_tag iterator_category;
+#endif
 		   
 		// destructor and interface.
-		~gn_facade_range_iterator() { }
+		~gn_facade_range_iterator() { delete [] window_; }
 		// this will never work for pointers to chars 
-		bool operator == (const gn_facade_range_iterator& rhs) const { return ((rhs.pos_ == GN_UINT32_MAX || pos_ == GN_UINT32_MAX)?(current_ == rhs.current_) : (pos_ == rhs.pos_)); }
+		bool operator == (const gn_facade_range_iterator& rhs) const
+		{
+			if ((end_ < GN_UINT32_MAX) && (rhs.end_ < GN_UINT32_MAX))
+			{
+				return (pos_ == rhs.pos_);
+			}
+			return ((rhs.pos_ == GN_UINT32_MAX || pos_ == GN_UINT32_MAX)?(current_ == rhs.current_) : (pos_ == rhs.pos_));
+		}
 		bool operator != (const gn_facade_range_iterator& rhs) const { return !(*this == rhs); }
 
 		reference operator* () throw (GnError){ return current_ ;}
 		pointer operator-> () throw (GnError){ return &current_ ; }
 
-		const gn_facade_range_iterator& operator++ () { current_ = provider_.get_data(++pos_); return *this; }
+		const gn_facade_range_iterator& operator++ () { ++pos_; _fetch(); return *this; }
 		gn_facade_range_iterator operator++(int) {  gn_facade_range_iterator result = *this; ++(*this) ; return result;}
-		const gn_facade_range_iterator& operator+= (gnsdk_uint32_t offset) { pos_ += offset; current_ = provider_.get_data(pos_);return *this; }
+		const gn_facade_range_iterator& operator-- () { _advance(-1); _fetch(); return *this; }
+		gn_facade_range_iterator operator--(int) {  gn_facade_range_iterator result = *this; --(*this) ; return result;}
+		const gn_facade_range_iterator& operator+= (difference_type offset) { _advance(offset); _fetch(); return *this; }
+		const gn_facade_range_iterator& operator-= (difference_type offset) { _advance(-offset); _fetch(); return *this; }
+
+		// random access, positions past the end compare equal to end()
+		gn_facade_range_iterator operator+ (difference_type offset) const { gn_facade_range_iterator result = *this; result += offset; return result; }
+		gn_facade_range_iterator operator- (difference_type offset) const { gn_facade_range_iterator result = *this; result -= offset; return result; }
+		difference_type operator- (const gn_facade_range_iterator& rhs) const { return (difference_type)(pos_ - rhs.pos_); }
+		value_type operator[] (difference_type offset) const { gn_facade_range_iterator result = *this; result += offset; return result.current_; }
+		bool operator <  (const gn_facade_range_iterator& rhs) const { return (pos_ <  rhs.pos_); }
+		bool operator >  (const gn_facade_range_iterator& rhs) const { return (pos_ >  rhs.pos_); }
+		bool operator <= (const gn_facade_range_iterator& rhs) const { return (pos_ <= rhs.pos_); }
+		bool operator >= (const gn_facade_range_iterator& rhs) const { return (pos_ >= rhs.pos_); }
 #if defined (SWIG) || defined (SWIGCPP) 		
 		// SWIG Specific interface.
-		value_type next() throw (GnError) { return (current_ = provider_.get_data(pos_++)); }
-		bool hasNext() { return  ! ((provider_.get_data(pos_)) == provider_.get_data(GN_UINT32_MAX)); }
+		value_type next() throw (GnError) { _fetch(); pos_++; return current_; }
+		bool hasNext() { return (end_ < GN_UINT32_MAX) ? (pos_ < end_) : ! ((provider_.get_data(pos_)) == provider_.get_data(GN_UINT32_MAX)); }
 #endif 
-		difference_type distance(const gn_facade_range_iterator& itr) const { return ( itr.pos_ > pos_ ) ? itr.pos_ - pos_ : pos_ - itr.pos_; }
+		gnsdk_uint32_t distance(const gn_facade_range_iterator& itr) const { return ( itr.pos_ > pos_ ) ? itr.pos_ - pos_ : pos_ - itr.pos_; }
 
 		gn_facade_range_iterator(_Provider provider, gnsdk_uint32_t pos)
-			: provider_(provider), pos_(pos)
+			: provider_(GNSDK_MOVE(_Provider, provider)), pos_(pos), end_(GN_UINT32_MAX), window_(GNSDK_NULL), window_size_(0), window_start_(0), window_count_(0)
 		{  if (pos_ < GN_UINT32_MAX) current_ = provider_.get_data(pos_); }
+
+		/**
+		 * @param provider	[in] Data provider
+		 * @param pos		[in] Position, positions at or past end are the end iterator
+		 * @param end		[in] End position
+		 * @param window	[in] Number of items to fetch ahead of the position, 0 or 1 fetches one at a time
+		 */
+		gn_facade_range_iterator(_Provider provider, gnsdk_uint32_t pos, gnsdk_uint32_t end, gnsdk_uint32_t window = 0)
+			: provider_(GNSDK_MOVE(_Provider, provider)), pos_((pos < end) ? pos : end), end_(end), window_(GNSDK_NULL), window_size_((window > 1) ? window : 0), window_start_(0), window_count_(0)
+		{ _fetch(); }
+
+		/* the prefetched items are not copied, the copy fetches its own on its next fetch */
+		gn_facade_range_iterator(const gn_facade_range_iterator& copy)
+			: provider_(copy.provider_), pos_(copy.pos_), end_(copy.end_), current_(copy.current_), window_(GNSDK_NULL), window_size_(copy.window_size_), window_start_(0), window_count_(0)
+		{ }
+		gn_facade_range_iterator& operator=(const gn_facade_range_iterator& copy)
+		{
+			if (this != &copy)
+			{
+				provider_    = copy.provider_;
+				pos_         = copy.pos_;
+				end_         = copy.end_;
+				current_     = copy.current_;
+
+				/* the window is sized on allocation, a copy with another size needs its own */
+				if (window_size_ != copy.window_size_)
+				{
+					delete [] window_;
+					window_      = GNSDK_NULL;
+					window_size_ = copy.window_size_;
+				}
+				window_start_ = 0;
+				window_count_ = 0;
+			}
+			return *this;
+		}
+
 	private:
+		void _advance(difference_type offset)
+		{
+			if (offset < 0)
+			{
+				gnsdk_uint32_t back = (gnsdk_uint32_t)(-(offset + 1)) + 1;
+
+				pos_ = (back < pos_) ? pos_ - back : 0;
+			}
+			else if (end_ < GN_UINT32_MAX)
+			{
+				pos_ = (pos_ < end_ && (gnsdk_uint32_t)offset < end_ - pos_) ? pos_ + offset : end_;
+			}
+			else
+			{
+				pos_ += offset;
+			}
+		}
+
+		void _fetch()
+		{
+			if (pos_ >= end_)
+			{
+				current_ = T();
+				return;
+			}
+
+			if (0 == window_size_)
+			{
+				current_ = provider_.get_data(pos_);
+				return;
+			}
+
+			if ((pos_ < window_start_) || (pos_ - window_start_ >= window_count_))
+			{
+				if (GNSDK_NULL == window_)
+				{
+					window_ = new T[window_size_];
+				}
+
+				window_start_ = pos_;
+				for (window_count_ = 0; (window_count_ < window_size_) && (window_count_ < end_ - pos_); window_count_++)
+				{
+					window_[window_count_] = provider_.get_data(pos_ + window_count_);
+				}
+			}
+			current_ = window_[pos_ - window_start_];
+		}
+
 		_Provider      provider_;
 		gnsdk_uint32_t pos_;
+		gnsdk_uint32_t end_;
 		T              current_;
+		T*             window_;
+		gnsdk_uint32_t window_size_;
+		gnsdk_uint32_t window_start_;
+		gnsdk_uint32_t window_count_;
 	};
 	
 	// Partial template specialization for gnsdk_cstr_t types.
-	// Notes: this is due to provider buffering. 
+	// Notes: this is due to provider buffering, which also rules out fetching ahead.
 	template<typename _Provider>
 	class gn_facade_range_iterator<gnsdk_cstr_t,_Provider>
 	{
@@ -1099,42 +1523,76 @@ namespace gracenote
 		// destructor and interface.
 		~gn_facade_range_iterator() { }
 		// this will never work for pointers to chars 
-		bool operator == (const gn_facade_range_iterator& rhs) const { return ((rhs.pos_ == GN_UINT32_MAX || pos_ == GN_UINT32_MAX)?( 0 == gnstd::gn_strcmp(current_,rhs.current_))  : (pos_ == rhs.pos_)); }
+		bool operator == (const gn_facade_range_iterator& rhs) const
+		{
+			if ((end_ < GN_UINT32_MAX) && (rhs.end_ < GN_UINT32_MAX))
+			{
+				return (pos_ == rhs.pos_);
+			}
+			return ((rhs.pos_ == GN_UINT32_MAX || pos_ == GN_UINT32_MAX)?( 0 == gnstd::gn_strcmp(current_,rhs.current_))  : (pos_ == rhs.pos_));
+		}
 		bool operator != (const gn_facade_range_iterator& rhs) const { return !(*this == rhs); }
 
 		reference operator* () { return current_ ;}
 		pointer operator-> () { return &current_ ; }
 
-		const gn_facade_range_iterator& operator++ () { current_ = provider_.get_data(++pos_); return *this; }
+		const gn_facade_range_iterator& operator++ () { ++pos_; _fetch(); return *this; }
 		gn_facade_range_iterator operator++(int) {  gn_facade_range_iterator result = *this; ++(*this) ; return result;}
-		const gn_facade_range_iterator& operator+= (gnsdk_uint32_t offset) { pos_ += offset; current_ = provider_.get_data(pos_);return *this; }
+		const gn_facade_range_iterator& operator+= (gnsdk_uint32_t offset)
+		{
+			if (end_ < GN_UINT32_MAX)
+			{
+				pos_ = (pos_ < end_ && offset < end_ - pos_) ? pos_ + offset : end_;
+			}
+			else
+			{
+				pos_ += offset;
+			}
+			_fetch();
+			return *this;
+		}
 #if defined (SWIG) || defined (SWIGCPP) 		
 		// SWIG Specific interface.
-		value_type next() throw (GnError) {return (current_ = provider_.get_data(pos_++)); }
-		bool hasNext() { return ( 0 != gnstd::gn_strcmp(provider_.get_data(pos_),gnstd::kEmptyString)); }
+		value_type next() throw (GnError) { _fetch(); pos_++; return current_; }
+		bool hasNext() { return (end_ < GN_UINT32_MAX) ? (pos_ < end_) : ( 0 != gnstd::gn_strcmp(provider_.get_data(pos_),gnstd::kEmptyString)); }
 #endif 
 		difference_type distance(const gn_facade_range_iterator& itr) const { return ( itr.pos_ > pos_ ) ? itr.pos_ - pos_ : pos_ - itr.pos_; }
 
 		gn_facade_range_iterator(_Provider provider, gnsdk_uint32_t pos)
-			: provider_(provider), pos_(pos), current_(gnstd::kEmptyString)
+			: provider_(GNSDK_MOVE(_Provider, provider)), pos_(pos), end_(GN_UINT32_MAX), current_(gnstd::kEmptyString)
 		{ if (pos < GN_UINT32_MAX) current_ = provider_.get_data(pos_); }
+		gn_facade_range_iterator(_Provider provider, gnsdk_uint32_t pos, gnsdk_uint32_t end, gnsdk_uint32_t /*window*/ = 0)
+			: provider_(GNSDK_MOVE(_Provider, provider)), pos_((pos < end) ? pos : end), end_(end), current_(gnstd::kEmptyString)
+		{ _fetch(); }
 		gn_facade_range_iterator(const gn_facade_range_iterator& copy)
-			: provider_(copy.provider_), pos_(copy.pos_), current_(gnstd::kEmptyString)
-		{ if (pos_ < GN_UINT32_MAX) {current_ = provider_.get_data(pos_);} }
+			: provider_(copy.provider_), pos_(copy.pos_), end_(copy.end_), current_(gnstd::kEmptyString)
+		{ _fetch(); }
 		const gn_facade_range_iterator& operator=(const gn_facade_range_iterator& copy)
 		{
 			pos_ = copy.pos_;
+			end_ = copy.end_;
 			provider_ = copy.provider_; // is this necessary ? 
-			current_ = (pos_ < GN_UINT32_MAX) ? provider_.get_data(pos_):gnstd::kEmptyString; 
+			_fetch();
+			return *this;
 		}
 
 	private:
+		void _fetch()
+		{
+			current_ = (pos_ < end_) ? provider_.get_data(pos_) : gnstd::kEmptyString;
+		}
+
 		_Provider      provider_;
 		gnsdk_uint32_t pos_;
+		gnsdk_uint32_t end_;
 		gnsdk_cstr_t   current_;
 	};
 	
 
+	/*
+	 * The item count is read from the provider once, when the container is made. Iteration
+	 * covers the items present at that time.
+	 */
 	template<typename T, typename _Provider>
 	class gn_iterable_container
 	{
@@ -1142,23 +1600,39 @@ namespace gracenote
 	public:
 		typedef gn_facade_range_iterator<T,_Provider>  iterator;
 		gn_iterable_container(_Provider provider, gnsdk_uint32_t start)
-			:provider_(provider), start_(start)
+			:provider_(GNSDK_MOVE(_Provider, provider)), start_(start), count_(provider_.count()), window_(0)
 		{}
 	
 		
 		typedef gnsdk_uint32_t   difference_type;
 
 		// Interface for gn_iterable_container.
-		iterator            begin() const              { return iterator(provider_, start_); }
-		iterator            end() const				   { return iterator(provider_, GN_UINT32_MAX); }
+		iterator            begin() const              { return iterator(provider_, start_, start_ + count_, window_); }
+		iterator            end() const				   { return iterator(provider_, start_ + count_, start_ + count_); }
 	
-		difference_type count() const				{ return provider_.count(); }
-		iterator            at(difference_type index)  { return iterator(provider_, start_ + index); }
-		iterator operator   [] (difference_type index) { return iterator(provider_, start_ + index); }
+		difference_type count() const				{ return count_; }
+		iterator            at(difference_type index) const { return iterator(provider_, start_ + index, start_ + count_, window_); }
+
+		/**
+		 * Item at an index, an empty item if the index is out of range. Strings returned by string
+		 * containers are valid until the container is used again.
+		 * @param index	[in] 0-based index
+		 * @return Item
+		 */
+		T operator [] (difference_type index) { return provider_.get_data((index < count_) ? start_ + index : GN_UINT32_MAX); }
+
+		/**
+		 * Fetch items ahead of the iterator in batches, for iterators made after this call
+		 * @param window	[in] Number of items per batch, 0 or 1 fetches one item at a time
+		 * @return This container
+		 */
+		gn_iterable_container& prefetch(gnsdk_uint32_t window) { window_ = window; return *this; }
 	private :
 		
 		_Provider provider_;
 		gnsdk_uint32_t start_;
+		gnsdk_uint32_t count_;
+		gnsdk_uint32_t window_;
 //		iterator _end(_int_to_type<false>) const { return iterator(provider_, GN_UINT32_MAX, T());}
 //		iterator _end(_int_to_type<true>) const { return iterator(provider_, GN_UINT32_MAX, GNSDK_NULL); }
 	
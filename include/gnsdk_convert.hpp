@@ -17,8 +17,21 @@
 
 #include "gnsdk_base.hpp"
 
+/** Number of entries in a conversion table */
+#define GN_CONVERT_COUNT(table)		( sizeof(table) / sizeof((table)[0]) )
+
 namespace gracenote
 {
+	/**
+	 * GNSDK internal struct. Entry of a table converting native values to enumerated values.
+	 * Tables are sorted by native value, in gnstd::gn_strcmp order, for gnconvert::_lookup.
+	 */
+	struct gn_convert_entry
+	{
+		gnsdk_cstr_t	native;
+		gnsdk_int32_t	value;
+	};
+
 	/**
 	 * Various methods for converting to and from native values
 	 * For internal use.
@@ -28,141 +41,90 @@ namespace gracenote
 	public:
 
 		/**
-		 * Convert native language to enumerated language
-		 * @param c_region 	[in] Native language
-		 * @return Enumerated language
+		 * Binary search of a conversion table
+		 * @param table			[in] Entries sorted by native value
+		 * @param count			[in] Number of entries
+		 * @param native		[in] Native value to find
+		 * @param notFound		[in] Value returned if native is not in the table
+		 * @return Enumerated value
 		 */
-		static GnLanguage
-		_convertLanguageCCpp( gnsdk_cstr_t c_language )
+		static gnsdk_int32_t
+		_lookup( const gn_convert_entry* table, gnsdk_uint32_t count, gnsdk_cstr_t native, gnsdk_int32_t notFound )
 		{
-			GnLanguage language = kLanguageEnglish;
+			gnsdk_uint32_t low  = 0;
+			gnsdk_uint32_t high = count;
 
-			if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_ENGLISH ) == 0 )
-			{
-				language = kLanguageEnglish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_CHINESE_SIMP ) == 0 )
-			{
-				language = kLanguageChineseSimplified;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_CHINESE_TRAD ) == 0 )
-			{
-				language = kLanguageChineseTraditional;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_DUTCH ) == 0 )
-			{
-				language = kLanguageDutch;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_FRENCH ) == 0 )
-			{
-				language = kLanguageFrench;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_GERMAN ) == 0 )
-			{
-				language = kLanguageGerman;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_ITALIAN ) == 0 )
-			{
-				language = kLanguageItalian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_JAPANESE ) == 0 )
-			{
-				language = kLanguageJapanese;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_KOREAN ) == 0 )
-			{
-				language = kLanguageKorean;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_PORTUGUESE ) == 0 )
-			{
-				language = kLanguagePortuguese;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_RUSSIAN ) == 0 )
-			{
-				language = kLanguageRussian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_SPANISH ) == 0 )
-			{
-				language = kLanguageSpanish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_SWEDISH ) == 0 )
-			{
-				language = kLanguageSwedish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_THAI ) == 0 )
-			{
-				language = kLanguageThai;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_TURKISH ) == 0 )
-			{
-				language = kLanguageTurkish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_POLISH ) == 0 )
-			{
-				language = kLanguagePolish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_FARSI ) == 0 )
-			{
-				language = kLanguageFarsi;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_VIETNAMESE ) == 0 )
-			{
-				language = kLanguageVietnamese;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_HUNGARIAN ) == 0 )
-			{
-				language = kLanguageHungarian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_CZECH ) == 0 )
-			{
-				language = kLanguageCzech;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_SLOVAK ) == 0 )
-			{
-				language = kLanguageSlovak;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_ROMANIAN ) == 0 )
-			{
-				language = kLanguageRomanian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_GREEK ) == 0 )
-			{
-				language = kLanguageGreek;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_ARABIC ) == 0 )
-			{
-				language = kLanguageArabic;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_INDONESIAN ) == 0 )
-			{
-				language = kLanguageIndonesian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_FINNISH ) == 0 )
-			{
-				language = kLanguageFinnish;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_NORWEGIAN ) == 0 )
-			{
-				language = kLanguageNorwegian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_CROATIAN ) == 0 )
-			{
-				language = kLanguageCroatian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_BULGARIAN ) == 0 )
+			if ( GNSDK_NULL == native )
 			{
-				language = kLanguageBulgarian;
+				return notFound;
 			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_SERBIAN ) == 0 )
-			{
-				language = kLanguageSerbian;
-			}
-			else if ( gnstd::gn_strcmp( c_language, GNSDK_LANG_DANISH ) == 0 )
+
+			while ( low < high )
 			{
-				language = kLanguageDanish;
+				gnsdk_uint32_t mid = low + ( high - low ) / 2;
+				gnsdk_int32_t  cmp = gnstd::gn_strcmp( native, table[mid].native );
+
+				if ( cmp == 0 )
+				{
+					return table[mid].value;
+				}
+				if ( cmp < 0 )
+				{
+					high = mid;
+				}
+				else
+				{
+					low = mid + 1;
+				}
 			}
 
-			return language;
+			return notFound;
+		}
+
+		/**
+		 * Convert native language to enumerated language
+		 * @param c_region 	[in] Native language
+		 * @return Enumerated language
+		 */
+		static GnLanguage
+		_convertLanguageCCpp( gnsdk_cstr_t c_language )
+		{
+			static const gn_convert_entry languages[] =
+			{
+				{ GNSDK_LANG_ARABIC,       kLanguageArabic },
+				{ GNSDK_LANG_BULGARIAN,    kLanguageBulgarian },
+				{ GNSDK_LANG_CZECH,        kLanguageCzech },
+				{ GNSDK_LANG_DANISH,       kLanguageDanish },
+				{ GNSDK_LANG_DUTCH,        kLanguageDutch },
+				{ GNSDK_LANG_ENGLISH,      kLanguageEnglish },
+				{ GNSDK_LANG_FINNISH,      kLanguageFinnish },
+				{ GNSDK_LANG_FRENCH,       kLanguageFrench },
+				{ GNSDK_LANG_GERMAN,       kLanguageGerman },
+				{ GNSDK_LANG_GREEK,        kLanguageGreek },
+				{ GNSDK_LANG_CROATIAN,     kLanguageCroatian },
+				{ GNSDK_LANG_HUNGARIAN,    kLanguageHungarian },
+				{ GNSDK_LANG_INDONESIAN,   kLanguageIndonesian },
+				{ GNSDK_LANG_ITALIAN,      kLanguageItalian },
+				{ GNSDK_LANG_JAPANESE,     kLanguageJapanese },
+				{ GNSDK_LANG_KOREAN,       kLanguageKorean },
+				{ GNSDK_LANG_NORWEGIAN,    kLanguageNorwegian },
+				{ GNSDK_LANG_FARSI,        kLanguageFarsi },
+				{ GNSDK_LANG_POLISH,       kLanguagePolish },
+				{ GNSDK_LANG_PORTUGUESE,   kLanguagePortuguese },
+				{ GNSDK_LANG_CHINESE_SIMP, kLanguageChineseSimplified },
+				{ GNSDK_LANG_CHINESE_TRAD, kLanguageChineseTraditional },
+				{ GNSDK_LANG_ROMANIAN,     kLanguageRomanian },
+				{ GNSDK_LANG_RUSSIAN,      kLanguageRussian },
+				{ GNSDK_LANG_SLOVAK,       kLanguageSlovak },
+				{ GNSDK_LANG_SPANISH,      kLanguageSpanish },
+				{ GNSDK_LANG_SERBIAN,      kLanguageSerbian },
+				{ GNSDK_LANG_SWEDISH,      kLanguageSwedish },
+				{ GNSDK_LANG_THAI,         kLanguageThai },
+				{ GNSDK_LANG_TURKISH,      kLanguageTurkish },
+				{ GNSDK_LANG_VIETNAMESE,   kLanguageVietnamese }
+			};
+
+			return (GnLanguage)_lookup( languages, GN_CONVERT_COUNT(languages), c_language, kLanguageEnglish );
 		}
 
 		/**
@@ -173,41 +135,46 @@ namespace gracenote
 		static gnsdk_cstr_t
 		_convertLangCppC( GnLanguage language )
 		{
-			switch ( language )
-			{
-			case kLanguageArabic:             return GNSDK_LANG_ARABIC;
-			case kLanguageBulgarian:          return GNSDK_LANG_BULGARIAN;
-			case kLanguageChineseSimplified:  return GNSDK_LANG_CHINESE_SIMP;
-			case kLanguageChineseTraditional: return GNSDK_LANG_CHINESE_TRAD;
-			case kLanguageCroatian:           return GNSDK_LANG_CROATIAN;
-			case kLanguageCzech:              return GNSDK_LANG_CZECH;
-			case kLanguageDanish:             return GNSDK_LANG_DANISH;
-			case kLanguageDutch:              return GNSDK_LANG_DUTCH;
-			case kLanguageEnglish:            return GNSDK_LANG_ENGLISH;
-			case kLanguageFarsi:              return GNSDK_LANG_FARSI;
-			case kLanguageFinnish:            return GNSDK_LANG_FINNISH;
-			case kLanguageFrench:             return GNSDK_LANG_FRENCH;
-			case kLanguageGerman:             return GNSDK_LANG_GERMAN;
-			case kLanguageGreek:              return GNSDK_LANG_GREEK;
-			case kLanguageHungarian:          return GNSDK_LANG_HUNGARIAN;
-			case kLanguageIndonesian:         return GNSDK_LANG_INDONESIAN;
-			case kLanguageItalian:            return GNSDK_LANG_ITALIAN;
-			case kLanguageJapanese:           return GNSDK_LANG_JAPANESE;
-			case kLanguageKorean:             return GNSDK_LANG_KOREAN;
-			case kLanguageNorwegian:          return GNSDK_LANG_NORWEGIAN;
-			case kLanguagePolish:             return GNSDK_LANG_POLISH;
-			case kLanguagePortuguese:         return GNSDK_LANG_PORTUGUESE;
-			case kLanguageRomanian:           return GNSDK_LANG_ROMANIAN;
-			case kLanguageRussian:            return GNSDK_LANG_RUSSIAN;
-			case kLanguageSerbian:    		  return GNSDK_LANG_SERBIAN;
-			case kLanguageSlovak:             return GNSDK_LANG_SLOVAK;
-			case kLanguageSpanish:            return GNSDK_LANG_SPANISH;
-			case kLanguageSwedish:            return GNSDK_LANG_SWEDISH;
-			case kLanguageThai:               return GNSDK_LANG_THAI;
-			case kLanguageTurkish:            return GNSDK_LANG_TURKISH;
-			case kLanguageVietnamese:         return GNSDK_LANG_VIETNAMESE;
-			case kLanguageInvalid:
-				break;
+			/* indexed by GnLanguage */
+			static const gnsdk_cstr_t languages[] =
+			{
+				GNSDK_NULL,                 /* kLanguageInvalid */
+				GNSDK_LANG_ARABIC,          /* kLanguageArabic */
+				GNSDK_LANG_BULGARIAN,       /* kLanguageBulgarian */
+				GNSDK_LANG_CHINESE_SIMP,    /* kLanguageChineseSimplified */
+				GNSDK_LANG_CHINESE_TRAD,    /* kLanguageChineseTraditional */
+				GNSDK_LANG_CROATIAN,        /* kLanguageCroatian */
+				GNSDK_LANG_CZECH,           /* kLanguageCzech */
+				GNSDK_LANG_DANISH,          /* kLanguageDanish */
+				GNSDK_LANG_DUTCH,           /* kLanguageDutch */
+				GNSDK_LANG_ENGLISH,         /* kLanguageEnglish */
+				GNSDK_LANG_FARSI,           /* kLanguageFarsi */
+				GNSDK_LANG_FINNISH,         /* kLanguageFinnish */
+				GNSDK_LANG_FRENCH,          /* kLanguageFrench */
+				GNSDK_LANG_GERMAN,          /* kLanguageGerman */
+				GNSDK_LANG_GREEK,           /* kLanguageGreek */
+				GNSDK_LANG_HUNGARIAN,       /* kLanguageHungarian */
+				GNSDK_LANG_INDONESIAN,      /* kLanguageIndonesian */
+				GNSDK_LANG_ITALIAN,         /* kLanguageItalian */
+				GNSDK_LANG_JAPANESE,        /* kLanguageJapanese */
+				GNSDK_LANG_KOREAN,          /* kLanguageKorean */
+				GNSDK_LANG_NORWEGIAN,       /* kLanguageNorwegian */
+				GNSDK_LANG_POLISH,          /* kLanguagePolish */
+				GNSDK_LANG_PORTUGUESE,      /* kLanguagePortuguese */
+				GNSDK_LANG_ROMANIAN,        /* kLanguageRomanian */
+				GNSDK_LANG_RUSSIAN,         /* kLanguageRussian */
+				GNSDK_LANG_SERBIAN,         /* kLanguageSerbian */
+				GNSDK_LANG_SLOVAK,          /* kLanguageSlovak */
+				GNSDK_LANG_SPANISH,         /* kLanguageSpanish */
+				GNSDK_LANG_SWEDISH,         /* kLanguageSwedish */
+				GNSDK_LANG_THAI,            /* kLanguageThai */
+				GNSDK_LANG_TURKISH,         /* kLanguageTurkish */
+				GNSDK_LANG_VIETNAMESE       /* kLanguageVietnamese */
+			};
+
+			if ( (gnsdk_uint32_t)language < GN_CONVERT_COUNT(languages) )
+			{
+				return languages[language];
 			}
 
 			return GNSDK_NULL;
@@ -221,54 +188,21 @@ namespace gracenote
 		static GnRegion
 		_convertRegionCCpp( gnsdk_cstr_t c_region )
 		{
-			GnRegion region = kRegionDefault;
-
-			if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_DEFAULT ) == 0 )
-			{
-				region = kRegionDefault;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_GLOBAL ) == 0 )
-			{
-				region = kRegionGlobal;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_US ) == 0 )
-			{
-				region = kRegionUS;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_JAPAN ) == 0 )
-			{
-				region = kRegionJapan;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_CHINA ) == 0 )
-			{
-				region = kRegionChina;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_TAIWAN ) == 0 )
-			{
-				region = kRegionTaiwan;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_KOREA ) == 0 )
-			{
-				region = kRegionKorea;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_EUROPE ) == 0 )
-			{
-				region = kRegionEurope;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_NORTH_AMERICA ) == 0 )
-			{
-				region = kRegionNorthAmerica;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_LATIN_AMERICA ) == 0 )
-			{
-				region = kRegionLatinAmerica;
-			}
-			else if ( gnstd::gn_strcmp( c_region, GNSDK_REGION_INDIA ) == 0 )
-			{
-				region = kRegionIndia;
-			}
-
-			return region;
+			/* GNSDK_REGION_NORTH_AMERICA is GNSDK_REGION_US */
+			static const gn_convert_entry regions[] =
+			{
+				{ GNSDK_REGION_CHINA,         kRegionChina },
+				{ GNSDK_REGION_EUROPE,        kRegionEurope },
+				{ GNSDK_REGION_GLOBAL,        kRegionGlobal },
+				{ GNSDK_REGION_INDIA,         kRegionIndia },
+				{ GNSDK_REGION_JAPAN,         kRegionJapan },
+				{ GNSDK_REGION_KOREA,         kRegionKorea },
+				{ GNSDK_REGION_LATIN_AMERICA, kRegionLatinAmerica },
+				{ GNSDK_REGION_TAIWAN,        kRegionTaiwan },
+				{ GNSDK_REGION_US,            kRegionUS }
+			};
+
+			return (GnRegion)_lookup( regions, GN_CONVERT_COUNT(regions), c_region, kRegionDefault );
 		}
 
 		/**
@@ -279,19 +213,25 @@ namespace gracenote
 		static gnsdk_cstr_t
 		_convertRegionCppC( GnRegion region )
 		{
-			switch ( region )
+			/* indexed by GnRegion */
+			static const gnsdk_cstr_t regions[] =
 			{
-			case kRegionDefault:      return GNSDK_REGION_DEFAULT;
-			case kRegionGlobal:       return GNSDK_REGION_GLOBAL;
-			case kRegionNorthAmerica:
-			case kRegionUS:           return GNSDK_REGION_US;
-			case kRegionJapan:        return GNSDK_REGION_JAPAN;
-			case kRegionChina:        return GNSDK_REGION_CHINA;
-			case kRegionTaiwan:       return GNSDK_REGION_TAIWAN;
-			case kRegionKorea:        return GNSDK_REGION_KOREA;
-			case kRegionEurope:       return GNSDK_REGION_EUROPE;
-			case kRegionLatinAmerica: return GNSDK_REGION_LATIN_AMERICA;
-			case kRegionIndia: 		  return GNSDK_REGION_INDIA;
+				GNSDK_REGION_DEFAULT,       /* kRegionDefault */
+				GNSDK_REGION_GLOBAL,        /* kRegionGlobal */
+				GNSDK_REGION_US,            /* kRegionUS */
+				GNSDK_REGION_JAPAN,         /* kRegionJapan */
+				GNSDK_REGION_CHINA,         /* kRegionChina */
+				GNSDK_REGION_TAIWAN,        /* kRegionTaiwan */
+				GNSDK_REGION_KOREA,         /* kRegionKorea */
+				GNSDK_REGION_EUROPE,        /* kRegionEurope */
+				GNSDK_REGION_US,            /* kRegionNorthAmerica */
+				GNSDK_REGION_LATIN_AMERICA, /* kRegionLatinAmerica */
+				GNSDK_REGION_INDIA          /* kRegionIndia */
+			};
+
+			if ( (gnsdk_uint32_t)region < GN_CONVERT_COUNT(regions) )
+			{
+				return regions[region];
 			}
 
 			return GNSDK_REGION_DEFAULT;
@@ -305,22 +245,13 @@ namespace gracenote
 		static GnDescriptor
 		_convertDescriptorCCpp( gnsdk_cstr_t c_descriptor )
 		{
-			GnDescriptor desc = kDescriptorDefault;
-
-			if ( gnstd::gn_strcmp( c_descriptor, GNSDK_DESCRIPTOR_DEFAULT ) == 0 )
+			static const gn_convert_entry descriptors[] =
 			{
-				desc = kDescriptorDefault;
-			}
-			else if ( gnstd::gn_strcmp( c_descriptor, GNSDK_DESCRIPTOR_SIMPLIFIED ) == 0 )
-			{
-				desc = kDescriptorSimplified;
-			}
-			else if ( gnstd::gn_strcmp( c_descriptor, GNSDK_DESCRIPTOR_DETAILED ) == 0 )
-			{
-				desc = kDescriptorDetailed;
-			}
+				{ GNSDK_DESCRIPTOR_DETAILED,   kDescriptorDetailed },
+				{ GNSDK_DESCRIPTOR_SIMPLIFIED, kDescriptorSimplified }
+			};
 
-			return desc;
+			return (GnDescriptor)_lookup( descriptors, GN_CONVERT_COUNT(descriptors), c_descriptor, kDescriptorDefault );
 		}
 
 		/**
@@ -331,12 +262,19 @@ namespace gracenote
 		static gnsdk_cstr_t
 		_convertDescCppC( GnDescriptor descriptor )
 		{
-			switch ( descriptor )
+			/* indexed by GnDescriptor */
+			static const gnsdk_cstr_t descriptors[] =
 			{
-			case kDescriptorDefault:    return GNSDK_DESCRIPTOR_DEFAULT;
-			case kDescriptorSimplified: return GNSDK_DESCRIPTOR_SIMPLIFIED;
-			case kDescriptorDetailed:   return GNSDK_DESCRIPTOR_DETAILED;
+				GNSDK_DESCRIPTOR_DEFAULT,    /* kDescriptorDefault */
+				GNSDK_DESCRIPTOR_SIMPLIFIED, /* kDescriptorSimplified */
+				GNSDK_DESCRIPTOR_DETAILED    /* kDescriptorDetailed */
+			};
+
+			if ( (gnsdk_uint32_t)descriptor < GN_CONVERT_COUNT(descriptors) )
+			{
+				return descriptors[descriptor];
 			}
+
 			return GNSDK_DESCRIPTOR_DEFAULT;
 		}
 
@@ -348,51 +286,55 @@ namespace gracenote
 		static gnsdk_cstr_t
 		_convertContentTypeCppC( GnContentType contentType )
 		{
-			gnsdk_cstr_t key = GNSDK_NULL;
-
-			switch (contentType)
+			/* indexed by GnContentType */
+			static const gnsdk_cstr_t keys[] =
 			{
-			case kContentTypeImageCover:
-				key = GNSDK_GDO_CHILD_CONTENT_IMAGECOVER;
-				break;
+				GNSDK_NULL,                               /* kContentTypeNull */
+				GNSDK_NULL,                               /* kContentTypeUnknown */
+				GNSDK_GDO_CHILD_CONTENT_IMAGECOVER,       /* kContentTypeImageCover */
+				GNSDK_GDO_CHILD_CONTENT_IMAGEARTIST,      /* kContentTypeImageArtist */
+				GNSDK_GDO_CHILD_CONTENT_IMAGEVIDEO,       /* kContentTypeImageVideo */
+				GNSDK_GDO_CHILD_CONTENT_BIOGRAPHY,        /* kContentTypeBiography */
+				GNSDK_GDO_CHILD_CONTENT_REVIEW,           /* kContentTypeReview */
+				GNSDK_CONTENT_TYPE_TEXT_NEWS,             /* kContentTypeNews */
+				GNSDK_CONTENT_TYPE_TEXT_ARTISTNEWS,       /* kContentTypeArtistNews */
+				GNSDK_CONTENT_TYPE_TEXT_LISTENERCOMMENTS, /* kContentTypeListenerComments */
+				GNSDK_CONTENT_TYPE_TEXT_RELEASECOMMENTS   /* kContentTypeReleaseComments */
+			};
 
-			case kContentTypeImageArtist:
-				key = GNSDK_GDO_CHILD_CONTENT_IMAGEARTIST;
-				break;
-
-			case kContentTypeImageVideo:
-				key = GNSDK_GDO_CHILD_CONTENT_IMAGEVIDEO;
-				break;
-
-			case kContentTypeBiography:
-				key = GNSDK_GDO_CHILD_CONTENT_BIOGRAPHY;
-				break;
-
-			case kContentTypeReview:
-				key = GNSDK_GDO_CHILD_CONTENT_REVIEW;
-				break;
-
-			case kContentTypeNews:
-				key = GNSDK_CONTENT_TYPE_TEXT_NEWS;
-				break;
-
-			case kContentTypeArtistNews:
-				key = GNSDK_CONTENT_TYPE_TEXT_ARTISTNEWS;
-				break;
+			if ( (gnsdk_uint32_t)contentType < GN_CONVERT_COUNT(keys) )
+			{
+				return keys[contentType];
+			}
 
-			case kContentTypeListenerComments:
-				key = GNSDK_CONTENT_TYPE_TEXT_LISTENERCOMMENTS;
-				break;
+			return GNSDK_NULL;
+		}
 
-			case kContentTypeReleaseComments:
-				key = GNSDK_CONTENT_TYPE_TEXT_RELEASECOMMENTS;
-				break;
+		/**
+		 * Convert enumerated lookup mode to native lookup mode
+		 * @param lookupMode	[in] Enumerated lookup mode
+		 * @return Native lookup mode value, GNSDK_NULL if invalid
+		 */
+		static gnsdk_cstr_t
+		_convertLookupModeCppC( GnLookupMode lookupMode )
+		{
+			/* indexed by GnLookupMode */
+			static const gnsdk_cstr_t modes[] =
+			{
+				GNSDK_NULL,                             /* kLookupModeInvalid */
+				GNSDK_LOOKUP_MODE_LOCAL,                /* kLookupModeLocal */
+				GNSDK_LOOKUP_MODE_ONLINE,               /* kLookupModeOnline */
+				GNSDK_LOOKUP_MODE_ONLINE_NOCACHE,       /* kLookupModeOnlineNoCache */
+				GNSDK_LOOKUP_MODE_ONLINE_NOCACHEREAD,   /* kLookupModeOnlineNoCacheRead */
+				GNSDK_LOOKUP_MODE_ONLINE_CACHEONLY      /* kLookupModeOnlineCacheOnly */
+			};
 
-			default:
-				break;
+			if ( (gnsdk_uint32_t)lookupMode < GN_CONVERT_COUNT(modes) )
+			{
+				return modes[lookupMode];
 			}
 
-			return key;
+			return GNSDK_NULL;
 		}
 	};
 
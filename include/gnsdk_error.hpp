@@ -115,6 +115,92 @@ namespace gracenote
 		gnsdk_error_info_t* m_pErrorInfo;
 	};
 
+
+	/**
+	 * GNSDK internal class. Error part of a GnResult, holds only the error codes.
+	 */
+	class gn_result_base
+	{
+	public:
+		/**
+		 * Whether the call succeeded
+		 * @return True if the result holds a value
+		 */
+		bool
+		IsOk() const { return 0 == error_code_; }
+
+		/**
+		 * Error code, 0 on success
+		 * @return Code
+		 */
+		gnsdk_error_t
+		ErrorCode() const { return error_code_; }
+
+		/**
+		 * Source error code, 0 on success
+		 * @return Error code
+		 */
+		gnsdk_error_t
+		SourceErrorCode() const { return source_error_code_; }
+
+		/**
+		 * Full error of a failed call. Description, API and module are available when Error() is
+		 * called before the next GNSDK call on the same thread, otherwise only the codes are set.
+		 * @return Error
+		 */
+		GnError
+		Error() const;
+
+	protected:
+		gn_result_base() : error_code_(0), source_error_code_(0) { }
+		explicit gn_result_base(gnsdk_error_t error);
+
+	private:
+		gnsdk_error_t	error_code_;
+		gnsdk_error_t	source_error_code_;
+	};
+
+
+	/**
+	 * Outcome of a Try* call, either a value or the code of the error that prevented it.
+	 * A failure costs no exception and no copy of the error strings, the full GnError
+	 * is only made when Error() or Value() asks for it.
+	 */
+	template<typename T>
+	class GnResult : public gn_result_base
+	{
+	public:
+		/**
+		 * Construct a successful result
+		 * @param value		[in] Value
+		 */
+		GnResult(const T& value) : value_(value) { }
+
+		/**
+		 * Construct the result of a GNSDK call
+		 * @param error		[in] Error code returned by the call, 0 on success
+		 * @param value		[in] Value, ignored on failure
+		 */
+		GnResult(gnsdk_error_t error, const T& value) : gn_result_base(error), value_(value) { }
+
+		/**
+		 * Value of a successful call, throws the error of a failed call
+		 * @return Value
+		 */
+		const T&
+		Value() const throw (GnError)
+		{
+			if (!IsOk())
+			{
+				throw Error();
+			}
+			return value_;
+		}
+
+	private:
+		T	value_;
+	};
+
 } /* namespace gracenote */
 
 
@@ -0,0 +1,308 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_future.hpp: Results of asynchronous calls */
+
+#ifndef _GNSDK_FUTURE_HPP_
+#define _GNSDK_FUTURE_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_thread.hpp"
+
+
+namespace gracenote
+{
+	/**
+	 * Delegate interface for receiving the outcome of an asynchronous call. Methods are called on
+	 * a wrapper worker thread, before the GnFuture of the call becomes ready. Exceptions thrown
+	 * by the methods are ignored.
+	 */
+	template<typename T>
+	class IGnAsyncEvents
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		virtual
+		~IGnAsyncEvents() { }
+
+		/**
+		 * The call succeeded
+		 * @param result	[in] Result of the call
+		 */
+		virtual void
+		AsyncResult(T& result) = 0;
+
+		/**
+		 * The call failed or was cancelled
+		 * @param error		[in] Error condition information
+		 */
+		virtual void
+		AsyncError(GnError& error) = 0;
+	};
+
+
+	/**
+	 * GNSDK internal class. State shared by the GnFuture handles of one asynchronous call and the
+	 * task running it. Deleted with its last reference.
+	 */
+	template<typename T>
+	class gn_future_state
+	{
+	public:
+		explicit
+		gn_future_state(IGnAsyncEvents<T>* pEventHandler) :
+			refs_(1), cancelled_(0), eventhandler_(pEventHandler), running_(GNSDK_NULL), done_(false), error_(GNSDK_NULL)
+		{
+		}
+
+		void
+		retain() { refs_.fetch_add(1); }
+
+		void
+		release()
+		{
+			if (1 == refs_.fetch_sub(1))
+			{
+				delete this;
+			}
+		}
+
+		/* cancellable of the running call, set while the call runs */
+		void
+		running(IGnCancellable* pCancellable)
+		{
+			gn_lock lock(mutex_);
+
+			running_ = pCancellable;
+			if (running_ && cancelled_.load())
+			{
+				running_->SetCancel(true);
+			}
+		}
+
+		void
+		cancel()
+		{
+			gn_lock lock(mutex_);
+
+			cancelled_.store(1);
+			if (running_)
+			{
+				running_->SetCancel(true);
+			}
+		}
+
+		bool
+		cancelled() const { return 0 != cancelled_.load(); }
+
+		void
+		complete(const T& value)
+		{
+			value_ = value;
+			if (eventhandler_)
+			{
+				/* a throwing delegate must not turn the result into an error or leave waiters blocked */
+				try
+				{
+					eventhandler_->AsyncResult(value_);
+				}
+				catch (...)
+				{
+				}
+			}
+			_done();
+		}
+
+		void
+		fail(const GnError& error)
+		{
+			error_ = new GnError(error);
+			if (eventhandler_)
+			{
+				try
+				{
+					eventhandler_->AsyncError(*error_);
+				}
+				catch (...)
+				{
+				}
+			}
+			_done();
+		}
+
+		bool
+		wait(gnsdk_uint32_t timeout_ms)
+		{
+			gn_lock lock(mutex_);
+
+			if (GN_UINT32_MAX == timeout_ms)
+			{
+				while (!done_)
+				{
+					done_cond_.wait(mutex_);
+				}
+				return true;
+			}
+
+			gnsdk_uint64_t deadline = gn_thread::tick_ms() + timeout_ms;
+
+			while (!done_)
+			{
+				gnsdk_uint64_t now = gn_thread::tick_ms();
+
+				if (now >= deadline)
+				{
+					return false;
+				}
+				done_cond_.wait(mutex_, (gnsdk_uint32_t)(deadline - now));
+			}
+			return true;
+		}
+
+		/* only valid once wait has returned true */
+		const T&
+		value() const throw (GnError)
+		{
+			if (error_)
+			{
+				throw GnError(*error_);
+			}
+			return value_;
+		}
+
+		const GnError*
+		error() const { return error_; }
+
+	private:
+		~gn_future_state() { delete error_; }
+
+		void
+		_done()
+		{
+			gn_lock lock(mutex_);
+
+			running_ = GNSDK_NULL;
+			done_    = true;
+			done_cond_.notify_all();
+		}
+
+		gn_atomic_uint32		refs_;
+		gn_atomic_uint32		cancelled_;
+		IGnAsyncEvents<T>*		eventhandler_;
+		gn_mutex				mutex_;
+		gn_condition			done_cond_;
+		IGnCancellable*			running_;
+		bool					done_;
+		T						value_;
+		GnError*				error_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_future_state);
+	};
+
+
+	/**
+	 * \class GnFuture
+	 * Result of an asynchronous call such as GnMusicId::FindAlbumsAsync, available once the call
+	 * has completed. Copies of a GnFuture refer to the same call. A call can be cancelled through
+	 * the IGnCancellable interface, cancelling a call that has not started yet keeps it from
+	 * running, a running call is aborted at its next status update. A cancelled call fails with
+	 * GNSDKERR_Aborted.
+	 */
+	template<typename T>
+	class GnFuture : public IGnCancellable
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * For internal use. Construct a future of the given call state, taking a reference to it.
+		 */
+		explicit
+		GnFuture(gn_future_state<T>* state) : state_(state) { state_->retain(); }
+
+		GnFuture(const GnFuture& other) : IGnCancellable(), state_(other.state_) { state_->retain(); }
+
+		GnFuture&
+		operator= (const GnFuture& other)
+		{
+			other.state_->retain();
+			state_->release();
+			state_ = other.state_;
+			return *this;
+		}
+
+		virtual
+		~GnFuture() { state_->release(); }
+
+		/**
+		 * Wait for the call to complete (up to timeout_ms milliseconds)
+		 * @param timeout_ms	[in] Timeout in milliseconds, GN_UINT32_MAX to wait indefinitely
+		 * @return true if the call completed, false if timed out
+		 */
+		bool
+		Wait(gnsdk_uint32_t timeout_ms = GN_UINT32_MAX) const { return state_->wait(timeout_ms); }
+
+		/**
+		 * Whether the call has completed
+		 * @return True if Get will not block
+		 */
+		bool
+		IsReady() const { return state_->wait(0); }
+
+		/**
+		 * Wait for the call to complete and get its result, throws the error of a failed call
+		 * @return Result
+		 */
+		const T&
+		Get() const throw (GnError)
+		{
+			state_->wait(GN_UINT32_MAX);
+			return state_->value();
+		}
+
+		/**
+		 * Wait for the call to complete and get whether it succeeded
+		 * @return True on success, false if the call failed or was cancelled
+		 */
+		bool
+		IsOk() const
+		{
+			state_->wait(GN_UINT32_MAX);
+			return GNSDK_NULL == state_->error();
+		}
+
+		/**
+		 * Cancel the call
+		 * @param bCancel	[in] True to cancel, false is ignored as a cancelled call cannot be resumed
+		 */
+		virtual void
+		SetCancel(bool bCancel)
+		{
+			if (bCancel)
+			{
+				state_->cancel();
+			}
+		}
+
+		virtual bool
+		IsCancelled() { return state_->cancelled(); }
+
+	private:
+		gn_future_state<T>*		state_;
+	};
+
+}     // namespace gracenote
+
+#endif // _GNSDK_FUTURE_HPP_
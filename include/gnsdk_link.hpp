@@ -16,6 +16,7 @@
 #endif
 
 #include "gnsdk_base.hpp"
+#include "gnsdk_queryprofile.hpp"
 #include "gnsdk_list.hpp"
 #include "metadata_music.hpp"
 
@@ -303,6 +304,13 @@ namespace gracenote
 			 */
 			void
 			Clear() throw (GnError);
+
+			/**
+			 *  Set all options of a query profile, options the Link query does not support are ignored
+			 *  @param profile [in] Options prepared once with GnQueryProfile
+			 */
+			void
+			Profile(const GnQueryProfile& profile) throw (GnError);
 			
 		protected:
 			GnLinkOptions() : weakhandle_(GNSDK_NULL) {}
@@ -324,6 +332,15 @@ namespace gracenote
 
 			GnLink(const GnListElement& listElement, const GnUser& user, IGnStatusEvents* pEventHandler = GNSDK_NULL) throw (GnError);
 
+			/**
+			 * Construct a GnLink without input, set the input with Input() before retrieving content.
+			 * Allows one GnLink to be reused for several inputs, e.g. by GnQueryPool.
+			 * @param user			[in] User
+			 * @param pEventHandler	[in] Status event handler
+			 */
+			explicit
+			GnLink(const GnUser& user, IGnStatusEvents* pEventHandler = GNSDK_NULL) throw (GnError);
+
 			virtual
 			~GnLink();
 
@@ -367,6 +384,20 @@ namespace gracenote
 			
 			GnLinkOptions&  Options() { return options_;}
 
+			/**
+			 * Set the data object content is retrieved for, replacing the previous input
+			 * @param gnDataObject	[in] Data object, e.g. an album or track
+			 */
+			void
+			Input(const metadata::GnDataObject& gnDataObject) throw (GnError);
+
+			/**
+			 * Set the list element content is retrieved for, replacing the previous input
+			 * @param listElement	[in] List element, e.g. a genre
+			 */
+			void
+			Input(const GnListElement& listElement) throw (GnError);
+
 			/* image contents */
 
 			/**
@@ -578,6 +609,7 @@ namespace gracenote
 
 			virtual
 			~GnLinkContent();
+			GNSDK_MOVABLE(GnLinkContent)
 
 			/**
 			 * Copy content data to provided buffer (must be of at least DataSize() )
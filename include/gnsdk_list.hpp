@@ -342,6 +342,7 @@ namespace gracenote
 		 */		
 		virtual
 		~GnListElement() { }
+		GNSDK_MOVABLE(GnListElement)
 
 
 		/**
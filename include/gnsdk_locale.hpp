@@ -253,6 +253,7 @@ namespace gracenote
 
 		virtual
 		~GnLocale();
+		GNSDK_MOVABLE(GnLocale)
 
 		/**
 		* Get Locale information 95
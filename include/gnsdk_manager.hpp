@@ -46,6 +46,8 @@
 
 namespace gracenote
 {
+	class GnWarmUpPlan;
+
 	/**
 	 * GNSDK persistent store configuration and maintenance operations
 	 */
@@ -277,6 +279,28 @@ namespace gracenote
 		void
 		TestGracenoteConnection(const GnUser& user) throw (GnError);
 
+		/**
+		 * Initializes GNSDK modules up front, for example at service start, instead of on first
+		 * use by a query object. Modules already initialized are skipped.
+		 * @param moduleMask	[in] Combination of GNSDK_MODULE_ values. Modules not built into
+		 *						the wrapper are ignored
+		 * @return Modules of moduleMask that are initialized
+		 */
+		static gnsdk_uint32_t
+		Preload(gnsdk_uint32_t moduleMask) throw (GnError);
+
+		/**
+		 * Loads the locales and lists and initializes the modules declared by a plan so first
+		 * requests do not pay for them. Modules are initialized first, then locales and lists are
+		 * loaded in parallel. The outcome and load time of each item are recorded in the plan.
+		 * Failure of an item does not stop the others.
+		 * @param user	[in] Gracenote user loading locales and lists
+		 * @param plan	[in] Items to load, receives per item results
+		 * @return True if every item was loaded
+		 */
+		bool
+		WarmUp(const GnUser& user, GnWarmUpPlan& plan) throw (GnError);
+
 		/**
 		 * Get the system event handler if previously provided
 		 * @return Event handler
@@ -297,6 +321,7 @@ namespace gracenote
 	struct _gnsdk_internal 
 	{
 		static void	module_initialize(gnsdk_uint32_t module_id) throw (GnError);
+		static gnsdk_uint32_t	modules_initialized();
 		static bool	manager_initialized();
 		static void	manager_addref();
 		static void	manager_release();
@@ -20,8 +20,10 @@
 #endif
 
 #include "gnsdk_base.hpp"
+#include "gnsdk_queryprofile.hpp"
 #include "metadata_music.hpp"
 #include "gn_audiosource.hpp"
+#include "gnsdk_future.hpp"
 
 /** 
 * \namespace gracenote
@@ -146,13 +148,30 @@ namespace gracenote
 			 */
 			void
 			Custom(gnsdk_cstr_t option, bool bEnable) throw (GnError);
+
+			/**
+			 *  Set all options of a query profile, options the MusicID query does not support are ignored
+			 *  @param profile [in] Options prepared once with GnQueryProfile
+			 */
+			void
+			Profile(const GnQueryProfile& profile) throw (GnError);
+
+			/**
+			 *  Sets the duration of audio passed to GNSDK per write by FingerprintFromSource. The chunk
+			 *  size in bytes is derived from the format of the audio source. Longer chunks mean fewer
+			 *  calls into GNSDK per fingerprint at the cost of a larger buffer.
+			 *  @param durationMs [in] Chunk duration in milliseconds, 0 restores the default of 1000
+			 */
+			void
+			AudioChunkDuration(gnsdk_uint32_t durationMs) { chunk_duration_ms_ = durationMs; }
 			
 		protected:
-			GnMusicIdOptions() : weakhandle_(GNSDK_NULL) {}
+			GnMusicIdOptions() : weakhandle_(GNSDK_NULL), chunk_duration_ms_(0) {}
 
 		private:
 			friend class GnMusicId;
 			gnsdk_musicid_query_handle_t weakhandle_;
+			gnsdk_uint32_t               chunk_duration_ms_;
 			DISALLOW_COPY_AND_ASSIGN(GnMusicIdOptions);
 		};
 
@@ -419,6 +438,152 @@ namespace gracenote
 			metadata::GnResponseDataMatches
 			FindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError);
 
+			/**
+			 *  Performs a MusicID query for album results based on text input, without throwing on failure.
+			 *  A failed query, including no match, is returned in the result: no exception is thrown and
+			 *  the error details are only copied if GnResult::Error() is called. GnError is only thrown
+			 *  if the wrapper cannot hold the response.
+			 *  @param albumTitle           [in] Album title
+			 *  @param trackTitle           [in] Track title
+			 *  @param albumArtistName      [in] Album Artist name
+			 *  @param trackArtistName      [in] Track Artist name
+			 *  @param composerName         [in] Album Composer ( e.g. Classical, Instrumental, Movie Score)
+			 *  @return Result holding a GnResponseAlbums, or the error code
+			 *
+			 * Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseAlbums>
+			TryFindAlbums(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results using CD TOC, without throwing on failure.
+			 *  See TryFindAlbums(gnsdk_cstr_t, gnsdk_cstr_t, gnsdk_cstr_t, gnsdk_cstr_t, gnsdk_cstr_t).
+			 *  @param CDTOC             [in] Compact Disc Table Of Contents
+			 *  @return Result holding a GnResponseAlbums, or the error code
+			 *
+			 *  Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseAlbums>
+			TryFindAlbums(gnsdk_cstr_t CDTOC) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results using CD TOC togther with fingerprint data,
+			 *  without throwing on failure.
+			 *  @param CDTOC             	[in] Compact Disc Table Of Contents
+			 *  @param strFingerprintData	[in] Fingerprint data
+			 *  @param fpType            	[in] One of the #GnFingerprintType fingerprint types
+			 *  @return Result holding a GnResponseAlbums, or the error code
+			 *
+			 *  Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseAlbums>
+			TryFindAlbums(gnsdk_cstr_t CDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results using fingerprint data, without throwing on failure.
+			 *  @param fingerprintData 	[in] Fingerprint data
+			 *  @param fpType 			[in] One of the #GnFingerprintType fingerprint types
+			 *  @return Result holding a GnResponseAlbums, or the error code
+			 *
+			 * Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseAlbums>
+			TryFindAlbums(gnsdk_cstr_t fingerprintData, GnFingerprintType fpType) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results, without throwing on failure.
+			 *  @param gnDataObject      [in] Gracenote data object
+			 *  @return Result holding a GnResponseAlbums, or the error code
+			 *
+			 * Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseAlbums>
+			TryFindAlbums(const metadata::GnDataObject& gnDataObject) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for best Matches results, without throwing on failure.
+			 *  @param albumTitle             [in] Album title
+			 *  @param trackTitle             [in] Track title
+			 *  @param albumArtistName        [in] Album Artist name
+			 *  @param trackArtistName        [in] Track Artist name
+			 *  @param composerName           [in] Album Composer ( e.g. Classical, Instrumental, Movie Score)
+			 *  @return Result holding a GnResponseDataMatches, or the error code
+			 *
+			 * Long Running Potential: Network I/O, File system I/O (for online query cache or local lookup)
+			 */
+			GnResult<metadata::GnResponseDataMatches>
+			TryFindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results on a wrapper worker thread. Input strings are copied.
+			 *  The GnMusicId must remain valid, and must not start another query, until the call has completed.
+			 *  Calls wait while the worker queue is full.
+			 *  @param albumTitle             [in] Album title
+			 *  @param trackTitle             [in] Track title
+			 *  @param albumArtistName        [in] Album Artist name
+			 *  @param trackArtistName        [in] Track Artist name
+			 *  @param composerName           [in] Album Composer ( e.g. Classical, Instrumental, Movie Score)
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseAlbums, cancellable
+			 */
+			GnFuture<metadata::GnResponseAlbums>
+			FindAlbumsAsync(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName,
+							IGnAsyncEvents<metadata::GnResponseAlbums>* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results on a wrapper worker thread, see FindAlbumsAsync above
+			 *  @param CDTOC                  [in] CD TOC
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseAlbums, cancellable
+			 */
+			GnFuture<metadata::GnResponseAlbums>
+			FindAlbumsAsync(gnsdk_cstr_t CDTOC, IGnAsyncEvents<metadata::GnResponseAlbums>* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results on a wrapper worker thread, see FindAlbumsAsync above
+			 *  @param CDTOC                  [in] CD TOC
+			 *  @param strFingerprintData     [in] Fingerprint data
+			 *  @param fpType                 [in] Fingerprint type
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseAlbums, cancellable
+			 */
+			GnFuture<metadata::GnResponseAlbums>
+			FindAlbumsAsync(gnsdk_cstr_t CDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType,
+							IGnAsyncEvents<metadata::GnResponseAlbums>* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results on a wrapper worker thread, see FindAlbumsAsync above
+			 *  @param fingerprintData        [in] Fingerprint data
+			 *  @param fpType                 [in] Fingerprint type
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseAlbums, cancellable
+			 */
+			GnFuture<metadata::GnResponseAlbums>
+			FindAlbumsAsync(gnsdk_cstr_t fingerprintData, GnFingerprintType fpType, IGnAsyncEvents<metadata::GnResponseAlbums>* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for album results on a wrapper worker thread, see FindAlbumsAsync above
+			 *  @param gnDataObject           [in] Gracenote data object
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseAlbums, cancellable
+			 */
+			GnFuture<metadata::GnResponseAlbums>
+			FindAlbumsAsync(const metadata::GnDataObject& gnDataObject, IGnAsyncEvents<metadata::GnResponseAlbums>* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 *  Performs a MusicID query for best Matches results on a wrapper worker thread, see FindAlbumsAsync above
+			 *  @param albumTitle             [in] Album title
+			 *  @param trackTitle             [in] Track title
+			 *  @param albumArtistName        [in] Album Artist name
+			 *  @param trackArtistName        [in] Track Artist name
+			 *  @param composerName           [in] Album Composer ( e.g. Classical, Instrumental, Movie Score)
+			 *  @param pEventHandler          [in] Optional delegate receiving the outcome on the worker thread
+			 *  @return Future of the GnResponseDataMatches, cancellable
+			 */
+			GnFuture<metadata::GnResponseDataMatches>
+			FindMatchesAsync(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName,
+							 IGnAsyncEvents<metadata::GnResponseDataMatches>* pEventHandler = GNSDK_NULL) throw (GnError);
+
 			/**
 			 * Get the event handler provided on construction
 			 * @return Event handler
@@ -453,6 +618,27 @@ namespace gracenote
 			}
 
 		private:
+			friend struct musicid_async_find;
+
+			/* finds without resetting the cancel state */
+			GnResult<metadata::GnResponseAlbums>
+			_tryFindAlbums(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError);
+
+			GnResult<metadata::GnResponseAlbums>
+			_tryFindAlbums(gnsdk_cstr_t CDTOC) throw (GnError);
+
+			GnResult<metadata::GnResponseAlbums>
+			_tryFindAlbums(gnsdk_cstr_t CDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError);
+
+			GnResult<metadata::GnResponseAlbums>
+			_tryFindAlbums(gnsdk_cstr_t fingerprintData, GnFingerprintType fpType) throw (GnError);
+
+			GnResult<metadata::GnResponseAlbums>
+			_tryFindAlbums(const metadata::GnDataObject& gnDataObject) throw (GnError);
+
+			GnResult<metadata::GnResponseDataMatches>
+			_tryFindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError);
+
 			IGnStatusEvents*	eventhandler_;
 			GnMusicIdOptions	options_;
 			bool				cancelled_;
@@ -0,0 +1,211 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_musicidbatch.hpp
+*/
+
+#ifndef _GNSDK_MUSICIDBATCH_HPP_
+#define _GNSDK_MUSICIDBATCH_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_musicid.hpp"
+#include "gnsdk_thread.hpp"
+
+namespace gracenote
+{
+	namespace musicid
+	{
+#if GNSDK_MUSICID
+
+		/**
+		 * Delegate interface for receiving GnMusicIdBatch results. Methods are called on batch
+		 * worker threads, possibly concurrently, and must be thread safe.
+		 */
+		class IGnMusicIdBatchEvents
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			virtual
+			~IGnMusicIdBatchEvents() { }
+
+			/**
+			 * Called before a query is used so the application can set options such as lookup mode.
+			 * Queries are created for each stage of each item. Overriding this method is optional.
+			 * @param query			[in] Query about to fingerprint or look up an item
+			 */
+			virtual void
+			MusicIdBatchQueryPrepare(GnMusicId& query) { GNSDK_UNUSED(query); }
+
+			/**
+			 * An item was identified
+			 * @param itemIndex		[in] Index returned by GnMusicIdBatch::Add
+			 * @param audioSource	[in] Audio source of the item
+			 * @param result		[in] Lookup response
+			 */
+			virtual void
+			MusicIdBatchResult(gnsdk_uint32_t itemIndex, IGnAudioSource& audioSource, metadata::GnResponseAlbums& result) = 0;
+
+			/**
+			 * An item could not be fingerprinted or looked up, or the batch was cancelled
+			 * @param itemIndex		[in] Index returned by GnMusicIdBatch::Add
+			 * @param audioSource	[in] Audio source of the item
+			 * @param error			[in] Error condition information
+			 */
+			virtual void
+			MusicIdBatchError(gnsdk_uint32_t itemIndex, IGnAudioSource& audioSource, GnError& error) = 0;
+		};
+
+
+		/**
+		 *  \class GnMusicIdBatch
+		 *  Identifies many audio sources by fingerprint, for example when ingesting a back catalog.
+		 *
+		 *  Items pass through two stages, each with its own worker pool: decoding and fingerprinting
+		 *  via GnMusicId::FingerprintFromSource, then lookup via GnMusicId::FindAlbums. Lookups of earlier
+		 *  items overlap with fingerprinting of later ones. Both stages have bounded queues; Add blocks
+		 *  while the fingerprint queue is full and fingerprinting pauses while the lookup queue is full,
+		 *  so memory use stays bounded regardless of the number of items.
+		 *
+		 *  Each item is reported exactly once through IGnMusicIdBatchEvents, as a result or an error.
+		 *  WaitForComplete blocks until every item added so far has been reported.
+		 *
+		 *  Note: Customers must be licensed to implement use of a MusicID product in an application.
+		 *  Contact your Gracenote support representative with questions about product licensing and
+		 *  entitlement.
+		 */
+		class GnMusicIdBatch
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 *  Constructs a batch and starts its worker threads
+			 *  @param user					[in] Gracenote user making the requests
+			 *  @param pEventHandler		[in] Result delegate
+			 *  @param fpType				[in] Fingerprint type to generate and look up
+			 *  @param fingerprintThreads	[in] Number of decode and fingerprint threads, 0 selects the number of processors
+			 *  @param lookupThreads		[in] Number of lookup threads
+			 *  @param maxQueued			[in] Maximum number of items waiting in each stage
+			 */
+			GnMusicIdBatch(const GnUser& user, IGnMusicIdBatchEvents* pEventHandler, GnFingerprintType fpType = kFingerprintTypeFile,
+						   gnsdk_uint32_t fingerprintThreads = 0, gnsdk_uint32_t lookupThreads = 4, gnsdk_uint32_t maxQueued = 16) throw (GnError);
+
+			/**
+			 *  Constructs a batch with locale and starts its worker threads
+			 *  @param user					[in] Gracenote user making the requests
+			 *  @param locale				[in] Locale representing region and language preferred for responses
+			 *  @param pEventHandler		[in] Result delegate
+			 *  @param fpType				[in] Fingerprint type to generate and look up
+			 *  @param fingerprintThreads	[in] Number of decode and fingerprint threads, 0 selects the number of processors
+			 *  @param lookupThreads		[in] Number of lookup threads
+			 *  @param maxQueued			[in] Maximum number of items waiting in each stage
+			 */
+			GnMusicIdBatch(const GnUser& user, const GnLocale& locale, IGnMusicIdBatchEvents* pEventHandler, GnFingerprintType fpType = kFingerprintTypeFile,
+						   gnsdk_uint32_t fingerprintThreads = 0, gnsdk_uint32_t lookupThreads = 4, gnsdk_uint32_t maxQueued = 16) throw (GnError);
+
+			/**
+			 * Waits for all added items to be reported, then stops the worker threads
+			 */
+			virtual
+			~GnMusicIdBatch();
+
+			/**
+			 * Queue an audio source for identification, blocking while the fingerprint stage is full.
+			 * The audio source must remain valid until its result or error has been reported.
+			 * @param audioSource	[in] Audio source, initialized and closed by the batch
+			 * @return Item index reported with the result
+			 */
+			gnsdk_uint32_t
+			Add(IGnAudioSource& audioSource) throw (GnError);
+
+			/**
+			 * Wait until every item added so far has been reported (up to timeout_ms milliseconds)
+			 * @param timeout_ms	[in] Timeout in milliseconds, GN_UINT32_MAX to wait indefinitely
+			 * @return true if all items completed, false if timed out
+			 */
+			bool
+			WaitForComplete(gnsdk_uint32_t timeout_ms = GN_UINT32_MAX);
+
+			/**
+			 * Cancel outstanding items. Queued items are reported with a GNSDKERR_Aborted error and
+			 * running queries are aborted. The batch remains cancelled, items added afterwards are
+			 * reported as aborted too.
+			 */
+			void
+			Cancel();
+
+			/**
+			 * Number of items added but not yet reported
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Pending() const;
+
+			/**
+			 * Number of items waiting for fingerprinting, not counting items being fingerprinted
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			FingerprintQueueDepth() const { return fingerprint_pool_.queued(); }
+
+			/**
+			 * Number of items waiting for lookup, not counting items being looked up
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			LookupQueueDepth() const { return lookup_pool_.queued(); }
+
+		private:
+			class item;
+			class fingerprint_task;
+			class lookup_task;
+			class canceller;
+			friend class fingerprint_task;
+			friend class lookup_task;
+			friend class canceller;
+
+			GnMusicId*
+			_create_query();
+
+			void
+			_report(item* p_item, metadata::GnResponseAlbums* p_result, GnError* p_error);
+
+			GnUser					user_;
+			GnLocale				locale_;
+			bool					has_locale_;
+			IGnMusicIdBatchEvents*	eventhandler_;
+			GnFingerprintType		fptype_;
+			IGnStatusEvents*		canceller_;
+			gn_atomic_uint32		cancelled_;
+
+			mutable gn_mutex		mutex_;
+			gn_condition			complete_cond_;
+			gnsdk_uint32_t			next_index_;
+			gnsdk_uint32_t			pending_;
+
+			gn_thread_pool			lookup_pool_;
+			gn_thread_pool			fingerprint_pool_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdBatch);
+		};
+
+
+#endif /* GNSDK_MUSICID */
+	} /* namespace musicid */
+
+}     /* namespace gracenote */
+
+#endif /* _GNSDK_MUSICIDBATCH_HPP_ */
@@ -16,6 +16,7 @@
 #endif
 
 #include "gnsdk_base.hpp"
+#include "gnsdk_queryprofile.hpp"
 #include "metadata_music.hpp"
 #include "gn_audiosource.hpp"
 
@@ -27,8 +28,12 @@ namespace gracenote
 
 		class GnMusicIdFile;
 		class GnMusicIdFileInfo;
+		class GnMusicIdFilePrefetch;
+		class GnMusicIdFileFingerprintCache;
 		class IGnMusicIdFileEvents;
 		class IGnMusicIdFileInfoEvents;
+		class IGnMusicIdFileInfoWriter;
+		class IGnMusicIdFileInfoReader;
 
 		/**
 		 *  The status value of the current query.
@@ -411,9 +416,11 @@ namespace gracenote
 			/**
 			 *  Generate a fingerprint from audio pulled from the provided audio source
 			 *  @param audioSource		[in] audio source representing the file being identified
+			 *  @param chunkDurationMs	[in] duration of audio passed to GNSDK per write, the size in bytes is
+			 *							derived from the format of the audio source. 0 selects the default of 4000
 			 */
 			void
-			FingerprintFromSource(IGnAudioSource& audioSource) throw (GnError);
+			FingerprintFromSource(IGnAudioSource& audioSource, gnsdk_uint32_t chunkDurationMs = 0) throw (GnError);
 
 			/**
 			 *  Retrieves the current status for a specific FileInfo object.
@@ -476,6 +483,7 @@ namespace gracenote
 			gnsdk_musicidfile_fileinfo_handle_t fileInfohandle_;
 
 			friend class GnMusicIdFileInfoManager;
+			friend class GnMusicIdFilePrefetch;
 		};
 
 
@@ -646,6 +654,13 @@ namespace gracenote
 			void
 			Custom(gnsdk_cstr_t option, gnsdk_cstr_t value) throw (GnError);
 
+			/**
+			 *  Set all options of a query profile, options the MusicID-File query does not support are ignored
+			 *  @param profile [in] Options prepared once with GnQueryProfile
+			 */
+			void
+			Profile(const GnQueryProfile& profile) throw (GnError);
+
 
 		protected:
 			GnMusicIdFileOptions() : weakhandle_(GNSDK_NULL) {}
@@ -692,6 +707,27 @@ namespace gracenote
 			GnString
 			RenderToXml() throw (GnError);
 
+			/**
+			 * Add audio files from a stream created using RenderToStream(). Files are read and added one
+			 * at a time, so memory use does not grow with the number of files. If the stream is truncated or
+			 * corrupt an error is thrown and the files read before it stay added.
+			 * @param reader			[in] Delegate providing the stream data
+			 * @param pEventHandler		[in-opt] Event delegate for processing events for each audio file added
+			 * @return Number of audio files added
+			 */
+			gnsdk_uint32_t
+			AddFromStream(IGnMusicIdFileInfoReader& reader, IGnMusicIdFileInfoEvents* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 * Render all added audio files to a compact binary stream, written in chunks as files are
+			 * rendered rather than held in one string as RenderToXml() does. The identifier, file name,
+			 * metadata and fingerprint of each file are rendered; results are not.
+			 * @param writer			[in] Delegate receiving the stream data
+			 * @return Number of audio files rendered
+			 */
+			gnsdk_uint32_t
+			RenderToStream(IGnMusicIdFileInfoWriter& writer) throw (GnError);
+
 			/**
 			 * Remove and audio file from GnMusicIdFile
 			 * @param fileInfo			[in] Object representing audio file to remove
@@ -706,7 +742,7 @@ namespace gracenote
 			musicid_file_info_iterator
 			begin() const {
 				musicid_file_info_provider provider(weakhandle_);
-				return musicid_file_info_iterator(provider, 1);
+				return musicid_file_info_iterator(provider, 1, 1 + provider.count());
 			}
 
 			/**
@@ -716,7 +752,7 @@ namespace gracenote
 			musicid_file_info_iterator
 			end() const {
 				musicid_file_info_provider provider(weakhandle_);
-				return musicid_file_info_iterator(provider, GN_UINT32_MAX);
+				return musicid_file_info_iterator(provider, 1 + provider.count(), 1 + provider.count());
 			}
 
 			/**
@@ -1060,6 +1096,38 @@ namespace gracenote
 			IGnMusicIdFileEvents*
 			EventHandler() const { return eventhandler_; }
 
+			/**
+			 * Attach a prefetcher that provides fingerprints ahead of GNSDK asking for them, files it
+			 * does not provide are still gathered through the event handler. The prefetcher must
+			 * remain valid while queries run.
+			 * @param pPrefetch	[in] Prefetcher, GNSDK_NULL to detach
+			 */
+			void
+			Prefetch(GnMusicIdFilePrefetch* pPrefetch) { prefetch_ = pPrefetch; }
+
+			/**
+			 * Get the attached prefetcher
+			 * @return Prefetcher, GNSDK_NULL if none
+			 */
+			GnMusicIdFilePrefetch*
+			Prefetch() const { return prefetch_; }
+
+			/**
+			 * Attach a fingerprint cache. Files found in it are not gathered, the fingerprints
+			 * gathered through the event handler are added to it. The cache must remain valid
+			 * while queries run.
+			 * @param pCache	[in] Cache, GNSDK_NULL to detach
+			 */
+			void
+			FingerprintCache(GnMusicIdFileFingerprintCache* pCache) { fingerprintcache_ = pCache; }
+
+			/**
+			 * Get the attached fingerprint cache
+			 * @return Cache, GNSDK_NULL if none
+			 */
+			GnMusicIdFileFingerprintCache*
+			FingerprintCache() const { return fingerprintcache_; }
+
 			/**
 			 * Set cancel state
 			*/
@@ -1069,6 +1137,8 @@ namespace gracenote
 
 		private:
 			IGnMusicIdFileEvents*       eventhandler_;
+			GnMusicIdFilePrefetch*      prefetch_;
+			GnMusicIdFileFingerprintCache* fingerprintcache_;
 			GnMusicIdFileOptions        options_;
 			GnMusicIdFileInfoManager    fileinfomanager_;
 		
@@ -1215,6 +1285,50 @@ namespace gracenote
 		};
 
 
+		/**
+		 *  Delegate interface receiving the stream rendered by GnMusicIdFileInfoManager::RenderToStream
+		 */
+		class IGnMusicIdFileInfoWriter
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			virtual
+			~IGnMusicIdFileInfoWriter() { };
+
+			/**
+			 * Write stream data. Override to store the data, for example to a file.
+			 * @param data				[in] Stream data
+			 * @param dataSize			[in] Size of data
+			 * @return True if written, false to stop rendering
+			 */
+			virtual bool
+			WriteData(const gnsdk_byte_t* data, gnsdk_size_t dataSize) = 0;
+		};
+
+
+		/**
+		 *  Delegate interface providing the stream read by GnMusicIdFileInfoManager::AddFromStream
+		 */
+		class IGnMusicIdFileInfoReader
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			virtual
+			~IGnMusicIdFileInfoReader() { };
+
+			/**
+			 * Get stream data. Override to provide the data written by an IGnMusicIdFileInfoWriter.
+			 * @param dataBuffer		[out] Buffer to write stream data
+			 * @param dataSize			[in] Size of buffer
+			 * @return Number of bytes written to buffer, 0 at the end of the stream
+			 */
+			virtual gnsdk_size_t
+			ReadData(gnsdk_byte_t* dataBuffer, gnsdk_size_t dataSize) = 0;
+		};
+
+
 #endif /* GNSDK_MUSICID_FILE */
 
 	} /* namespace musicid_file */
@@ -0,0 +1,177 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_musicidfilecache.hpp
+*/
+
+#ifndef _GNSDK_MUSICIDFILECACHE_HPP_
+#define _GNSDK_MUSICIDFILECACHE_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_musicidfile.hpp"
+#include "gnsdk_thread.hpp"
+
+namespace gracenote
+{
+	namespace musicid_file
+	{
+#if GNSDK_MUSICID_FILE
+
+		/**
+		 *  \class GnMusicIdFileFingerprintCache
+		 *  On-disk cache of MusicID-File fingerprints, so a rescan does not decode files that have not
+		 *  changed since they were last fingerprinted.
+		 *
+		 *  Fingerprints are keyed by file path, size and modification time, and optionally by a hash of
+		 *  samples of the file content for file systems that do not keep modification times reliably.
+		 *  The path is taken from GnMusicIdFileInfo::FileName, files without one are not cached.
+		 *
+		 *  Attach the cache with GnMusicIdFile::FingerprintCache and, when prefetching, with
+		 *  GnMusicIdFilePrefetch::FingerprintCache. A file found in the cache has its fingerprint set
+		 *  without being decoded, otherwise the fingerprint generated for it is added to the cache.
+		 *
+		 *  The cache file is memory mapped when opened; fingerprints added since are held in memory
+		 *  until Flush rewrites the file. A missing or unreadable cache file is treated as empty.
+		 *  All methods are thread safe.
+		 */
+		class GnMusicIdFileFingerprintCache
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 *  Opens a cache file, the file is created by the first Flush
+			 *  @param cachePath		[in] Path of the cache file
+			 *  @param bContentHash		[in] Also key fingerprints by a hash of the file content. A cache
+			 *  							file written with a different setting is treated as empty.
+			 */
+			GnMusicIdFileFingerprintCache(gnsdk_cstr_t cachePath, bool bContentHash = false) throw (GnError);
+
+			/**
+			 * Flushes added fingerprints, errors writing the file are ignored
+			 */
+			virtual
+			~GnMusicIdFileFingerprintCache();
+
+			/**
+			 * Set the fingerprint of a file from the cache
+			 * @param fileInfo		[in] File info with a file name
+			 * @return true if the fingerprint has been set, false if the file is not cached or changed
+			 */
+			bool
+			Lookup(GnMusicIdFileInfo& fileInfo) throw (GnError);
+
+			/**
+			 * Add the fingerprint of a file to the cache, replacing any cached for the same path.
+			 * Does nothing if the file info has no file name or fingerprint.
+			 * @param fileInfo		[in] File info with a file name and fingerprint
+			 */
+			void
+			Store(GnMusicIdFileInfo& fileInfo) throw (GnError);
+
+			/**
+			 * Write the cache file, replacing the previous one. Does nothing if no fingerprint has been
+			 * stored since the last flush.
+			 */
+			void
+			Flush() throw (GnError);
+
+			/**
+			 * Number of cached fingerprints
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Count() const;
+
+			/**
+			 * Number of lookups that set a fingerprint
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Hits() const { return hits_.load(); }
+
+			/**
+			 * Number of lookups that did not
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Misses() const { return misses_.load(); }
+
+		private:
+			struct file_key;
+			struct file_header;
+			struct file_entry;
+			struct ram_entry;
+
+			bool
+			_key(gnsdk_cstr_t path, file_key& key) const;
+
+			const file_entry*
+			_find_mapped(gnsdk_cstr_t path, gnsdk_uint32_t path_hash) const;
+
+			ram_entry*
+			_find_ram(gnsdk_cstr_t path, gnsdk_uint32_t path_hash) const;
+
+			gnsdk_cstr_t
+			_mapped_string(gnsdk_uint32_t offset, gnsdk_uint32_t length) const;
+
+			void
+			_map();
+
+			void
+			_unmap();
+
+			void
+			_write(gnsdk_cstr_t path) throw (GnError);
+
+			void
+			_clear_ram();
+
+			char*					path_;
+			bool					content_hash_;
+
+			mutable gn_mutex		mutex_;
+
+			/* cache file as last flushed */
+			void*					map_;
+			gnsdk_size_t			map_size_;
+			const file_header*		header_;
+			const gnsdk_uint32_t*	buckets_;
+			const file_entry*		entries_;
+			const char*				strings_;
+#if defined(GNSDK_WINDOWS)
+			HANDLE					file_;
+			HANDLE					mapping_;
+#endif
+
+			/* fingerprints stored since */
+			ram_entry**				ram_buckets_;
+			gnsdk_uint32_t			ram_bucket_count_;
+			gnsdk_uint32_t			ram_count_;
+			gnsdk_uint32_t			ram_new_;
+
+			gn_atomic_uint32		hits_;
+			gn_atomic_uint32		misses_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdFileFingerprintCache);
+		};
+
+
+#endif /* GNSDK_MUSICID_FILE */
+	} /* namespace musicid_file */
+
+}     /* namespace gracenote */
+
+#endif /* _GNSDK_MUSICIDFILECACHE_HPP_ */
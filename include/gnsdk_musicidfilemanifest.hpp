@@ -0,0 +1,217 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_musicidfilemanifest.hpp
+*/
+
+#ifndef _GNSDK_MUSICIDFILEMANIFEST_HPP_
+#define _GNSDK_MUSICIDFILEMANIFEST_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_musicidfile.hpp"
+
+namespace gracenote
+{
+	namespace musicid_file
+	{
+#if GNSDK_MUSICID_FILE
+
+		/**
+		 * How a file compares with its manifest entry
+		 * @ingroup Music_MusicIDFile_TypesEnums
+		 */
+		enum GnMusicIdFileManifestChange
+		{
+			/**
+			 * The manifest has no entry for the identifier
+			 */
+			kMusicIdFileManifestNew = 0,
+
+			/**
+			 * The path, size or modification time differ from the entry, or it has no result
+			 */
+			kMusicIdFileManifestChanged,
+
+			/**
+			 * The file is as recorded, its results can be reused
+			 */
+			kMusicIdFileManifestUnchanged
+		};
+
+
+		/**
+		 *  \class GnMusicIdFileManifest
+		 *  Record of the MusicID-File results of a library, so a rescan only identifies files that are
+		 *  new or have changed since the last scan.
+		 *
+		 *  Each entry holds the identifier, path, size and modification time of a file, together with
+		 *  its status, TUI, MUI and album response once recorded. A rescan:
+		 *  - checks each file of the library with AddIfChanged, which adds new and changed files to
+		 *    the query and marks unchanged ones as seen
+		 *  - runs the query on the files added
+		 *  - records their results with Record
+		 *  - saves the manifest with Save, dropping entries of files that were not seen
+		 *
+		 *  Results of unchanged files are available from Status, Tui, Mui and AlbumResponse. Album
+		 *  responses are read from the manifest file when asked for, so memory use does not grow with
+		 *  the size of the responses of the library.
+		 *
+		 *  Not thread safe, use from one thread or serialize calls.
+		 */
+		class GnMusicIdFileManifest
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 *  Loads a manifest file, a missing file gives an empty manifest
+			 *  @param manifestPath		[in] Path of the manifest file
+			 */
+			explicit
+			GnMusicIdFileManifest(gnsdk_cstr_t manifestPath) throw (GnError);
+
+			virtual
+			~GnMusicIdFileManifest();
+
+			/**
+			 * Compare a file with its entry and mark the entry as seen by this scan
+			 * @param identifier	[in] Unique identifier of the file, as given to GnMusicIdFileInfoManager::Add
+			 * @param filePath		[in] Path of the file
+			 * @return How the file compares
+			 */
+			GnMusicIdFileManifestChange
+			Check(gnsdk_cstr_t identifier, gnsdk_cstr_t filePath) throw (GnError);
+
+			/**
+			 * Check a file and add it to a query if it is new or changed, with its file name set
+			 * @param fileInfos		[in] File infos of the query
+			 * @param identifier	[in] Unique identifier of the file
+			 * @param filePath		[in] Path of the file
+			 * @param pEventHandler	[in-opt] Event delegate of the file info
+			 * @return True if the file was added
+			 */
+			bool
+			AddIfChanged(GnMusicIdFileInfoManager& fileInfos, gnsdk_cstr_t identifier, gnsdk_cstr_t filePath, IGnMusicIdFileInfoEvents* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 * Record the results of a processed file, replacing its entry
+			 * @param fileInfo		[in] File info, the path is taken from its file name
+			 */
+			void
+			Record(GnMusicIdFileInfo& fileInfo) throw (GnError);
+
+			/**
+			 * Record the results of every file of a query
+			 * @param fileInfos		[in] File infos of the query
+			 */
+			void
+			Record(GnMusicIdFileInfoManager& fileInfos) throw (GnError);
+
+			/**
+			 * Write the manifest file, replacing the previous one. Entries not checked or recorded
+			 * since the manifest was loaded are dropped, and the next scan starts.
+			 */
+			void
+			Save() throw (GnError);
+
+			/**
+			 * Number of entries
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Count() const { return count_; }
+
+			/**
+			 * Identifier of an entry, for example to find files that have not been seen
+			 * @param index			[in] Entry index, less than Count
+			 * @return Identifier, GNSDK_NULL if the index is out of range
+			 */
+			gnsdk_cstr_t
+			Identifier(gnsdk_uint32_t index) const;
+
+			/**
+			 * Whether a file has been checked or recorded by this scan
+			 * @param identifier	[in] Unique identifier of the file
+			 * @return True if seen
+			 */
+			bool
+			Seen(gnsdk_cstr_t identifier) const;
+
+			/**
+			 * Recorded status of a file
+			 * @param identifier	[in] Unique identifier of the file
+			 * @return Status, kMusicIdFileInfoStatusUnprocessed if not recorded
+			 */
+			GnMusicIdFileInfoStatus
+			Status(gnsdk_cstr_t identifier) const;
+
+			/**
+			 * Recorded TUI of a file
+			 * @param identifier	[in] Unique identifier of the file
+			 * @return TUI, empty if not recorded
+			 */
+			gnsdk_cstr_t
+			Tui(gnsdk_cstr_t identifier) const;
+
+			/**
+			 * Recorded MUI of a file
+			 * @param identifier	[in] Unique identifier of the file
+			 * @return MUI, empty if not recorded
+			 */
+			gnsdk_cstr_t
+			Mui(gnsdk_cstr_t identifier) const;
+
+			/**
+			 * Recorded album response of a file
+			 * @param identifier	[in] Unique identifier of the file
+			 * @return Response, empty if not recorded
+			 */
+			metadata::GnResponseAlbums
+			AlbumResponse(gnsdk_cstr_t identifier) throw (GnError);
+
+		private:
+			struct entry;
+
+			entry*
+			_find(gnsdk_cstr_t identifier) const;
+
+			entry*
+			_add(gnsdk_cstr_t identifier);
+
+			void
+			_load() throw (GnError);
+
+			void
+			_clear();
+
+			char*					path_;
+			void*					file_;		/* FILE*, opaque so the header needs no <stdio.h> */
+
+			entry**					entries_;
+			gnsdk_uint32_t			count_;
+			gnsdk_uint32_t			capacity_;
+			entry**					buckets_;
+			gnsdk_uint32_t			bucket_count_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdFileManifest);
+		};
+
+
+#endif /* GNSDK_MUSICID_FILE */
+	} /* namespace musicid_file */
+
+}     /* namespace gracenote */
+
+#endif /* _GNSDK_MUSICIDFILEMANIFEST_HPP_ */
@@ -0,0 +1,185 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_musicidfileprefetch.hpp
+*/
+
+#ifndef _GNSDK_MUSICIDFILEPREFETCH_HPP_
+#define _GNSDK_MUSICIDFILEPREFETCH_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_musicidfile.hpp"
+#include "gnsdk_musicidfilecache.hpp"
+#include "gnsdk_thread.hpp"
+
+namespace gracenote
+{
+	namespace musicid_file
+	{
+#if GNSDK_MUSICID_FILE
+
+		/**
+		 * Snapshot of the stages of a GnMusicIdFilePrefetch
+		 */
+		struct GnMusicIdFilePrefetchStats
+		{
+			GnMusicIdFilePrefetchStats() :
+				queued(0), decoding(0), ready(0), gathered(0), waited(0), inlined(0), failed(0), stolen(0) { }
+
+			/** Files waiting to be decoded */
+			gnsdk_uint32_t	queued;
+			/** Files being decoded and fingerprinted by prefetch workers */
+			gnsdk_uint32_t	decoding;
+			/** Files fingerprinted, waiting for GNSDK to ask for them */
+			gnsdk_uint32_t	ready;
+
+			/** Fingerprints that were ready when GNSDK asked for them */
+			gnsdk_uint32_t	gathered;
+			/** Fingerprints GNSDK waited for as they were being generated */
+			gnsdk_uint32_t	waited;
+			/** Fingerprints generated on the GNSDK thread as the file had not been started yet */
+			gnsdk_uint32_t	inlined;
+			/** Files that could not be fingerprinted */
+			gnsdk_uint32_t	failed;
+			/** Files decoded by a worker other than the one they were queued to */
+			gnsdk_uint32_t	stolen;
+		};
+
+
+		/**
+		 *  \class GnMusicIdFilePrefetch
+		 *  Decodes and fingerprints the files of a MusicID-File query ahead of GNSDK asking for them.
+		 *
+		 *  Without prefetching, GNSDK asks for each fingerprint through IGnMusicIdFileEvents::GatherFingerprint
+		 *  on its own threads and waits while the file is decoded. Attach a prefetcher with
+		 *  GnMusicIdFile::Prefetch and Add each file info with its audio source; files are decoded on a
+		 *  work-stealing pool while identification runs so a fingerprint is usually ready when GNSDK asks
+		 *  for it. A file GNSDK asks for before a worker has started it is fingerprinted on the GNSDK
+		 *  thread, a file being fingerprinted is waited for. GatherFingerprint is only called for files
+		 *  that were not added or could not be fingerprinted.
+		 *
+		 *  At most maxAhead fingerprints are generated ahead of GNSDK, workers pause until GNSDK has
+		 *  processed some of them. Stats shows the depth of each stage.
+		 */
+		class GnMusicIdFilePrefetch
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 *  Constructs a prefetcher and starts its worker threads
+			 *  @param threads		[in] Number of decode threads, 0 selects the number of processors
+			 *  @param maxAhead		[in] Maximum number of fingerprints generated ahead of GNSDK
+			 *  @param chunkMs		[in] Duration of audio decoded per fingerprint write, 0 for the default
+			 */
+			GnMusicIdFilePrefetch(gnsdk_uint32_t threads = 0, gnsdk_uint32_t maxAhead = 64, gnsdk_uint32_t chunkMs = 0) throw (GnError);
+
+			/**
+			 * Cancels files not yet started, then waits for the running ones
+			 */
+			virtual
+			~GnMusicIdFilePrefetch();
+
+			/**
+			 * Queue a file for fingerprinting, does not block. The audio source must remain valid
+			 * until GNSDK has processed the file or the prefetcher is destroyed.
+			 * @param fileInfo		[in] File info created by GnMusicIdFileInfoManager::Add
+			 * @param audioSource	[in] Audio source of the file, initialized and closed by the prefetcher
+			 */
+			void
+			Add(const GnMusicIdFileInfo& fileInfo, IGnAudioSource& audioSource) throw (GnError);
+
+			/**
+			 * Provide the fingerprint of a file, called by GnMusicIdFile when GNSDK asks for it.
+			 * @param fileInfo		[in] File info GNSDK asks for
+			 * @return true if the fingerprint has been set, false if the file was not added or failed
+			 */
+			bool
+			Gather(const GnMusicIdFileInfo& fileInfo);
+
+			/**
+			 * Forget a file, called by GnMusicIdFile once GNSDK has processed it so the file no
+			 * longer counts against maxAhead.
+			 * @param fileInfo		[in] File info processed by GNSDK
+			 */
+			void
+			Release(const GnMusicIdFileInfo& fileInfo);
+
+			/**
+			 * Stop fingerprinting files not yet started, these are then fingerprinted when GNSDK
+			 * asks for them
+			 */
+			void
+			Cancel();
+
+			/**
+			 * Set a fingerprint cache, files found in it are not decoded and fingerprints generated
+			 * are added to it. Set before adding files, the cache must outlive the prefetcher.
+			 * @param pCache	[in] Cache, GNSDK_NULL for none
+			 */
+			void
+			FingerprintCache(GnMusicIdFileFingerprintCache* pCache) { cache_ = pCache; }
+
+			/**
+			 * Current depth of each stage and totals so far
+			 * @return Stats
+			 */
+			GnMusicIdFilePrefetchStats
+			Stats() const;
+
+		private:
+			class item;
+			class decode_task;
+			friend class decode_task;
+
+			item*
+			_find(gnsdk_musicidfile_fileinfo_handle_t handle, bool bRemove);
+
+			void
+			_insert(item* p_item);
+
+			bool
+			_decode(item* p_item);
+
+			void
+			_release(item* p_item);
+
+			static gnsdk_uint32_t
+			_bucket(gnsdk_musicidfile_fileinfo_handle_t handle, gnsdk_uint32_t count);
+
+			mutable gn_mutex		mutex_;
+			gn_condition			window_cond_;
+			gn_condition			done_cond_;
+			item**					buckets_;
+			gnsdk_uint32_t			bucket_count_;
+			gnsdk_uint32_t			item_count_;
+			gnsdk_uint32_t			max_ahead_;
+			gnsdk_uint32_t			chunk_ms_;
+			GnMusicIdFileFingerprintCache*	cache_;
+			bool					cancelled_;
+			GnMusicIdFilePrefetchStats	stats_;
+
+			gn_work_stealing_pool	pool_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdFilePrefetch);
+		};
+
+
+#endif /* GNSDK_MUSICID_FILE */
+	} /* namespace musicid_file */
+
+}     /* namespace gracenote */
+
+#endif /* _GNSDK_MUSICIDFILEPREFETCH_HPP_ */
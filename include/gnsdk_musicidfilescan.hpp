@@ -0,0 +1,234 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_musicidfilescan.hpp
+*/
+
+#ifndef _GNSDK_MUSICIDFILESCAN_HPP_
+#define _GNSDK_MUSICIDFILESCAN_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_musicidfile.hpp"
+#include "gnsdk_thread.hpp"
+
+namespace gracenote
+{
+	namespace musicid_file
+	{
+#if GNSDK_MUSICID_FILE
+
+		class GnMusicIdFileManifest;
+
+		/**
+		 * Totals of a GnMusicIdFileScanner scan so far
+		 */
+		struct GnMusicIdFileScanStats
+		{
+			GnMusicIdFileScanStats() :
+				directories(0), files(0), added(0), unchanged(0), filtered(0), errors(0) { }
+
+			/** Directories read */
+			gnsdk_uint32_t	directories;
+			/** Files found with a matching extension */
+			gnsdk_uint32_t	files;
+			/** Files added to the query */
+			gnsdk_uint32_t	added;
+			/** Files not added as the manifest shows them unchanged */
+			gnsdk_uint32_t	unchanged;
+			/** Entries skipped by the extension filter, the symbolic link setting or their type */
+			gnsdk_uint32_t	filtered;
+			/** Directories that could not be read and files that could not be added */
+			gnsdk_uint32_t	errors;
+		};
+
+
+		/**
+		 *  Delegate interface for receiving the progress of a GnMusicIdFileScanner scan
+		 */
+		class IGnMusicIdFileScanEvents
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			virtual
+			~IGnMusicIdFileScanEvents() { };
+
+			/**
+			 * Called on the scanning thread after each batch of files has been added, and once when the scan ends
+			 * @param stats			[in] Totals so far
+			 * @param canceller		[in] Object that can be used to stop the scan
+			 */
+			virtual void
+			ScanProgress(const GnMusicIdFileScanStats& stats, IGnCancellable& canceller) = 0;
+		};
+
+
+		/**
+		 *  \class GnMusicIdFileScanner
+		 *  Walks directory trees on several threads and adds the audio files found to a MusicID-File query.
+		 *
+		 *  Directories are read in parallel on a work-stealing pool, using bulk directory reads where the
+		 *  platform has them, and files found are passed back in batches. A batch collects the files of
+		 *  several directories and is passed back before it is full once no directories are waiting.
+		 *  Files are added on the thread calling Scan, with the file path as both the identifier and the
+		 *  file name, so the query and an optional manifest are only used from that thread. Files are
+		 *  added in no particular order.
+		 *
+		 *  Enumeration on network storage is latency bound, more threads than processors usually help.
+		 *  Set the extensions and options before scanning; one scan at a time per scanner.
+		 */
+		class GnMusicIdFileScanner
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 *  Constructs a scanner and starts its worker threads
+			 *  @param threads		[in] Number of directory reading threads, 0 selects the number of processors
+			 *  @param batchSize	[in] Number of files passed back to the scanning thread at a time, at most
+			 */
+			GnMusicIdFileScanner(gnsdk_uint32_t threads = 0, gnsdk_uint32_t batchSize = 256) throw (GnError);
+
+			virtual
+			~GnMusicIdFileScanner();
+
+			/**
+			 * Only add files with an extension, compared without case. Without extensions every file is added.
+			 * @param extension		[in] Extension with or without the leading dot, such as "mp3"
+			 */
+			void
+			AddExtension(gnsdk_cstr_t extension) throw (GnError);
+
+			/**
+			 * Follow symbolic links to files and directories, off by default. Directories reached more than
+			 * once are only read once.
+			 * @param bFollow		[in] True to follow links, false to skip them
+			 */
+			void
+			FollowSymlinks(bool bFollow) { follow_symlinks_ = bFollow; }
+
+			/**
+			 * Only add files the manifest shows as new or changed, see GnMusicIdFileManifest::AddIfChanged.
+			 * The manifest must outlive the scans.
+			 * @param pManifest		[in] Manifest, GNSDK_NULL for none
+			 */
+			void
+			Manifest(GnMusicIdFileManifest* pManifest) { manifest_ = pManifest; }
+
+			/**
+			 * Set a delegate receiving scan progress
+			 * @param pEventHandler	[in] Delegate, GNSDK_NULL for none
+			 */
+			void
+			EventHandler(IGnMusicIdFileScanEvents* pEventHandler) { events_ = pEventHandler; }
+
+			/**
+			 * Walk a directory tree and add the files found, returns when the walk is complete or cancelled
+			 * @param rootPath		[in] Directory to walk
+			 * @param fileInfos		[in] File infos of the query to add files to
+			 * @param pEventHandler	[in-opt] Event delegate of each file info added
+			 * @return Number of files added
+			 */
+			gnsdk_uint32_t
+			Scan(gnsdk_cstr_t rootPath, GnMusicIdFileInfoManager& fileInfos, IGnMusicIdFileInfoEvents* pEventHandler = GNSDK_NULL) throw (GnError);
+
+			/**
+			 * Stop the current scan, may be called from any thread. Files already added stay added.
+			 */
+			void
+			Cancel();
+
+			/**
+			 * Totals of the current or last scan
+			 * @return Stats
+			 */
+			GnMusicIdFileScanStats
+			Stats() const;
+
+		private:
+			struct batch;
+			struct visited_dir;
+			class directory_task;
+			friend class directory_task;
+
+			void
+			_read_directory(gnsdk_cstr_t path, gnsdk_uint32_t depth);
+
+			void
+			_post(gnsdk_cstr_t path, gnsdk_uint32_t depth);
+
+			bool
+			_visit(gnsdk_uint64_t device, gnsdk_uint64_t inode);
+
+			bool
+			_matches(gnsdk_cstr_t name) const;
+
+			batch*
+			_take_batch(gnsdk_size_t length);
+
+			void
+			_park(batch* p_batch);
+
+			void
+			_flush_parked();
+
+			void
+			_hand_off(batch* p_batch);
+
+			void
+			_finish();
+
+			void
+			_clear_visited();
+
+			mutable gn_mutex		mutex_;
+			gn_condition			ready_cond_;
+			gn_condition			space_cond_;
+
+			/* batches waiting for the scanning thread */
+			batch*					ready_head_;
+			batch*					ready_tail_;
+			gnsdk_uint32_t			ready_count_;
+			gnsdk_uint32_t			ready_max_;
+			gnsdk_uint32_t			pending_;		/* directories posted and not yet read */
+			batch*					parked_;		/* partly filled batches waiting for more files */
+			gnsdk_size_t			batch_bytes_;	/* largest full batch so far, sizes new ones */
+
+			visited_dir**			visited_;
+			gnsdk_uint32_t			visited_bucket_count_;
+			gnsdk_uint32_t			visited_count_;
+
+			char**					extensions_;
+			gnsdk_uint32_t			extension_count_;
+			gnsdk_uint32_t			batch_size_;
+			bool					follow_symlinks_;
+			GnMusicIdFileManifest*	manifest_;
+			IGnMusicIdFileScanEvents*	events_;
+
+			gn_atomic_uint32		cancelled_;
+			GnMusicIdFileScanStats	stats_;
+
+			gn_work_stealing_pool	pool_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdFileScanner);
+		};
+
+
+#endif /* GNSDK_MUSICID_FILE */
+	} /* namespace musicid_file */
+
+}     /* namespace gracenote */
+
+#endif /* _GNSDK_MUSICIDFILESCAN_HPP_ */
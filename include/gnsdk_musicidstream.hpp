@@ -16,8 +16,10 @@
 #endif
 
 #include "gnsdk_base.hpp"
+#include "gnsdk_queryprofile.hpp"
 #include "metadata_music.hpp"
 #include "gn_audiosource.hpp"
+#include "gnsdk_thread.hpp"
 
 namespace gracenote
 {
@@ -266,14 +268,32 @@ namespace gracenote
 			void
 			Custom(gnsdk_cstr_t optionKey, gnsdk_cstr_t value) throw (GnError);
 
+			/**
+			 *  Set all options of a query profile, options the MusicID-Stream query does not support are ignored
+			 *  @param profile [in] Options prepared once with GnQueryProfile
+			 */
+			void
+			Profile(const GnQueryProfile& profile) throw (GnError);
+
+			/**
+			 *  Sets the duration of audio passed to GNSDK per write when audio is pulled from an audio
+			 *  source by AudioProcessStart. The chunk size in bytes is derived
+			 *  from the format of the audio source. Shorter chunks lower latency, longer chunks mean
+			 *  fewer calls into GNSDK.
+			 *  @param durationMs [in] Chunk duration in milliseconds, 0 restores the default of 100
+			 */
+			void
+			AudioChunkDuration(gnsdk_uint32_t durationMs) { chunk_duration_ms_ = durationMs; }
+
 
 		protected:
-			GnMusicIdStreamOptions() : weakhandle_(GNSDK_NULL) { }
+			GnMusicIdStreamOptions() : weakhandle_(GNSDK_NULL), chunk_duration_ms_(0) { }
 
 		private:
 			DISALLOW_COPY_AND_ASSIGN(GnMusicIdStreamOptions);
 			friend class GnMusicIdStream;
 			gnsdk_musicidstream_channel_handle_t weakhandle_;
+			gnsdk_uint32_t                       chunk_duration_ms_;
 
 		};
 
@@ -606,6 +626,139 @@ namespace gracenote
 			MusicIdStreamIdentifyCompletedWithError(GnError& completeError) = 0;
 		};
 
+
+		/**
+		 * Drives audio processing for many GnMusicIdStream channels from a fixed pool of worker threads,
+		 * instead of dedicating a thread to each channel's AudioProcessStart loop.
+		 * <p><b>Remarks:</b></p>
+		 * Workers take turns servicing channels. Each turn pulls at most one buffer of audio from the
+		 * channel's audio source and writes it to the channel, so all channels make progress regardless
+		 * of the number of workers. Audio sources implementing IGnAudioSource::DataReady are only serviced
+		 * when they have audio ready; other sources may block a worker inside GetData, so the number of
+		 * workers should then be at least the number of such sources.
+		 * Album results and identification errors are delivered to each channel's event delegate on a
+		 * separate, bounded pool of callback threads, so a slow delegate does not stall audio processing.
+		 * The canceller provided with pooled album results cannot cancel the identification that produced
+		 * them; use GnMusicIdStream::IdentifyCancel instead. Status events are delivered directly, as for
+		 * a standalone GnMusicIdStream.
+		 */
+		class GnMusicIdStreamPool
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 * Establishes a channel pool and starts its threads
+			 * @param workerThreads			[in] Number of audio processing threads, 0 selects the number of processors
+			 * @param callbackThreads		[in] Number of threads delivering results to event delegates
+			 * @param callbackQueueSize		[in] Maximum number of results waiting for delivery. Identification
+			 *								blocks while this many results are pending
+			 */
+			GnMusicIdStreamPool(gnsdk_uint32_t workerThreads, gnsdk_uint32_t callbackThreads = 1, gnsdk_uint32_t callbackQueueSize = 64) throw (GnError);
+
+			/**
+			 * Stops all channels, closing their audio sources, and waits for pending results to be delivered
+			 */
+			virtual
+			~GnMusicIdStreamPool();
+
+			/**
+			 *  Establishes a channel with locale and starts retrieving audio from the audio source.
+			 *  The channel is owned by the pool and remains valid until removed or the pool is destroyed.
+			 *  @param user 			[in] Gracenote user
+			 *  @param preset 			[in] Gracenote musicID stream preset
+			 *  @param locale 			[in] Gracenote locale
+			 *  @param audioSource		[in] Audio source to be identified
+			 *  @param pEventDelegate 	[in] Audio processing and identification query events handler
+			 *  @return Channel, use to set options and request identification
+			 */
+			GnMusicIdStream&
+			AddChannel(const GnUser& user, GnMusicIdStreamPreset preset, const GnLocale& locale, IGnAudioSource& audioSource, IGnMusicIdStreamEvents* pEventDelegate) throw (GnError);
+
+			/**
+			 *  Establishes a channel and starts retrieving audio from the audio source.
+			 *  The channel is owned by the pool and remains valid until removed or the pool is destroyed.
+			 *  @param user 			[in] Gracenote user
+			 *  @param preset 			[in] Gracenote musicID stream preset
+			 *  @param audioSource		[in] Audio source to be identified
+			 *  @param pEventDelegate 	[in] Audio processing and identification query events handler
+			 *  @return Channel, use to set options and request identification
+			 */
+			GnMusicIdStream&
+			AddChannel(const GnUser& user, GnMusicIdStreamPreset preset, IGnAudioSource& audioSource, IGnMusicIdStreamEvents* pEventDelegate) throw (GnError);
+
+			/**
+			 * Stops audio processing for a channel, closes its audio source and destroys it. Waits if a
+			 * worker is currently servicing the channel, and for results of the channel queued for its
+			 * delegate, so the delegate can be freed on return. Cannot be called from within a delegate
+			 * callback of the channel being removed.
+			 * @param channel	[in] Channel returned by AddChannel
+			 */
+			void
+			RemoveChannel(GnMusicIdStream& channel) throw (GnError);
+
+			/**
+			 * Number of channels in the pool, including those whose audio source has ended
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			ChannelCount() const;
+
+			/**
+			 * Number of results waiting to be delivered to event delegates
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			PendingCallbacks() const { return callbacks_.queued(); }
+
+			/**
+			 * Sets the duration of audio a worker passes to GNSDK per write, see
+			 * GnMusicIdStreamOptions::AudioChunkDuration. Applies to channels added afterwards.
+			 * @param durationMs	[in] Chunk duration in milliseconds, 0 restores the default of 100
+			 */
+			void
+			AudioChunkDuration(gnsdk_uint32_t durationMs) { chunk_duration_ms_.store(durationMs); }
+
+		private:
+			class channel;
+			class worker;
+			friend class channel;
+			friend class worker;
+
+			GnMusicIdStream&
+			_add_channel(channel* p_channel) throw (GnError);
+
+			channel*
+			_next_channel();
+
+			bool
+			_service_channel(channel* p_channel);
+
+			void
+			_release_channel(channel* p_channel, bool bProgressed);
+
+			void
+			_worker_run();
+
+			mutable gn_mutex	mutex_;
+			gn_condition		ready_cond_;
+			gn_condition		idle_cond_;
+			channel*			channels_;
+			channel*			ready_head_;
+			channel*			ready_tail_;
+			gnsdk_uint32_t		channel_count_;
+			gnsdk_uint32_t		ready_count_;
+			gnsdk_uint32_t		idle_passes_;
+			bool				stop_;
+			gn_thread*			threads_;
+			worker*				workers_;
+			gnsdk_uint32_t		thread_count_;
+			gn_thread_pool		callbacks_;
+			gn_atomic_uint32	chunk_duration_ms_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnMusicIdStreamPool);
+		};
+
 #endif /* GNSDK_MUSICID_STREAM */
 
 	} // namespace musicid_stream
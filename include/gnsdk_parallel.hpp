@@ -0,0 +1,189 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_parallel.hpp: Parallel iteration over wrapper collections */
+
+#ifndef _GNSDK_PARALLEL_HPP_
+#define _GNSDK_PARALLEL_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_thread.hpp"
+
+
+namespace gracenote
+{
+	/**
+	 * GNSDK internal class. Failure state shared by the ranges of one ParallelForEach call,
+	 * the first error is kept and stops the remaining ranges.
+	 */
+	class gn_parallel_state
+	{
+	public:
+		gn_parallel_state() : error_(GNSDK_NULL) { }
+		~gn_parallel_state() { delete error_; }
+
+		bool
+		failed() const { return 0 != failed_.load(); }
+
+		void
+		fail(const GnError& error)
+		{
+			gn_lock lock(mutex_);
+
+			if (GNSDK_NULL == error_)
+			{
+				error_ = new GnError(error);
+			}
+			failed_.store(1);
+		}
+
+		void
+		rethrow() const throw (GnError)
+		{
+			if (error_)
+			{
+				throw GnError(*error_);
+			}
+		}
+
+	private:
+		gn_mutex			mutex_;
+		gn_atomic_uint32	failed_;
+		GnError*			error_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_parallel_state);
+	};
+
+
+	/**
+	 * GNSDK internal class. Contiguous range of items of one ParallelForEach call, iterated
+	 * with an iterator of its own.
+	 */
+	template<typename _Iterable, typename _Fn>
+	class gn_parallel_range : public gn_task
+	{
+	public:
+		gn_parallel_range() : iterable_(GNSDK_NULL), fn_(GNSDK_NULL), state_(GNSDK_NULL), first_(0), count_(0) { }
+
+		void
+		assign(const _Iterable* iterable, _Fn* fn, gn_parallel_state* state, gnsdk_uint32_t first, gnsdk_uint32_t count)
+		{
+			iterable_ = iterable;
+			fn_       = fn;
+			state_    = state;
+			first_    = first;
+			count_    = count;
+		}
+
+		virtual void
+		run()
+		{
+			try
+			{
+				typename _Iterable::iterator it = iterable_->at(first_);
+
+				for (gnsdk_uint32_t i = 0; (i < count_) && !state_->failed(); i++, ++it)
+				{
+					(*fn_)(*it);
+				}
+			}
+			catch (GnError& e)
+			{
+				state_->fail(e);
+			}
+			catch (...)
+			{
+				state_->fail(GnError(GNSDKERR_Aborted, "ParallelForEach function threw an exception"));
+			}
+		}
+
+	private:
+		const _Iterable*	iterable_;
+		_Fn*				fn_;
+		gn_parallel_state*	state_;
+		gnsdk_uint32_t		first_;
+		gnsdk_uint32_t		count_;
+	};
+
+
+	/**
+	 * Call a function for every item of an iterable collection, such as the tracks of an album,
+	 * using several threads. The items are split into one contiguous range of ordinals per thread,
+	 * each thread iterates its range with its own iterator. The calling thread processes the first
+	 * range. Returns once all items have been processed.
+	 * The function is shared by all threads and must be safe to call concurrently. If it throws,
+	 * no further items are started and the first error is rethrown as GnError.
+	 * @param iterable		[in] Collection to iterate, e.g. GnAlbum::Tracks()
+	 * @param fn			[in] Function or function object called with each item
+	 * @param threadCount	[in] Number of threads, 0 selects the number of processors
+	 */
+	template<typename _Iterable, typename _Fn>
+	void
+	ParallelForEach(const _Iterable& iterable, _Fn fn, gnsdk_uint32_t threadCount = 0) throw (GnError)
+	{
+		gn_parallel_state						state;
+		gn_parallel_range<_Iterable, _Fn>*		ranges;
+		gn_thread*								threads;
+		gnsdk_uint32_t							count = iterable.count();
+		gnsdk_uint32_t							first = 0;
+		gnsdk_uint32_t							i;
+
+		if (0 == count)
+		{
+			return;
+		}
+
+		if (0 == threadCount)
+		{
+			threadCount = gn_thread::hardware_concurrency();
+		}
+		if (threadCount > count)
+		{
+			threadCount = count;
+		}
+
+		ranges  = new gn_parallel_range<_Iterable, _Fn>[threadCount];
+		threads = new gn_thread[threadCount];
+
+		for (i = 0; i < threadCount; i++)
+		{
+			gnsdk_uint32_t range_count = (count / threadCount) + ((i < count % threadCount) ? 1 : 0);
+
+			ranges[i].assign(&iterable, &fn, &state, first, range_count);
+			first += range_count;
+		}
+
+		/* a range whose thread cannot be started runs on the calling thread */
+		for (i = 1; i < threadCount; i++)
+		{
+			if (!threads[i].start(&ranges[i]))
+			{
+				ranges[i].run();
+			}
+		}
+		ranges[0].run();
+
+		for (i = 1; i < threadCount; i++)
+		{
+			threads[i].join();
+		}
+
+		delete [] threads;
+		delete [] ranges;
+
+		state.rethrow();
+	}
+
+}     // namespace gracenote
+
+#endif // _GNSDK_PARALLEL_HPP_
@@ -947,6 +947,7 @@ namespace gracenote
 			GnPlaylistStorage();
 			virtual
 			~GnPlaylistStorage() { }
+			GNSDK_MOVABLE(GnPlaylistStorage)
 
 
 			/**
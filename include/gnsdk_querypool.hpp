@@ -0,0 +1,545 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_querypool.hpp: Reuse of query objects across requests */
+
+#ifndef _GNSDK_QUERYPOOL_HPP_
+#define _GNSDK_QUERYPOOL_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_locale.hpp"
+#include "gnsdk_thread.hpp"
+#include "gnsdk_queryprofile.hpp"
+
+#if GNSDK_MUSICID
+	#include "gnsdk_musicid.hpp"
+#endif
+
+#if GNSDK_VIDEO
+	#include "gnsdk_video.hpp"
+#endif
+
+#if GNSDK_LINK
+	#include "gnsdk_link.hpp"
+#endif
+
+
+namespace gracenote
+{
+	/**
+	 * GNSDK internal struct. Creates and resets the query objects of a GnQueryPool, specialized for
+	 * each query class that can be pooled.
+	 */
+	template<typename _Query>
+	struct gn_query_pool_traits;
+
+#if GNSDK_MUSICID
+	template<>
+	struct gn_query_pool_traits<musicid::GnMusicId>
+	{
+		static musicid::GnMusicId*
+		create(const GnUser& user, const GnLocale* locale)
+		{
+			return locale ? new musicid::GnMusicId(user, *locale) : new musicid::GnMusicId(user);
+		}
+
+		static void
+		reset(musicid::GnMusicId& query, const GnQueryProfile& profile)
+		{
+			query.SetCancel(false);
+			query.Options().Profile(profile);
+		}
+	};
+#endif
+
+#if GNSDK_VIDEO
+	template<>
+	struct gn_query_pool_traits<video::GnVideo>
+	{
+		static video::GnVideo*
+		create(const GnUser& user, const GnLocale* locale)
+		{
+			return locale ? new video::GnVideo(user, *locale) : new video::GnVideo(user);
+		}
+
+		static void
+		reset(video::GnVideo& query, const GnQueryProfile& profile)
+		{
+			query.SetCancel(false);
+			query.Options().Profile(profile);
+		}
+	};
+#endif
+
+#if GNSDK_LINK
+	template<>
+	struct gn_query_pool_traits<link::GnLink>
+	{
+		/* Link queries take no locale */
+		static link::GnLink*
+		create(const GnUser& user, const GnLocale* /*locale*/)
+		{
+			return new link::GnLink(user);
+		}
+
+		static void
+		reset(link::GnLink& query, const GnQueryProfile& profile)
+		{
+			query.SetCancel(false);
+			query.Options().Clear();
+			query.Options().Profile(profile);
+		}
+	};
+#endif
+
+
+	/**
+	 * Counters of a GnQueryPool
+	 */
+	struct GnQueryPoolStats
+	{
+		gnsdk_uint64_t	hits;			/**< Leases served by an idle query */
+		gnsdk_uint64_t	misses;			/**< Leases that created a query */
+		gnsdk_uint64_t	evictions;		/**< Idle queries deleted, by age, by count or by Clear() */
+		gnsdk_uint32_t	idle;			/**< Queries currently idle in the pool */
+		gnsdk_uint32_t	leased;			/**< Queries currently leased */
+	};
+
+
+	/**
+	 * \class GnQueryPool
+	 * Keeps query objects - GnMusicId, GnVideo or GnLink - between uses so requests with the same
+	 * user, locale and query profile do not each create a query, set its locale and options, and
+	 * register its callbacks. Queries are leased with GnQueryLease and return to the pool when the
+	 * lease ends.
+	 * A query returned to the pool has its cancel flag cleared and the options of its profile
+	 * set again; GnLink queries also have all options cleared first. Other options set during a
+	 * lease stay set on GnMusicId and GnVideo queries, set those through the profile instead.
+	 * Pooled queries have no status event handler.
+	 * Queries idle longer than the idle timeout, or beyond the idle limit of their key, are
+	 * deleted. The pool is thread safe. Leases must end before the pool is destroyed.
+	 */
+	template<typename _Query>
+	class GnQueryPool
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * GNSDK internal struct. Pooled query.
+		 */
+		struct entry;
+
+		/**
+		 * Construct an empty pool
+		 * @param idleTimeoutMs	[in] Idle queries older than this are deleted, 0 keeps them until Clear()
+		 * @param maxIdle		[in] Idle queries kept per user, locale and profile
+		 */
+		explicit
+		GnQueryPool(gnsdk_uint32_t idleTimeoutMs = 60000, gnsdk_uint32_t maxIdle = 8) :
+			buckets_(GNSDK_NULL), idle_timeout_ms_(idleTimeoutMs), max_idle_(maxIdle),
+			hits_(0), misses_(0), evictions_(0), idle_(0), leased_(0)
+		{
+		}
+
+		~GnQueryPool()
+		{
+			Clear();
+
+			while (buckets_)
+			{
+				bucket* next = buckets_->next;
+
+				delete buckets_;
+				buckets_ = next;
+			}
+		}
+
+		/**
+		 * Delete the queries idle longer than the idle timeout. Also done when leases end.
+		 */
+		void
+		EvictIdle()
+		{
+			entry* evicted = GNSDK_NULL;
+
+			if (idle_timeout_ms_)
+			{
+				gn_lock lock(mutex_);
+
+				evicted = _expire(gn_thread::tick_ms());
+			}
+			_delete(evicted);
+		}
+
+		/**
+		 * Delete all idle queries
+		 */
+		void
+		Clear()
+		{
+			entry* evicted = GNSDK_NULL;
+
+			{
+				gn_lock lock(mutex_);
+
+				for (bucket* b = buckets_; b; b = b->next)
+				{
+					while (b->idle)
+					{
+						evicted = _unlink_oldest(b, evicted);
+					}
+				}
+				_prune();
+			}
+			_delete(evicted);
+		}
+
+		/**
+		 * Current counters
+		 * @return Counters
+		 */
+		GnQueryPoolStats
+		Stats() const
+		{
+			GnQueryPoolStats	stats;
+			gn_lock				lock(mutex_);
+
+			stats.hits      = hits_;
+			stats.misses    = misses_;
+			stats.evictions = evictions_;
+			stats.idle      = idle_;
+			stats.leased    = leased_;
+			return stats;
+		}
+
+		/**
+		 * For internal use, see GnQueryLease. Take an idle query with the given key or create one.
+		 */
+		entry*
+		acquire(const GnUser& user, const GnLocale* locale, const GnQueryProfile& profile) throw (GnError)
+		{
+			bucket*	b;
+			entry*	e;
+
+			{
+				gn_lock lock(mutex_);
+
+				b = _find(user, locale, profile);
+				leased_   += 1;
+				b->leased += 1;
+
+				e = b->idle;
+				if (e)
+				{
+					b->idle        = e->next;
+					b->idle_count -= 1;
+					idle_         -= 1;
+					hits_         += 1;
+					e->next        = GNSDK_NULL;
+					return e;
+				}
+				misses_ += 1;
+			}
+
+			/* queries are created without holding the pool lock */
+			e = new entry(b);
+			try
+			{
+				e->query = gn_query_pool_traits<_Query>::create(b->user, b->localized ? &b->locale : GNSDK_NULL);
+				e->query->Options().Profile(b->profile);
+			}
+			catch (...)
+			{
+				delete e;
+
+				gn_lock lock(mutex_);
+
+				leased_   -= 1;
+				b->leased -= 1;
+				throw;
+			}
+			return e;
+		}
+
+		/**
+		 * For internal use, see GnQueryLease. Return a query to the pool, or delete it.
+		 */
+		void
+		release(entry* e, bool bDiscard)
+		{
+			entry*			evicted = GNSDK_NULL;
+			bucket*			b       = e->owner;
+			gnsdk_uint64_t	now     = gn_thread::tick_ms();
+
+			if (!bDiscard)
+			{
+				try
+				{
+					gn_query_pool_traits<_Query>::reset(*e->query, b->profile);
+				}
+				catch (...)
+				{
+					/* called from the lease destructor, nothing may escape */
+					bDiscard = true;
+				}
+			}
+
+			{
+				gn_lock lock(mutex_);
+
+				leased_   -= 1;
+				b->leased -= 1;
+
+				if (bDiscard || (0 == max_idle_))
+				{
+					e->next = evicted;
+					evicted = e;
+				}
+				else
+				{
+					e->idle_since  = now;
+					e->next        = b->idle;
+					b->idle        = e;
+					b->idle_count += 1;
+					idle_         += 1;
+
+					if (b->idle_count > max_idle_)
+					{
+						evicted = _unlink_oldest(b, evicted);
+					}
+				}
+
+				if (idle_timeout_ms_)
+				{
+					evicted = _expire(now, evicted);
+				}
+			}
+			_delete(evicted);
+		}
+
+	private:
+		/* idle and leased queries of one user, locale and profile */
+		struct bucket
+		{
+			bucket(const GnUser& u, const GnLocale* l, const GnQueryProfile& p) :
+				user(u), locale(l ? *l : GnLocale()), localized(GNSDK_NULL != l), profile(p),
+				idle(GNSDK_NULL), idle_count(0), leased(0), next(GNSDK_NULL)
+			{
+			}
+
+			GnUser				user;
+			GnLocale			locale;
+			bool				localized;
+			GnQueryProfile		profile;
+			entry*				idle;			/* most recently returned first */
+			gnsdk_uint32_t		idle_count;
+			gnsdk_uint32_t		leased;
+			bucket*				next;
+		};
+
+		bucket*
+		_find(const GnUser& user, const GnLocale* locale, const GnQueryProfile& profile)
+		{
+			bucket* b;
+
+			for (b = buckets_; b; b = b->next)
+			{
+				if ((b->user == user) && (b->localized == (GNSDK_NULL != locale)) && (!locale || (b->locale == *locale)) && (b->profile == profile))
+				{
+					return b;
+				}
+			}
+
+			b = new bucket(user, locale, profile);
+			b->next  = buckets_;
+			buckets_ = b;
+			return b;
+		}
+
+		/* move the least recently returned idle query of a bucket to the evicted list */
+		entry*
+		_unlink_oldest(bucket* b, entry* evicted)
+		{
+			entry** p = &b->idle;
+
+			while ((*p)->next)
+			{
+				p = &(*p)->next;
+			}
+
+			entry* e = *p;
+
+			*p             = GNSDK_NULL;
+			b->idle_count -= 1;
+			idle_         -= 1;
+			evictions_    += 1;
+			e->next        = evicted;
+			return e;
+		}
+
+		/* idle lists are ordered by age, expired queries are at their tails */
+		entry*
+		_expire(gnsdk_uint64_t now, entry* evicted = GNSDK_NULL)
+		{
+			for (bucket* b = buckets_; b; b = b->next)
+			{
+				while (b->idle)
+				{
+					entry* oldest = b->idle;
+
+					while (oldest->next)
+					{
+						oldest = oldest->next;
+					}
+					if (now - oldest->idle_since < idle_timeout_ms_)
+					{
+						break;
+					}
+					evicted = _unlink_oldest(b, evicted);
+				}
+			}
+			_prune();
+			return evicted;
+		}
+
+		/* free the buckets that hold no queries */
+		void
+		_prune()
+		{
+			bucket** p = &buckets_;
+
+			while (*p)
+			{
+				bucket* b = *p;
+
+				if ((GNSDK_NULL == b->idle) && (0 == b->leased))
+				{
+					*p = b->next;
+					delete b;
+				}
+				else
+				{
+					p = &b->next;
+				}
+			}
+		}
+
+		/* queries are deleted without holding the pool lock */
+		static void
+		_delete(entry* evicted)
+		{
+			while (evicted)
+			{
+				entry* next = evicted->next;
+
+				delete evicted;
+				evicted = next;
+			}
+		}
+
+		mutable gn_mutex	mutex_;
+		bucket*				buckets_;
+		gnsdk_uint32_t		idle_timeout_ms_;
+		gnsdk_uint32_t		max_idle_;
+		gnsdk_uint64_t		hits_;
+		gnsdk_uint64_t		misses_;
+		gnsdk_uint64_t		evictions_;
+		gnsdk_uint32_t		idle_;
+		gnsdk_uint32_t		leased_;
+
+		DISALLOW_COPY_AND_ASSIGN(GnQueryPool);
+	};
+
+
+	template<typename _Query>
+	struct GnQueryPool<_Query>::entry
+	{
+		explicit entry(bucket* b) : query(GNSDK_NULL), owner(b), next(GNSDK_NULL), idle_since(0) { }
+		~entry() { delete query; }
+
+		_Query*				query;
+		bucket*				owner;
+		entry*				next;
+		gnsdk_uint64_t		idle_since;
+	};
+
+
+	/**
+	 * \class GnQueryLease
+	 * Query leased from a GnQueryPool for the lifetime of the lease. The query is returned to the
+	 * pool when the lease is destroyed.
+	 * <code>
+	 * GnQueryLease<GnMusicId> musicid(pool, user, locale, profile);
+	 * GnResponseAlbums response = musicid->FindAlbums(toc);
+	 * </code>
+	 */
+	template<typename _Query>
+	class GnQueryLease
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * Lease a query without locale
+		 * @param pool		[in] Pool to lease from
+		 * @param user		[in] User of the query
+		 * @param profile	[in] Options of the query
+		 */
+		GnQueryLease(GnQueryPool<_Query>& pool, const GnUser& user, const GnQueryProfile& profile = GnQueryProfile()) throw (GnError) :
+			pool_(pool), entry_(pool.acquire(user, GNSDK_NULL, profile)), discard_(false)
+		{
+		}
+
+		/**
+		 * Lease a query with a locale
+		 * @param pool		[in] Pool to lease from
+		 * @param user		[in] User of the query
+		 * @param locale	[in] Locale of the query, ignored by GnLink
+		 * @param profile	[in] Options of the query
+		 */
+		GnQueryLease(GnQueryPool<_Query>& pool, const GnUser& user, const GnLocale& locale, const GnQueryProfile& profile = GnQueryProfile()) throw (GnError) :
+			pool_(pool), entry_(pool.acquire(user, &locale, profile)), discard_(false)
+		{
+		}
+
+		~GnQueryLease() { pool_.release(entry_, discard_); }
+
+		/**
+		 * Delete the query when the lease ends instead of returning it to the pool, e.g. after
+		 * setting options that are not part of its profile
+		 */
+		void
+		Discard() { discard_ = true; }
+
+		_Query&
+		Query() const { return *entry_->query; }
+
+		_Query&
+		operator* () const { return *entry_->query; }
+
+		_Query*
+		operator-> () const { return entry_->query; }
+
+	private:
+		GnQueryPool<_Query>&					pool_;
+		typename GnQueryPool<_Query>::entry*	entry_;
+		bool									discard_;
+
+		DISALLOW_COPY_AND_ASSIGN(GnQueryLease);
+	};
+
+}     // namespace gracenote
+
+#endif // _GNSDK_QUERYPOOL_HPP_
@@ -0,0 +1,237 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_queryprofile.hpp: Query option sets built once and applied to many queries */
+
+#ifndef _GNSDK_QUERYPROFILE_HPP_
+#define _GNSDK_QUERYPROFILE_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+
+
+namespace gracenote
+{
+	/**
+	 * \class GnQueryProfile
+	 * A set of query options captured once and applied to a query in one call, e.g. with
+	 * GnMusicIdOptions::Profile. Option values are converted to their native form when they are
+	 * set, so applying a profile only hands prepared strings to GNSDK.
+	 * The same profile can be applied to MusicID, MusicID-Stream, MusicID-File, Video and Link
+	 * queries, each takes the options it supports and ignores the others. Custom options are
+	 * applied as given.
+	 * Applying does not change a profile, so a profile that is no longer being set can be
+	 * applied by many threads at once.
+	 */
+	class GnQueryProfile
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		/**
+		 * For internal use. Options held by a profile, each module maps them to its own option keys.
+		 */
+		enum gn_option
+		{
+			kOptionLookupMode = 0,
+			kOptionContentData,
+			kOptionClassicalData,
+			kOptionSonicData,
+			kOptionPlaylist,
+			kOptionExternalIds,
+			kOptionGlobalIds,
+			kOptionAdditionalCredits,
+			kOptionPreferredLanguage,
+			kOptionPreferredExternalId,
+			kOptionPreferCoverart,
+			kOptionResultSingle,
+			kOptionRevisionCheck,
+			kOptionResultRangeStart,
+			kOptionResultRangeSize,
+			kOptionNetworkInterface,
+
+			kOptionCount
+		};
+
+		/**
+		 * Construct an empty profile
+		 */
+		GnQueryProfile();
+
+		GnQueryProfile(const GnQueryProfile& other);
+
+		GnQueryProfile&
+		operator= (const GnQueryProfile& other);
+
+		~GnQueryProfile();
+
+		/**
+		 *  Lookup mode, local embedded databases or online
+		 *  @param lookupMode  [in] One of the #GnLookupMode values
+		 */
+		void
+		LookupMode(GnLookupMode lookupMode);
+
+		/**
+		 *  Enable or disable a kind of lookup data
+		 *  @param lookupData [in] One of the #GnLookupData values
+		 *  @param bEnable    [in] Set lookup data
+		 */
+		void
+		LookupData(GnLookupData lookupData, bool bEnable);
+
+		/**
+		 *  Preferred language of the returned results
+		 *  @param preferredLanguage [in] One of the GNSDK language values
+		 */
+		void
+		PreferResultLanguage(GnLanguage preferredLanguage);
+
+		/**
+		 *  Preferred external ID of the returned results
+		 *  @param strExternalId [in] Gracenote external ID source name
+		 */
+		void
+		PreferResultExternalId(gnsdk_cstr_t strExternalId);
+
+		/**
+		 *  Use cover art to prefer the returned results
+		 *  @param bEnable [in] Set prefer cover art
+		 */
+		void
+		PreferResultCoverart(bool bEnable);
+
+		/**
+		 *  Return a single result
+		 *  @param bEnable [in] Set single result
+		 */
+		void
+		ResultSingle(bool bEnable);
+
+		/**
+		 *  Check for revised data in the local cache
+		 *  @param bEnable [in] Set revision check
+		 */
+		void
+		RevisionCheck(bool bEnable);
+
+		/**
+		 *  First result of the returned range
+		 *  @param resultStart  [in] Result range start value
+		 */
+		void
+		ResultRangeStart(gnsdk_uint32_t resultStart);
+
+		/**
+		 *  Number of results of the returned range
+		 *  @param resultCount  [in] Result range size
+		 */
+		void
+		ResultCount(gnsdk_uint32_t resultCount);
+
+		/**
+		 *  Local IP address of the network interface used for connections
+		 *  @param ipAddress [in] IP address
+		 */
+		void
+		NetworkInterface(gnsdk_cstr_t ipAddress);
+
+		/**
+		 *  Set option using option name, applied to any query the profile is applied to
+		 *  @param option   [in] Option name
+		 *  @param value	[in] Option value
+		 */
+		void
+		Custom(gnsdk_cstr_t option, gnsdk_cstr_t value);
+
+		/**
+		 *  Set option using option name, applied to any query the profile is applied to
+		 *  @param option   [in] Option name
+		 *  @param bEnable	[in] Option enable true/false
+		 */
+		void
+		Custom(gnsdk_cstr_t option, bool bEnable);
+
+		/**
+		 * Remove all options
+		 */
+		void
+		Clear();
+
+		/**
+		 * Number of options set
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		Count() const;
+
+		/**
+		 * Compare options, profiles are equal if they hold the same options with the same values
+		 * and set their custom options in the same order
+		 * @param rhs	[in] Profile to compare
+		 * @return True if equal
+		 */
+		bool
+		operator== (const GnQueryProfile& rhs) const;
+
+		bool
+		operator!= (const GnQueryProfile& rhs) const { return !operator==(rhs); }
+
+		/**
+		 * For internal use. Set the options of a profile on a query handle.
+		 * @param handle	[in] Query handle
+		 * @param setter	[in] Option set function of the module
+		 * @param keys		[in] Option key of each gn_option, GNSDK_NULL if the module does not have it
+		 */
+		template<typename _Handle>
+		void
+		apply(_Handle handle, gnsdk_error_t (GNSDK_API *setter)(_Handle, gnsdk_cstr_t, gnsdk_cstr_t), const gnsdk_cstr_t* keys) const throw (GnError)
+		{
+			gnsdk_uint32_t i;
+
+			for (i = 0; i < kOptionCount; i++)
+			{
+				if (values_[i] && keys[i])
+				{
+					if (setter(handle, keys[i], values_[i])) { throw GnError(); }
+				}
+			}
+
+			for (i = 0; i < custom_count_; i++)
+			{
+				if (setter(handle, custom_[i].key, custom_[i].value)) { throw GnError(); }
+			}
+		}
+
+	private:
+		struct custom_option
+		{
+			gnsdk_cstr_t	key;
+			gnsdk_cstr_t	value;
+		};
+
+		void
+		_set(gn_option option, gnsdk_cstr_t value);
+
+		void
+		_copy(const GnQueryProfile& other);
+
+		gnsdk_cstr_t		values_[kOptionCount];
+		custom_option*		custom_;
+		gnsdk_uint32_t		custom_count_;
+		gnsdk_uint32_t		custom_capacity_;
+	};
+
+}     // namespace gracenote
+
+#endif // _GNSDK_QUERYPROFILE_HPP_
@@ -40,6 +40,19 @@ namespace gracenote
 
 		static gnsdk_size_t
 		gn_strcpy(char* dest, gnsdk_size_t dest_size, gnsdk_cstr_t src);
+
+		/* size and modification time (seconds) of a regular file, false if it cannot be read */
+		static bool
+		gn_file_stat(gnsdk_cstr_t path, gnsdk_uint64_t* p_size, gnsdk_uint64_t* p_mtime);
+
+		/* seek from the start of a stdio FILE, offsets past 2 GB included. Passed as void* so
+		 * this header does not need <stdio.h> */
+		static bool
+		gn_fseek(void* file, gnsdk_uint64_t offset);
+
+		/* replace dest with src by renaming, false leaves both as they were */
+		static bool
+		gn_file_replace(gnsdk_cstr_t src, gnsdk_cstr_t dest);
 	};
 
 }
@@ -0,0 +1,91 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_stringpool.hpp: Interned string storage for wrapper snapshots */
+
+#ifndef _GNSDK_STRINGPOOL_HPP_
+#define _GNSDK_STRINGPOOL_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+
+
+namespace gracenote
+{
+	/**
+	 * GNSDK internal class. Stores one copy of each distinct string in large contiguous blocks.
+	 * Interned strings are never moved, equal strings intern to the same pointer so they can be
+	 * compared by address. Not thread safe while interning; once filled it can be read by many
+	 * threads.
+	 */
+	class gn_string_pool
+	{
+	public:
+		/**
+		 * @param blockSize	[in] Bytes per storage block, longer strings get a block of their own
+		 */
+		explicit
+		gn_string_pool(gnsdk_size_t blockSize = 16 * 1024);
+
+		~gn_string_pool();
+
+		/**
+		 * Store a string, or find the stored copy
+		 * @param str	[in] String, null is treated as empty
+		 * @return Stored copy, valid until the pool is cleared or destroyed
+		 */
+		gnsdk_cstr_t
+		intern(gnsdk_cstr_t str);
+
+		/**
+		 * Number of distinct strings
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		count() const { return count_; }
+
+		/**
+		 * Bytes of string data stored
+		 * @return Size
+		 */
+		gnsdk_size_t
+		bytes() const { return bytes_; }
+
+		/**
+		 * Release all strings
+		 */
+		void
+		clear();
+
+	private:
+		struct block;
+
+		gnsdk_str_t
+		_store(gnsdk_cstr_t str, gnsdk_size_t len);
+
+		void
+		_grow();
+
+		block*			blocks_;
+		gnsdk_size_t	block_size_;
+		gnsdk_cstr_t*	slots_;
+		gnsdk_uint32_t	slot_count_;
+		gnsdk_uint32_t	count_;
+		gnsdk_size_t	bytes_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_string_pool);
+	};
+
+}     // namespace gracenote
+
+#endif // _GNSDK_STRINGPOOL_HPP_
@@ -0,0 +1,447 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_thread.hpp: Threading primitives used internally by the C++ wrapper */
+
+#ifndef _GNSDK_THREAD_HPP_
+#define _GNSDK_THREAD_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "gnsdk_base.hpp"
+
+#if defined(GNSDK_WINDOWS)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+
+namespace gracenote
+{
+	/**
+	 * GNSDK internal class. Non-recursive mutual exclusion lock.
+	 */
+	class gn_mutex
+	{
+	public:
+		gn_mutex();
+		~gn_mutex();
+
+		void
+		lock();
+
+		void
+		unlock();
+
+	private:
+		friend class gn_condition;
+
+#if defined(GNSDK_WINDOWS)
+		CRITICAL_SECTION	native_;
+#else
+		pthread_mutex_t		native_;
+#endif
+
+		DISALLOW_COPY_AND_ASSIGN(gn_mutex);
+	};
+
+
+	/**
+	 * GNSDK internal class. Holds a gn_mutex for the lifetime of the object.
+	 */
+	class gn_lock
+	{
+	public:
+		explicit
+		gn_lock(gn_mutex& mutex) : mutex_(mutex) { mutex_.lock(); }
+		~gn_lock() { mutex_.unlock(); }
+
+	private:
+		gn_mutex&	mutex_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_lock);
+	};
+
+
+	/**
+	 * GNSDK internal class. Condition variable used together with gn_mutex.
+	 */
+	class gn_condition
+	{
+	public:
+		gn_condition();
+		~gn_condition();
+
+		/**
+		 * Wait for notification. Mutex must be held by the caller.
+		 */
+		void
+		wait(gn_mutex& mutex);
+
+		/**
+		 * Wait for notification for at most timeout_ms milliseconds. Mutex must be held by the caller.
+		 * @return false if the wait timed out
+		 */
+		bool
+		wait(gn_mutex& mutex, gnsdk_uint32_t timeout_ms);
+
+		void
+		notify_one();
+
+		void
+		notify_all();
+
+	private:
+#if defined(GNSDK_WINDOWS)
+		CONDITION_VARIABLE	native_;
+#else
+		pthread_cond_t		native_;
+#endif
+
+		DISALLOW_COPY_AND_ASSIGN(gn_condition);
+	};
+
+
+	/**
+	 * GNSDK internal class. 32 bit unsigned integer with atomic operations. Loads have acquire
+	 * and stores have release semantics, read-modify-write operations are full barriers. A load is
+	 * a plain read followed by a barrier, it never writes the shared cache line.
+	 */
+	class gn_atomic_uint32
+	{
+	public:
+		explicit
+		gn_atomic_uint32(gnsdk_uint32_t value = 0) : value_(value) { }
+
+#if defined(GNSDK_WINDOWS)
+		gnsdk_uint32_t	load() const						{ gnsdk_uint32_t value = value_; MemoryBarrier(); return value; }
+		void			store(gnsdk_uint32_t value)			{ InterlockedExchange((volatile LONG*)&value_, (LONG)value); }
+		gnsdk_uint32_t	fetch_add(gnsdk_uint32_t value)		{ return (gnsdk_uint32_t)InterlockedExchangeAdd((volatile LONG*)&value_, (LONG)value); }
+		gnsdk_uint32_t	fetch_sub(gnsdk_uint32_t value)		{ return (gnsdk_uint32_t)InterlockedExchangeAdd((volatile LONG*)&value_, -(LONG)value); }
+		gnsdk_uint32_t	fetch_or(gnsdk_uint32_t value)		{ return (gnsdk_uint32_t)InterlockedOr((volatile LONG*)&value_, (LONG)value); }
+		bool			compare_exchange(gnsdk_uint32_t expected, gnsdk_uint32_t desired)
+																{ return (gnsdk_uint32_t)InterlockedCompareExchange((volatile LONG*)&value_, (LONG)desired, (LONG)expected) == expected; }
+#elif defined(__ATOMIC_ACQUIRE)
+		gnsdk_uint32_t	load() const						{ return __atomic_load_n(&value_, __ATOMIC_ACQUIRE); }
+		void			store(gnsdk_uint32_t value)			{ __atomic_store_n(&value_, value, __ATOMIC_RELEASE); }
+		gnsdk_uint32_t	fetch_add(gnsdk_uint32_t value)		{ return __atomic_fetch_add(&value_, value, __ATOMIC_SEQ_CST); }
+		gnsdk_uint32_t	fetch_sub(gnsdk_uint32_t value)		{ return __atomic_fetch_sub(&value_, value, __ATOMIC_SEQ_CST); }
+		gnsdk_uint32_t	fetch_or(gnsdk_uint32_t value)		{ return __atomic_fetch_or(&value_, value, __ATOMIC_SEQ_CST); }
+		bool			compare_exchange(gnsdk_uint32_t expected, gnsdk_uint32_t desired)
+																{ return __atomic_compare_exchange_n(&value_, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); }
+#else
+		gnsdk_uint32_t	load() const						{ gnsdk_uint32_t value = value_; __sync_synchronize(); return value; }
+		void			store(gnsdk_uint32_t value)			{ __sync_synchronize(); value_ = value; __sync_synchronize(); }
+		gnsdk_uint32_t	fetch_add(gnsdk_uint32_t value)		{ return __sync_fetch_and_add(&value_, value); }
+		gnsdk_uint32_t	fetch_sub(gnsdk_uint32_t value)		{ return __sync_fetch_and_sub(&value_, value); }
+		gnsdk_uint32_t	fetch_or(gnsdk_uint32_t value)		{ return __sync_fetch_and_or(&value_, value); }
+		bool			compare_exchange(gnsdk_uint32_t expected, gnsdk_uint32_t desired)
+																{ return __sync_bool_compare_and_swap(&value_, expected, desired); }
+#endif
+
+	private:
+		volatile gnsdk_uint32_t	value_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_atomic_uint32);
+	};
+
+
+	/**
+	 * GNSDK internal class. Unit of work executed by gn_thread or gn_thread_pool.
+	 */
+	class gn_task
+	{
+	public:
+		gn_task() : next_(GNSDK_NULL) { }
+		virtual ~gn_task() { }
+
+		virtual void
+		run() = 0;
+
+	private:
+		friend class gn_task_queue;
+
+		gn_task*	next_;
+	};
+
+
+	/**
+	 * GNSDK internal class. Thread safe FIFO of tasks with an optional capacity. Producers block while
+	 * the queue is full and consumers block while it is empty, until the queue is closed.
+	 */
+	class gn_task_queue
+	{
+	public:
+		/**
+		 * @param capacity	[in] Maximum number of queued tasks, 0 for unbounded
+		 */
+		explicit
+		gn_task_queue(gnsdk_uint32_t capacity = 0);
+		~gn_task_queue();
+
+		/**
+		 * Append a task, blocking while the queue is full.
+		 * @return false if the queue has been closed, the task is not queued
+		 */
+		bool
+		push(gn_task* task);
+
+		/**
+		 * Append a task only if that can be done without blocking.
+		 * @return false if the queue is full or closed, the task is not queued
+		 */
+		bool
+		try_push(gn_task* task);
+
+		/**
+		 * Remove the oldest task, blocking while the queue is empty.
+		 * @return Task, or GNSDK_NULL once the queue is closed and drained
+		 */
+		gn_task*
+		pop();
+
+		/**
+		 * Remove the oldest task only if that can be done without blocking.
+		 * @return Task, or GNSDK_NULL if the queue is empty
+		 */
+		gn_task*
+		try_pop();
+
+		/**
+		 * Stop accepting tasks and wake all blocked producers and consumers. Queued
+		 * tasks can still be popped.
+		 */
+		void
+		close();
+
+		gnsdk_uint32_t
+		size() const;
+
+		gnsdk_uint32_t
+		capacity() const { return capacity_; }
+
+	private:
+		void
+		_append(gn_task* task);
+
+		mutable gn_mutex	mutex_;
+		gn_condition		not_empty_;
+		gn_condition		not_full_;
+		gn_task*			head_;
+		gn_task*			tail_;
+		gnsdk_uint32_t		size_;
+		gnsdk_uint32_t		capacity_;
+		bool				closed_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_task_queue);
+	};
+
+
+	/**
+	 * GNSDK internal class. Operating system thread running a single gn_task. The task is not
+	 * owned by the thread and must remain valid until join returns.
+	 */
+	class gn_thread
+	{
+	public:
+		gn_thread();
+		~gn_thread();
+
+		/**
+		 * Start the thread
+		 * @return false if the thread could not be created
+		 */
+		bool
+		start(gn_task* task);
+
+		/**
+		 * Wait for the thread to finish. Does nothing if the thread was not started.
+		 */
+		void
+		join();
+
+		/**
+		 * Whether the calling thread is this thread
+		 */
+		bool
+		is_current() const;
+
+		/**
+		 * Number of processors available to this process, at least 1
+		 */
+		static gnsdk_uint32_t
+		hardware_concurrency();
+
+		/**
+		 * Suspend the calling thread
+		 */
+		static void
+		sleep(gnsdk_uint32_t ms);
+
+		/**
+		 * Monotonic time in milliseconds from an unspecified starting point
+		 */
+		static gnsdk_uint64_t
+		tick_ms();
+
+	private:
+		bool			started_;
+#if defined(GNSDK_WINDOWS)
+		HANDLE			native_;
+		DWORD			id_;
+#else
+		pthread_t		native_;
+#endif
+
+		DISALLOW_COPY_AND_ASSIGN(gn_thread);
+	};
+
+
+	/**
+	 * GNSDK internal class. Fixed number of worker threads executing tasks from a bounded queue.
+	 * Posted tasks are owned by the pool and deleted after they have run. Exceptions thrown by a task
+	 * are swallowed so a failing task cannot take down a worker.
+	 */
+	class gn_thread_pool
+	{
+	public:
+		/**
+		 * @param threadCount	[in] Number of worker threads, 0 selects the number of processors
+		 * @param queueCapacity	[in] Maximum number of tasks waiting to run, 0 for unbounded
+		 */
+		gn_thread_pool(gnsdk_uint32_t threadCount, gnsdk_uint32_t queueCapacity) throw (GnError);
+		~gn_thread_pool();
+
+		/**
+		 * Queue a task, blocking while the queue is full.
+		 * @return false if the pool has been shut down, in which case the task is deleted
+		 */
+		bool
+		post(gn_task* task);
+
+		/**
+		 * Queue a task only if that can be done without blocking.
+		 * @return false if the queue is full or the pool has been shut down, the task remains owned by the caller
+		 */
+		bool
+		try_post(gn_task* task);
+
+		/**
+		 * Stop accepting tasks, run those already queued and join the workers.
+		 */
+		void
+		shutdown();
+
+		gnsdk_uint32_t
+		queued() const { return queue_.size(); }
+
+		gnsdk_uint32_t
+		thread_count() const { return thread_count_; }
+
+	private:
+		class worker;
+		friend class worker;
+
+		gn_task_queue		queue_;
+		gn_thread*			threads_;
+		worker*				workers_;
+		gnsdk_uint32_t		thread_count_;
+		bool				shutdown_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_thread_pool);
+	};
+
+
+	/**
+	 * GNSDK internal class. Fixed number of worker threads, each with its own deque of tasks.
+	 * A task posted by a worker goes to that worker's deque, other posts are spread over the deques
+	 * in turn. A worker runs its own tasks oldest first and when its deque is empty takes the newest
+	 * task of another worker, so a worker held up by slow tasks does not hold up the tasks queued
+	 * behind it. Taking a task only locks the deque it is taken from; the pool lock is only used by
+	 * idle workers going to sleep and by posts waiting for space. Tasks are owned and deleted as by
+	 * gn_thread_pool, exceptions thrown by a task are swallowed.
+	 */
+	class gn_work_stealing_pool
+	{
+	public:
+		/**
+		 * @param threadCount	[in] Number of worker threads, 0 selects the number of processors
+		 * @param queueCapacity	[in] Maximum number of tasks waiting to run, 0 for unbounded
+		 */
+		gn_work_stealing_pool(gnsdk_uint32_t threadCount, gnsdk_uint32_t queueCapacity) throw (GnError);
+		~gn_work_stealing_pool();
+
+		/**
+		 * Queue a task, blocking while the pool is full.
+		 * @return false if the pool has been shut down, in which case the task is deleted
+		 */
+		bool
+		post(gn_task* task);
+
+		/**
+		 * Stop accepting tasks, run those already queued and join the workers.
+		 */
+		void
+		shutdown();
+
+		/* tasks waiting to run */
+		gnsdk_uint32_t
+		queued() const { return queued_.load(); }
+
+		/* tasks running */
+		gnsdk_uint32_t
+		running() const { return running_.load(); }
+
+		/* tasks run by a worker other than the one they were queued to */
+		gnsdk_uint32_t
+		stolen() const { return stolen_.load(); }
+
+		gnsdk_uint32_t
+		thread_count() const { return thread_count_; }
+
+	private:
+		class worker;
+		friend class worker;
+
+		gn_task*
+		_take(gnsdk_uint32_t index);
+
+		void
+		_run_left();
+
+		gn_mutex			mutex_;
+		gn_condition		work_cond_;
+		gn_condition		space_cond_;
+		gn_atomic_uint32	queued_;		/* tasks on the deques */
+		gn_atomic_uint32	running_;
+		gn_atomic_uint32	sleeping_;		/* workers waiting for work */
+		gn_atomic_uint32	blocked_;		/* posts waiting for space */
+		gn_atomic_uint32	posting_;		/* posts between their shutdown check and their push */
+		gn_atomic_uint32	next_;
+		gn_atomic_uint32	stolen_;
+		gn_atomic_uint32	shutdown_;
+		gnsdk_uint32_t		capacity_;
+		gn_thread*			threads_;
+		worker*				workers_;
+		gnsdk_uint32_t		thread_count_;
+
+		DISALLOW_COPY_AND_ASSIGN(gn_work_stealing_pool);
+	};
+
+
+}     // namespace gracenote
+
+#endif // _GNSDK_THREAD_HPP_
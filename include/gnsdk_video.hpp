@@ -16,6 +16,7 @@
 #endif
 
 #include "gnsdk_base.hpp"
+#include "gnsdk_queryprofile.hpp"
 #include "gnsdk_list.hpp"
 #include "metadata_video.hpp"
 
@@ -366,6 +367,13 @@ namespace gracenote
 			void
 			Custom(gnsdk_cstr_t optionKey, gnsdk_cstr_t value) throw (GnError);
 
+			/**
+			 *  Set all options of a query profile, options the Video query does not support are ignored
+			 *  @param profile [in] Options prepared once with GnQueryProfile
+			 */
+			void
+			Profile(const GnQueryProfile& profile) throw (GnError);
+
 		protected:
 			GnVideoOptions() : weakhandle_(GNSDK_NULL) {};
 
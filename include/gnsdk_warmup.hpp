@@ -0,0 +1,170 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+*  @file gnsdk_warmup.hpp
+*/
+
+#ifndef _GNSDK_WARMUP_HPP_
+#define _GNSDK_WARMUP_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning( disable : 4290 ) /* disable "warning C4290: C++ exception specification ignored except to indicate a function is not __declspec(nothrow)" */
+#endif
+
+#include "gnsdk_base.hpp"
+#include "gnsdk_locale.hpp"
+#include "gnsdk_list.hpp"
+
+namespace gracenote
+{
+	/**
+	 * Kind of state loaded by a GnWarmUpPlan item
+	 */
+	enum GnWarmUpItemType
+	{
+		kWarmUpItemModules = 0,
+		kWarmUpItemLocale,
+		kWarmUpItemList
+	};
+
+
+	/**
+	 *  \class GnWarmUpPlan
+	 *  Declares the state an application needs resident before serving requests, for use with
+	 *  GnManager::WarmUp. Locales and lists are loaded in parallel once the modules have been
+	 *  initialized. After WarmUp the plan reports the outcome and load time of each item, and
+	 *  keeps the loaded locales and lists alive until the plan is destroyed.
+	 */
+	class GnWarmUpPlan
+	{
+	public:
+		GNWRAPPER_ANNOTATE
+
+		GnWarmUpPlan();
+
+		~GnWarmUpPlan();
+
+		/**
+		 * Initialize GNSDK modules, see GnManager::Preload. Repeated calls add to the set.
+		 * @param moduleMask	[in] Combination of GNSDK_MODULE_ values
+		 */
+		void
+		Modules(gnsdk_uint32_t moduleMask);
+
+		/**
+		 * Load a locale
+		 * @param group				[in] Locale group
+		 * @param language			[in] Language
+		 * @param region			[in] Region
+		 * @param descriptor		[in] Descriptor
+		 * @param bSetGroupDefault	[in] Make the locale the default of its group once loaded
+		 */
+		void
+		AddLocale(GnLocaleGroup group, GnLanguage language, GnRegion region, GnDescriptor descriptor, bool bSetGroupDefault = false);
+
+		/**
+		 * Load a list
+		 * @param listType		[in] List type
+		 * @param language		[in] Language
+		 * @param region		[in] Region
+		 * @param descriptor	[in] Descriptor
+		 */
+		void
+		AddList(GnListType listType, GnLanguage language, GnRegion region, GnDescriptor descriptor);
+
+		/**
+		 * Number of threads loading locales and lists
+		 * @param threadCount	[in] Thread count, 0 (the default) selects the number of processors
+		 */
+		void
+		Threads(gnsdk_uint32_t threadCount) { threads_ = threadCount; }
+
+		/**
+		 * Number of items in the plan. Modules count as a single item.
+		 * @return Count
+		 */
+		gnsdk_uint32_t
+		ItemCount() const { return count_; }
+
+		/**
+		 * Kind of an item
+		 * @param itemIndex	[in] Index in the order items were added
+		 * @return Item type
+		 */
+		GnWarmUpItemType
+		ItemType(gnsdk_uint32_t itemIndex) const throw (GnError);
+
+		/**
+		 * Whether an item was loaded by the last WarmUp
+		 * @param itemIndex	[in] Index in the order items were added
+		 * @return True if loaded
+		 */
+		bool
+		ItemReady(gnsdk_uint32_t itemIndex) const throw (GnError);
+
+		/**
+		 * Time the last WarmUp spent loading an item
+		 * @param itemIndex	[in] Index in the order items were added
+		 * @return Milliseconds
+		 */
+		gnsdk_uint32_t
+		ItemElapsedMs(gnsdk_uint32_t itemIndex) const throw (GnError);
+
+		/**
+		 * Error that prevented an item from loading
+		 * @param itemIndex	[in] Index in the order items were added
+		 * @return Error, or GNSDK_NULL if the item loaded or was not attempted
+		 */
+		const GnError*
+		ItemError(gnsdk_uint32_t itemIndex) const throw (GnError);
+
+		/**
+		 * Whether every item was loaded by the last WarmUp. Suitable as a readiness check.
+		 * @return True if ready
+		 */
+		bool
+		Ready() const;
+
+		/**
+		 * Wall clock time of the last WarmUp
+		 * @return Milliseconds
+		 */
+		gnsdk_uint32_t
+		ElapsedMs() const { return elapsed_ms_; }
+
+	private:
+		class item;
+		class load_task;
+		friend class GnManager;
+
+		item*
+		_add(GnWarmUpItemType type);
+
+		item*
+		_item(gnsdk_uint32_t itemIndex) const throw (GnError);
+
+		item**				items_;
+		gnsdk_uint32_t		count_;
+		gnsdk_uint32_t		capacity_;
+		gnsdk_uint32_t		threads_;
+		gnsdk_uint32_t		elapsed_ms_;
+
+		DISALLOW_COPY_AND_ASSIGN(GnWarmUpPlan);
+	};
+
+} /* namespace gracenote */
+
+
+#endif /* _GNSDK_WARMUP_HPP_ */
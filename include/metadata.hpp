@@ -170,6 +170,120 @@ namespace gracenote
 			friend class GnDataObject;
 		};
 
+
+		/**
+		 * \class GnFieldSet
+		 * Declares the values GnDataObject::Extract reads from a data object. A field is named by a
+		 * path of child keys ending in a value key, separated by '/', for example
+		 * "gnsdk_ctx_title!official/gnsdk_val_display". A key may be followed by '#' and a 1-based
+		 * ordinal, "gnsdk_ctx_genre#2/gnsdk_val_display", otherwise the first occurrence is used.
+		 * Fields sharing child keys share their lookups. Build a field set once and use it for
+		 * every object; a field set that is no longer modified can be used by many threads at once.
+		 */
+		class GnFieldSet
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			GnFieldSet();
+
+			~GnFieldSet();
+
+			/**
+			 * Add a field
+			 * @param path	[in] Child keys and value key separated by '/'
+			 * @return Index of the field in records extracted with this field set
+			 */
+			gnsdk_uint32_t
+			Add(gnsdk_cstr_t path) throw (GnError);
+
+			/**
+			 * Number of fields
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Count() const { return field_count_; }
+
+		private:
+			struct node;
+			struct field;
+			friend class GnDataObject;
+
+			gnsdk_uint32_t
+			_node(gnsdk_uint32_t parent, gnsdk_cstr_t key, gnsdk_size_t keyLen, gnsdk_uint32_t ordinal);
+
+			node*			nodes_;
+			gnsdk_uint32_t	node_count_;
+			gnsdk_uint32_t	node_capacity_;
+			field*			fields_;
+			gnsdk_uint32_t	field_count_;
+			gnsdk_uint32_t	field_capacity_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnFieldSet);
+		};
+
+
+		/**
+		 * \class GnFieldRecord
+		 * Values read by GnDataObject::Extract, indexed like the fields of the GnFieldSet. Values
+		 * remain valid while the extracted object exists, until the record is extracted into again
+		 * or destroyed. Reuse a record for
+		 * many objects to avoid allocating per object.
+		 */
+		class GnFieldRecord
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			GnFieldRecord();
+
+			~GnFieldRecord();
+
+			/**
+			 * Number of fields
+			 * @return Count
+			 */
+			gnsdk_uint32_t
+			Count() const { return value_count_; }
+
+			/**
+			 * Value of a field
+			 * @param fieldIndex	[in] Index returned by GnFieldSet::Add
+			 * @return Value, empty string if the object has no such value
+			 */
+			gnsdk_cstr_t
+			Value(gnsdk_uint32_t fieldIndex) const;
+
+			/**
+			 * Whether the object has a value for a field
+			 * @param fieldIndex	[in] Index returned by GnFieldSet::Add
+			 * @return True if present
+			 */
+			bool
+			Has(gnsdk_uint32_t fieldIndex) const;
+
+			/**
+			 * Release the child objects held for the values
+			 */
+			void
+			Clear();
+
+		private:
+			friend class GnDataObject;
+
+			void
+			_reserve(gnsdk_uint32_t valueCount, gnsdk_uint32_t handleCount);
+
+			gnsdk_cstr_t*		values_;
+			gnsdk_uint32_t		value_count_;
+			gnsdk_uint32_t		value_capacity_;
+			gnsdk_gdo_handle_t*	handles_;
+			gnsdk_uint32_t		handle_count_;
+			gnsdk_uint32_t		handle_capacity_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnFieldRecord);
+		};
+
 		/**
 		 * Gracenote Data Object - encapsulation of GNSDK delivered media elements and metadata.
 		 */
@@ -182,6 +296,16 @@ namespace gracenote
 			GnDataObject(const GnDataObject& obj) : GnObject(obj) { }
 			GnDataObject(gnsdk_gdo_handle_t gdoHandle) : GnObject(gdoHandle){ }
 
+#if GNWRAPPER_MOVE_SEMANTICS && !defined(SWIG)
+			GnDataObject(GnDataObject&& obj) throw () : GnObject(static_cast<GnObject&&>(obj)) { }
+
+			GnDataObject&
+			operator= (const GnDataObject& obj) { GnObject::operator=(obj); return *this; }
+
+			GnDataObject&
+			operator= (GnDataObject&& obj) { GnObject::operator=(static_cast<GnObject&&>(obj)); return *this; }
+#endif
+
 			GnDataObject(gnsdk_cstr_t id, gnsdk_cstr_t idTag, gnsdk_cstr_t idSrc) throw (GnError)
 			{
 				gnsdk_gdo_handle_t handle = GNSDK_NULL;
@@ -296,6 +420,18 @@ namespace gracenote
 				return sz_value;
 			}
 
+			/**
+			 * Get a metadata value as a string view, valid while this object is alive.
+			 * @param valueKey		[in] Key of the value to return
+			 * @param ordinal		[in] 1-based specifier of a value where multiple values for a key exist
+			 * @return String view, empty if the value does not exist
+			 */
+			GnStringView
+			StringView(gnsdk_cstr_t valueKey, gnsdk_uint32_t ordinal = 1) const
+			{
+				return GnStringView(StringValue(valueKey, ordinal));
+			}
+
 			/**
 			 * Number of children available for a given key.
 			 * @param childKey [in] Child key to count
@@ -389,6 +525,16 @@ namespace gracenote
 			}
 		
 
+			/**
+			 * Reads all fields of a field set in one pass, without creating a wrapper object per
+			 * child or value. Fields whose child or value does not exist are left empty, other
+			 * GNSDK errors are thrown.
+			 * @param fieldSet	[in] Fields to read
+			 * @param record	[out] Receives the values, previous contents are released
+			 */
+			void
+			Extract(const GnFieldSet& fieldSet, GnFieldRecord& record) const throw (GnError);
+
 			/**
 			 * Returns the native handle for the data object.
 			 * @return Native handle
@@ -485,6 +631,7 @@ namespace gracenote
 
 			gn_gdo_provider(const GnDataObject& obj, gnsdk_cstr_t key) : obj_(obj), key_(key) { }
 			~gn_gdo_provider() { }
+			GNSDK_MOVABLE(gn_gdo_provider)
 
 			/* required */
 			_GdoType
@@ -565,6 +712,7 @@ namespace gracenote
 
 			virtual
 			~GnAsset() { }
+			GNSDK_MOVABLE(GnAsset)
 
 			/**
 			 *  Asset dimension
@@ -801,6 +949,7 @@ namespace gracenote
 
 			virtual
 			~GnExternalId()  { }
+			GNSDK_MOVABLE(GnExternalId)
 
 			/**
 			 *  External ID source (e.g., Amazon)
@@ -860,6 +1009,7 @@ namespace gracenote
 
 			virtual
 			~GnRole() { }
+			GNSDK_MOVABLE(GnRole)
 
 			/**
 			 * Role category, such as string instruments or brass instruments.
@@ -908,6 +1058,7 @@ namespace gracenote
 
 			virtual
 			~GnName()  { }
+			GNSDK_MOVABLE(GnName)
 
 			/**
 			 *  Name display language
@@ -1024,6 +1175,7 @@ namespace gracenote
 
 			virtual
 			~GnTitle() { }
+			GNSDK_MOVABLE(GnTitle)
 
 
 			/**
@@ -1140,6 +1292,7 @@ namespace gracenote
 
 			virtual
 			~GnContributor() { }
+			GNSDK_MOVABLE(GnContributor)
 
 			/**
 			 *  Flag indicating if data object response contains full (true) or partial metadata.
@@ -1524,6 +1677,7 @@ namespace gracenote
 
 			virtual
 			~GnCredit() { }
+			GNSDK_MOVABLE(GnCredit)
 
 			/**
 			 * Credit's name, such as the name of the person or company.
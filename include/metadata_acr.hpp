@@ -153,6 +153,7 @@ namespace gracenote
 
 			virtual
 			~GnAcrMatch() { }
+			GNSDK_MOVABLE(GnAcrMatch)
 
 			/**
 			 *	Match position
@@ -280,6 +281,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseAcrMatch() { }
+			GNSDK_MOVABLE(GnResponseAcrMatch)
 
 			/**
 			 *  Total number of result matches
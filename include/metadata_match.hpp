@@ -59,6 +59,7 @@ namespace gracenote
 
 			virtual
 			~GnMatch() { }
+			GNSDK_MOVABLE(GnMatch)
 
 			/**
 			 * Match's Gracenote Tui (title-unique identifier)
@@ -124,6 +125,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseMatches() { }
+			GNSDK_MOVABLE(GnResponseMatches)
 
 			/**
 			 * Iterator for accessing response match(es)
@@ -70,6 +70,7 @@ namespace gracenote
 
 			virtual
 			~GnAudioWork() { }
+			GNSDK_MOVABLE(GnAudioWork)
 
 			/**
 			 * Audio work's official title.
@@ -291,6 +292,7 @@ namespace gracenote
 
 			virtual
 			~GnArtist() { }
+			GNSDK_MOVABLE(GnArtist)
 
 			/**
 			 * Artist's official name.
@@ -343,6 +345,7 @@ namespace gracenote
 
 			virtual
 			~GnTrack() { }
+			GNSDK_MOVABLE(GnTrack)
 
 			/**
 			 *  Flag indicating if response contains full (true) or partial (false) metadata.
@@ -793,6 +796,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseTracks() { }
+			GNSDK_MOVABLE(GnResponseTracks)
 
 			/**
 			 *  Result count - number of matches returned
@@ -894,6 +898,7 @@ namespace gracenote
 
 			virtual
 			~GnAlbum() { }
+			GNSDK_MOVABLE(GnAlbum)
 
 			/**
 			 *  Flag indicating if response contains full (true) or partial (false) metadata.
@@ -1320,6 +1325,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseAlbums() { }
+			GNSDK_MOVABLE(GnResponseAlbums)
 
 			/**
 			 *  Number of matches returned
@@ -1446,6 +1452,7 @@ namespace gracenote
 
 			virtual
 			~GnDataMatch() { }
+			GNSDK_MOVABLE(GnDataMatch)
 
 			/**
 			 *  Flag indicating if match is album
@@ -1524,6 +1531,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseDataMatches() { }
+			GNSDK_MOVABLE(GnResponseDataMatches)
 
 
 			/**
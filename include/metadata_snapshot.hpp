@@ -0,0 +1,208 @@
+/** Public header file for Gracenote SDK C++ Wrapper
+ * Author:
+ *   Copyright (c) 2014 Gracenote, Inc.
+ *
+ *   This software may not be used in any way or distributed without
+ *   permission. All rights reserved.
+ *
+ *   Some code herein may be covered by US and international patents.
+ */
+
+/**
+ * @file metadata_snapshot.hpp
+ */
+
+#ifndef _GNSDK_METADATA_SNAPSHOT_HPP_
+#define _GNSDK_METADATA_SNAPSHOT_HPP_
+
+#ifndef __cplusplus
+#error "C++ compiler required"
+#endif
+
+#include "metadata_music.hpp"
+#include "gnsdk_stringpool.hpp"
+
+namespace gracenote
+{
+	namespace metadata
+	{
+		/** Index value of a link that does not exist */
+		#define GN_SNAPSHOT_NONE		GN_UINT32_MAX
+
+		/**
+		 * Contributor (artist) in a GnAlbumsSnapshot. Contributors with the same gnid, or without a gnid
+		 * and with the same name, are stored once.
+		 */
+		struct GnContributorSnapshot
+		{
+			gnsdk_cstr_t	name;			/**< Official name, display form */
+			gnsdk_cstr_t	gnid;			/**< Gracenote ID of the contributor */
+		};
+
+		/**
+		 * Track in a GnAlbumsSnapshot
+		 */
+		struct GnTrackSnapshot
+		{
+			gnsdk_cstr_t	title;			/**< Official title, display form */
+			gnsdk_uint32_t	number;			/**< Track number, 0 if unknown */
+			gnsdk_cstr_t	year;
+			gnsdk_cstr_t	genre[3];		/**< Genre at kDataLevel_1 to kDataLevel_3 */
+			gnsdk_uint32_t	duration_ms;	/**< Duration, 0 if unknown */
+			gnsdk_cstr_t	gnid;
+			gnsdk_cstr_t	tui;
+			gnsdk_cstr_t	tui_tag;
+			gnsdk_uint32_t	artist;			/**< Contributor index, GN_SNAPSHOT_NONE if the track has no artist of its own */
+			gnsdk_uint32_t	album;			/**< Album index */
+		};
+
+		/**
+		 * Album in a GnAlbumsSnapshot. Its tracks are stored contiguously.
+		 */
+		struct GnAlbumSnapshot
+		{
+			gnsdk_cstr_t	title;			/**< Official title, display form */
+			gnsdk_cstr_t	year;
+			gnsdk_cstr_t	label;
+			gnsdk_cstr_t	genre[3];		/**< Genre at kDataLevel_1 to kDataLevel_3 */
+			gnsdk_cstr_t	gnid;
+			gnsdk_cstr_t	tui;
+			gnsdk_cstr_t	tui_tag;
+			gnsdk_uint32_t	artist;			/**< Contributor index, GN_SNAPSHOT_NONE if unknown */
+			gnsdk_uint32_t	first_track;	/**< Index of the first track */
+			gnsdk_uint32_t	track_count;	/**< Number of tracks */
+		};
+
+
+		/**
+		 * \class GnAlbumsSnapshot
+		 * Copy of the commonly used album, track and artist metadata of a response, read out of GNSDK
+		 * once into contiguous arrays. Strings are interned, equal strings share storage and
+		 * compare equal by address, and records refer to each other by index.
+		 * Reading a snapshot makes no GNSDK calls and creates no wrapper objects. A filled snapshot
+		 * is immutable and can be read by many threads at once. It does not depend on the response
+		 * it was made from.
+		 */
+		class GnAlbumsSnapshot
+		{
+		public:
+			GNWRAPPER_ANNOTATE
+
+			/**
+			 * Construct an empty snapshot
+			 */
+			GnAlbumsSnapshot();
+
+			/**
+			 * Construct a snapshot of all albums in a response
+			 * @param response	[in] Response to copy
+			 */
+			explicit
+			GnAlbumsSnapshot(const GnResponseAlbums& response) throw (GnError);
+
+			~GnAlbumsSnapshot();
+
+			/**
+			 * Append all albums of a response
+			 * @param response	[in] Response to copy
+			 */
+			void
+			Add(const GnResponseAlbums& response) throw (GnError);
+
+			/**
+			 * Append an album and its tracks
+			 * @param album		[in] Album to copy
+			 * @return Index of the album
+			 */
+			gnsdk_uint32_t
+			Add(const GnAlbum& album) throw (GnError);
+
+			/**
+			 * Remove all records and strings
+			 */
+			void
+			Clear();
+
+			gnsdk_uint32_t
+			AlbumCount() const { return album_count_; }
+
+			gnsdk_uint32_t
+			TrackCount() const { return track_count_; }
+
+			gnsdk_uint32_t
+			ContributorCount() const { return contributor_count_; }
+
+			/**
+			 * Album by index
+			 * @param index	[in] 0-based album index
+			 * @return Album record
+			 */
+			const GnAlbumSnapshot&
+			Album(gnsdk_uint32_t index) const throw (GnError);
+
+			/**
+			 * Track by index, tracks of album a are a.first_track to a.first_track + a.track_count - 1
+			 * @param index	[in] 0-based track index
+			 * @return Track record
+			 */
+			const GnTrackSnapshot&
+			Track(gnsdk_uint32_t index) const throw (GnError);
+
+			/**
+			 * Contributor by index
+			 * @param index	[in] 0-based contributor index
+			 * @return Contributor record
+			 */
+			const GnContributorSnapshot&
+			Contributor(gnsdk_uint32_t index) const throw (GnError);
+
+			/**
+			 * Contiguous album records, AlbumCount() long
+			 * @return Albums
+			 */
+			const GnAlbumSnapshot*
+			Albums() const { return albums_; }
+
+			/**
+			 * Contiguous track records, TrackCount() long
+			 * @return Tracks
+			 */
+			const GnTrackSnapshot*
+			Tracks() const { return tracks_; }
+
+			/**
+			 * Contiguous contributor records, ContributorCount() long
+			 * @return Contributors
+			 */
+			const GnContributorSnapshot*
+			Contributors() const { return contributors_; }
+
+		private:
+			gnsdk_uint32_t
+			_add(const GnDataObject& album, const GnFieldSet& albumFields, const GnFieldSet& trackFields, GnFieldRecord& record);
+
+			gnsdk_uint32_t
+			_contributor(gnsdk_cstr_t name, gnsdk_cstr_t gnid);
+
+			gn_string_pool				strings_;
+			GnAlbumSnapshot*			albums_;
+			gnsdk_uint32_t				album_count_;
+			gnsdk_uint32_t				album_capacity_;
+			GnTrackSnapshot*			tracks_;
+			gnsdk_uint32_t				track_count_;
+			gnsdk_uint32_t				track_capacity_;
+			GnContributorSnapshot*		contributors_;
+			gnsdk_uint32_t				contributor_count_;
+			gnsdk_uint32_t				contributor_capacity_;
+			gnsdk_uint32_t*				contributor_slots_;
+			gnsdk_uint32_t				contributor_slot_count_;
+
+			DISALLOW_COPY_AND_ASSIGN(GnAlbumsSnapshot);
+		};
+
+	} /* namespace metadata */
+
+} /* namespace gracenote */
+
+
+#endif /* _GNSDK_METADATA_SNAPSHOT_HPP_ */
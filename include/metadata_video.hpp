@@ -84,6 +84,7 @@ namespace gracenote
 
 			virtual
 			~GnRating() { }
+			GNSDK_MOVABLE(GnRating)
 
 			/**
 			 *  Rating value, e.g., PG
@@ -353,6 +354,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoCredit()  { }
+			GNSDK_MOVABLE(GnVideoCredit)
 
 			/**
 			 *  Role, e.g., Actor.
@@ -618,6 +620,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoChapter()  { }
+			GNSDK_MOVABLE(GnVideoChapter)
 
 			/**
 			 * Video chapter's ordinal value.
@@ -690,6 +693,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoSeason() { }
+			GNSDK_MOVABLE(GnVideoSeason)
 
 			/**
 			 *  Flag indicating if response result contains full (true) or partial metadata.
@@ -1193,6 +1197,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoSeries()  { }
+			GNSDK_MOVABLE(GnVideoSeries)
 
 			/**
 			 *  Flag indicating if response result contains full (true) or partial metadata.
@@ -1753,6 +1758,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoWork() { }
+			GNSDK_MOVABLE(GnVideoWork)
 
 			/**
 			 *  Flag indicating if result contains full (true) or partial metadata.
@@ -2416,6 +2422,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoFeature()  { }
+			GNSDK_MOVABLE(GnVideoFeature)
 
 			/**
 			 *  Feature's ordinal value
@@ -2714,6 +2721,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoLayer() { }
+			GNSDK_MOVABLE(GnVideoLayer)
 
 			/**
 			 *  Ordinal value
@@ -2860,6 +2868,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoSide() { }
+			GNSDK_MOVABLE(GnVideoSide)
 
 			/**
 			 *  Ordinal value
@@ -2937,6 +2946,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoDisc()  { }
+			GNSDK_MOVABLE(GnVideoDisc)
 
 			/**
 			 * Gracenote ID
@@ -3065,6 +3075,7 @@ namespace gracenote
 
 			virtual
 			~GnVideoProduct()  { }
+			GNSDK_MOVABLE(GnVideoProduct)
 
 			/**
 			 *  Flag indicating if response result contains full (true) or partial metadata
@@ -3445,6 +3456,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoSuggestions() { }
+			GNSDK_MOVABLE(GnResponseVideoSuggestions)
 
 			/**
 			 *  Result count - total number of matches
@@ -3564,6 +3576,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoObjects() { }
+			GNSDK_MOVABLE(GnResponseVideoObjects)
 
 			/**
 			 *  ResultCount - total number of returned matches
@@ -3690,6 +3703,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseContributors() { }
+			GNSDK_MOVABLE(GnResponseContributors)
 
 			/**
 			 *  Total number of results
@@ -3787,6 +3801,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoSeries() { }
+			GNSDK_MOVABLE(GnResponseVideoSeries)
 
 			/**
 			 *  Total number of returned matches
@@ -3886,6 +3901,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoSeasons()  { }
+			GNSDK_MOVABLE(GnResponseVideoSeasons)
 
 			/**
 			 *  Total number of returned matches
@@ -3985,6 +4001,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoWork() { }
+			GNSDK_MOVABLE(GnResponseVideoWork)
 
 			/**
 			 *  Total number of returned results
@@ -4084,6 +4101,7 @@ namespace gracenote
 
 			virtual
 			~GnResponseVideoProduct()  { }
+			GNSDK_MOVABLE(GnResponseVideoProduct)
 
 			/**
 			 *  Total number of results
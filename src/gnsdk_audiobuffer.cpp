@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_audiobuffer.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_audiobuffer.hpp"
+
+using namespace gracenote;
+
+
+/* Buffers of one sample format and size */
+struct GnAudioBufferPool::slab
+{
+	gnsdk_uint32_t	samples_per_second;
+	gnsdk_uint32_t	bits_per_sample;
+	gnsdk_uint32_t	number_of_channels;
+	gnsdk_size_t	size;
+	header*			free_;
+	gnsdk_uint32_t	free_count;
+	slab*			next;
+};
+
+/* Precedes every buffer, padded so the audio data that follows is suitably aligned */
+union GnAudioBufferPool::header
+{
+	struct
+	{
+		slab*		owner;
+		header*		next;
+	} link;
+	double			align_;
+	char			pad_[16];
+};
+
+
+GnAudioBufferPool::GnAudioBufferPool(gnsdk_uint32_t maxCachedPerFormat) :
+	slabs_(GNSDK_NULL),
+	max_cached_(maxCachedPerFormat),
+	borrowed_(0),
+	reused_(0),
+	allocated_(0),
+	cached_(0)
+{
+}
+
+GnAudioBufferPool::~GnAudioBufferPool()
+{
+	slab* p_slab;
+
+	Trim();
+
+	while (slabs_)
+	{
+		p_slab = slabs_;
+		slabs_ = p_slab->next;
+		delete p_slab;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Default
+ */
+GnAudioBufferPool&
+GnAudioBufferPool::Default()
+{
+	/* constructed on first use so callers from other static initializers find it ready,
+	 * the compiler guards the construction against concurrent first calls */
+	static GnAudioBufferPool s_default_pool;
+
+	return s_default_pool;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Borrow
+ */
+gnsdk_byte_t*
+GnAudioBufferPool::Borrow(gnsdk_uint32_t samplesPerSecond, gnsdk_uint32_t bitsPerSample, gnsdk_uint32_t numberOfChannels, gnsdk_size_t size)
+{
+	gn_lock lock(mutex_);
+	slab*   p_slab;
+	header* p_header;
+
+	for (p_slab = slabs_; p_slab; p_slab = p_slab->next)
+	{
+		if ((p_slab->size == size)
+			&& (p_slab->samples_per_second == samplesPerSecond)
+			&& (p_slab->bits_per_sample == bitsPerSample)
+			&& (p_slab->number_of_channels == numberOfChannels))
+		{
+			break;
+		}
+	}
+
+	if (GNSDK_NULL == p_slab)
+	{
+		p_slab = new slab;
+		p_slab->samples_per_second = samplesPerSecond;
+		p_slab->bits_per_sample    = bitsPerSample;
+		p_slab->number_of_channels = numberOfChannels;
+		p_slab->size               = size;
+		p_slab->free_              = GNSDK_NULL;
+		p_slab->free_count         = 0;
+		p_slab->next               = slabs_;
+		slabs_ = p_slab;
+	}
+
+	borrowed_ += 1;
+
+	p_header = p_slab->free_;
+	if (p_header)
+	{
+		p_slab->free_       = p_header->link.next;
+		p_slab->free_count -= 1;
+		cached_            -= 1;
+		reused_            += 1;
+	}
+	else
+	{
+		p_header = (header*)new gnsdk_byte_t[sizeof(header) + size];
+		p_header->link.owner = p_slab;
+		allocated_ += 1;
+	}
+	p_header->link.next = GNSDK_NULL;
+
+	return (gnsdk_byte_t*)(p_header + 1);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Return
+ */
+void
+GnAudioBufferPool::Return(gnsdk_byte_t* buffer)
+{
+	header* p_header;
+	slab*   p_slab;
+
+	if (GNSDK_NULL == buffer)
+	{
+		return;
+	}
+
+	p_header = ((header*)buffer) - 1;
+	p_slab   = p_header->link.owner;
+
+	{
+		gn_lock lock(mutex_);
+
+		if (p_slab->free_count < max_cached_)
+		{
+			p_header->link.next = p_slab->free_;
+			p_slab->free_       = p_header;
+			p_slab->free_count += 1;
+			cached_            += 1;
+			return;
+		}
+	}
+
+	delete [] (gnsdk_byte_t*)p_header;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Trim
+ */
+void
+GnAudioBufferPool::Trim()
+{
+	gn_lock lock(mutex_);
+	header* p_header;
+
+	for (slab* p_slab = slabs_; p_slab; p_slab = p_slab->next)
+	{
+		while (p_slab->free_)
+		{
+			p_header      = p_slab->free_;
+			p_slab->free_ = p_header->link.next;
+			delete [] (gnsdk_byte_t*)p_header;
+		}
+		p_slab->free_count = 0;
+	}
+	cached_ = 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  BorrowCount
+ */
+gnsdk_uint32_t
+GnAudioBufferPool::BorrowCount() const
+{
+	gn_lock lock(mutex_);
+
+	return borrowed_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ReuseCount
+ */
+gnsdk_uint32_t
+GnAudioBufferPool::ReuseCount() const
+{
+	gn_lock lock(mutex_);
+
+	return reused_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AllocationCount
+ */
+gnsdk_uint32_t
+GnAudioBufferPool::AllocationCount() const
+{
+	gn_lock lock(mutex_);
+
+	return allocated_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  CachedCount
+ */
+gnsdk_uint32_t
+GnAudioBufferPool::CachedCount() const
+{
+	gn_lock lock(mutex_);
+
+	return cached_;
+}
+
+
+/******************************************************************************
+** gn_audio_reader
+*/
+gn_audio_reader::gn_audio_reader(IGnAudioSource& audioSource, gnsdk_size_t chunkSize) :
+	source_(audioSource),
+	span_source_(audioSource.SpanSource()),
+	span_data_(GNSDK_NULL),
+	span_size_(0),
+	buffer_(GNSDK_NULL),
+	chunk_size_(chunkSize)
+{
+	if (GNSDK_NULL == span_source_)
+	{
+		buffer_ = GnAudioBufferPool::Default().Borrow(audioSource.SamplesPerSecond(), audioSource.SampleSizeInBits(), audioSource.NumberOfChannels(), chunkSize);
+	}
+}
+
+gn_audio_reader::~gn_audio_reader()
+{
+	_release_span();
+	GnAudioBufferPool::Default().Return(buffer_);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  read
+ */
+gnsdk_size_t
+gn_audio_reader::read(const gnsdk_byte_t** pData, gnsdk_size_t maxSize)
+{
+	gnsdk_size_t size;
+
+	if (span_source_)
+	{
+		_release_span();
+
+		span_size_ = span_source_->SpanAcquire(&span_data_);
+		if (0 == span_size_)
+		{
+			span_data_ = GNSDK_NULL;
+		}
+
+		*pData = span_data_;
+		return span_size_;
+	}
+
+	size = chunk_size_;
+	if (maxSize && (maxSize < size))
+	{
+		size = maxSize;
+	}
+
+	*pData = buffer_;
+	return source_.GetData(buffer_, size);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  chunk_size
+ */
+gnsdk_size_t
+gn_audio_reader::chunk_size(IGnAudioSource& audioSource, gnsdk_uint32_t durationMs)
+{
+	gnsdk_uint64_t frame_size;
+	gnsdk_uint64_t frames;
+
+	frame_size = (gnsdk_uint64_t)(audioSource.SampleSizeInBits() / 8) * audioSource.NumberOfChannels();
+	frames     = ((gnsdk_uint64_t)audioSource.SamplesPerSecond() * durationMs) / 1000;
+	if (0 == frames)
+	{
+		frames = 1;
+	}
+
+	return (gnsdk_size_t)(frames * frame_size);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _release_span
+ */
+void
+gn_audio_reader::_release_span()
+{
+	if (span_data_)
+	{
+		span_source_->SpanRelease(span_data_, span_size_);
+		span_data_ = GNSDK_NULL;
+		span_size_ = 0;
+	}
+}
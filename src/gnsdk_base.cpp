@@ -451,6 +451,36 @@ GnObject::operator = (const GnObject& rhs) throw (GnError)
 	return *this;
 }
 
+#if GNWRAPPER_MOVE_SEMANTICS
+/*-----------------------------------------------------------------------------
+ *  operator = (move)
+ */
+GnObject&
+GnObject::operator = (GnObject&& rhs) throw (GnError)
+{
+	gnsdk_handle_t handle;
+
+	if (this == &rhs)
+	{
+		return *this;
+	}
+
+	/* take the handle first, releasing ours may destroy rhs when it is owned by our object */
+	handle      = rhs.handle_;
+	rhs.handle_ = GNSDK_NULL;
+
+	if (GNSDK_NULL != handle_)
+	{
+		gnsdk_handle_release(handle_);
+		_gnsdk_internal::manager_release();
+	}
+
+	handle_ = handle;
+
+	return *this;
+}
+#endif
+
 GnObject::~GnObject()
 {
 	if (GNSDK_NULL != handle_)
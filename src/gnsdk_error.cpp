@@ -184,3 +184,48 @@ GnError::SourceErrorModule() const
 
 
 
+
+
+/******************************************************************************
+** gn_result_base
+*/
+gn_result_base::gn_result_base(gnsdk_error_t error) :
+	error_code_(error), source_error_code_(error)
+{
+	if (error)
+	{
+		const gnsdk_error_info_t* pErrorInfo = gnsdk_manager_error_info();
+
+		if (pErrorInfo && (pErrorInfo->error_code == error))
+		{
+			source_error_code_ = pErrorInfo->source_error_code;
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Error
+ */
+GnError
+gn_result_base::Error() const
+{
+	const gnsdk_error_info_t* pErrorInfo;
+	gnsdk_error_info_t        errorInfo;
+
+	/* the thread's error info still describes this failure unless another call has been made */
+	pErrorInfo = gnsdk_manager_error_info();
+	if (error_code_ && pErrorInfo && (pErrorInfo->error_code == error_code_) && (pErrorInfo->source_error_code == source_error_code_))
+	{
+		return GnError();
+	}
+
+	errorInfo.error_code          = error_code_;
+	errorInfo.source_error_code   = source_error_code_;
+	errorInfo.error_description   = GNSDK_NULL;
+	errorInfo.error_module        = GNSDK_NULL;
+	errorInfo.error_api           = GNSDK_NULL;
+	errorInfo.source_error_module = GNSDK_NULL;
+
+	return GnError(&errorInfo);
+}
@@ -125,6 +125,38 @@ GnLinkOptions::NetworkInterface(gnsdk_cstr_t ipAddress) throw (GnError)
 	if (error) { throw GnError(); }
 }
 
+/*-----------------------------------------------------------------------------
+ *  Profile
+ */
+
+/* Link option keys, indexed by GnQueryProfile::gn_option */
+static const gnsdk_cstr_t s_profile_keys[GnQueryProfile::kOptionCount] =
+{
+	GNSDK_LINK_OPTION_LOOKUP_MODE,        /* kOptionLookupMode */
+	GNSDK_NULL,                           /* kOptionContentData */
+	GNSDK_NULL,                           /* kOptionClassicalData */
+	GNSDK_NULL,                           /* kOptionSonicData */
+	GNSDK_NULL,                           /* kOptionPlaylist */
+	GNSDK_NULL,                           /* kOptionExternalIds */
+	GNSDK_NULL,                           /* kOptionGlobalIds */
+	GNSDK_NULL,                           /* kOptionAdditionalCredits */
+	GNSDK_NULL,                           /* kOptionPreferredLanguage */
+	GNSDK_NULL,                           /* kOptionPreferredExternalId */
+	GNSDK_NULL,                           /* kOptionPreferCoverart */
+	GNSDK_NULL,                           /* kOptionResultSingle */
+	GNSDK_NULL,                           /* kOptionRevisionCheck */
+	GNSDK_NULL,                           /* kOptionResultRangeStart */
+	GNSDK_NULL,                           /* kOptionResultRangeSize */
+	GNSDK_QUERY_OPTION_NETWORK_INTERFACE  /* kOptionNetworkInterface */
+};
+
+void
+GnLinkOptions::Profile(const GnQueryProfile& profile) throw (GnError)
+{
+	profile.apply(weakhandle_, gnsdk_link_query_option_set, s_profile_keys);
+}
+
+
 /*-----------------------------------------------------------------------------
  *  ClearOptions
  */
@@ -232,6 +264,22 @@ GnLink::GnLink(const GnListElement& listElement, const GnUser& user, IGnStatusEv
 	 options_.weakhandle_ = query_handle;
 }
 
+GnLink::GnLink(const GnUser& user, IGnStatusEvents* pEventHandler)  throw (GnError) :
+	eventhandler_(pEventHandler), cancelled_(false)
+{
+	gnsdk_link_query_handle_t	query_handle = GNSDK_NULL;
+	gnsdk_error_t				error;
+
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_LINK);
+
+	error = gnsdk_link_query_create(user.native(), _CallbackStatus, this, &query_handle);
+	if (error) { throw GnError(); }
+
+	this->AcceptOwnership(query_handle);
+
+	options_.weakhandle_ = query_handle;
+}
+
 
 GnLink::~GnLink()
 {
@@ -547,6 +595,32 @@ GnLink::Count(GnLinkContentType contentType) throw (GnError)
 }
 
 
+/*-----------------------------------------------------------------------------
+ *  Input
+ */
+void
+GnLink::Input(const GnDataObject& gnDataObject) throw (GnError)
+{
+	gnsdk_error_t error;
+
+	error = gnsdk_link_query_set_gdo(get<gnsdk_link_query_handle_t>(), gnDataObject.native());
+	if (error) { throw GnError(); }
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Input
+ */
+void
+GnLink::Input(const GnListElement& listElement) throw (GnError)
+{
+	gnsdk_error_t error;
+
+	error = gnsdk_link_query_set_list_element(get<gnsdk_link_query_handle_t>(), listElement.native());
+	if (error) { throw GnError(); }
+}
+
+
 /*-----------------------------------------------------------------------------
  *  GnLinkContent
  */
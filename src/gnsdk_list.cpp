@@ -24,219 +24,105 @@ _list_status_callback(void* callback_data, gnsdk_status_t status, gnsdk_uint32_t
 static GnListType
 _convertListTypeCCpp( gnsdk_cstr_t c_list_type )
 {
-	GnListType listType = kListTypeLanguages;
-
-	if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_LANGUAGES ) == 0 )
-	{
-		listType = kListTypeLanguages;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_SCRIPTS ) == 0 )
-	{
-		listType = kListTypeScripts;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_GENRES ) == 0 )
-	{
-		listType = kListTypeGenres;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_ORIGINS ) == 0 )
-	{
-		listType = kListTypeOrigins;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_ERAS ) == 0 )
-	{
-		listType = kListTypeEras;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_ARTISTTYPES ) == 0 )
-	{
-		listType = kListTypeArtistTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_ROLES ) == 0 )
-	{
-		listType = kListTypeRoles;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_GENRES_VIDEO ) == 0 )
-	{
-		listType = kListTypeGenreVideos;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_RATINGS ) == 0 )
-	{
-		listType = kListTypeRatings;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_RATINGTYPES ) == 0 )
-	{
-		listType = kListTypeRatingTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_CONTRIBUTORS ) == 0 )
-	{
-		listType = kListTypeContributors;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_FEATURETYPES ) == 0 )
-	{
-		listType = kListTypeFeatureTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOREGIONS ) == 0 )
-	{
-		listType = kListTypeVideoRegions;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOTYPES ) == 0 )
-	{
-		listType = kListTypeVideoTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_MEDIATYPES ) == 0 )
-	{
-		listType = kListTypeMediaTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSERIALTYPES ) == 0 )
-	{
-		listType = kListTypeVideoSerialTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_WORKTYPES ) == 0 )
-	{
-		listType = kListTypeWorkTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_MEDIASPACES ) == 0 )
-	{
-		listType = kListTypeMediaSpaces;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_MOODS ) == 0 )
-	{
-		listType = kListTypeMoods;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_TEMPOS ) == 0 )
-	{
-		listType = kListTypeTempos;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_COMPOSITION_FORM ) == 0 )
-	{
-		listType = kListTypeCompostionForm;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_INSTRUMENTATION ) == 0 )
-	{
-		listType = kListTypeInstrumentation;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSTORYTYPE ) == 0 )
-	{
-		listType = kListTypeVideoStoryType;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOAUDIENCE ) == 0 )
-	{
-		listType = kListTypeVideoAudience;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOMOOD ) == 0 )
-	{
-		listType = kListTypeVideoMood;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOREPUTATION ) == 0 )
-	{
-		listType = kListTypeVideoReputation;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSCENARIO ) == 0 )
-	{
-		listType = kListTypeVideoScenario;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSETTINGENV ) == 0 )
-	{
-		listType = kListTypeVideoSettingEnv;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSETTINGPERIOD ) == 0 )
-	{
-		listType = kListTypeVideoSettingPeriod;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSOURCE ) == 0 )
-	{
-		listType = kListTypeVideoSource;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOSTYLE ) == 0 )
-	{
-		listType = kListTypeVideoStyle;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_VIDEOTOPIC ) == 0 )
-	{
-		listType = kListTypeVideoTopic;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGVIEWINGTYPES ) == 0 )
-	{
-		listType = kListTypeEpgViewingTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGAUDIOTYPES ) == 0 )
-	{
-		listType = kListTypeEpgAudioTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGVIDEOTYPES ) == 0 )
-	{
-		listType = kListTypeEpgVideoTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGCAPTIONTYPES ) == 0 )
-	{
-		listType = kListTypeEpgCaptionTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_IPGCATEGORIES_L1 ) == 0 )
-	{
-		listType = kListTypeIpgCategoriesL1;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_IPGCATEGORIES_L2 ) == 0 )
-	{
-		listType = kListTypeIpgCategoriesL2;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGPRODUCTIONTYPES ) == 0 )
-	{
-		listType = kListTypeEpgProductionTypes;
-	}
-	else if ( gnstd::gn_strcmp( c_list_type, GNSDK_LIST_TYPE_EPGDEVICETYPES ) == 0 )
-	{
-		listType = kListTypeEpgDeviceTypes;
-	}
-
-	return listType;
+	static const gn_convert_entry listTypes[] =
+	{
+		{ GNSDK_LIST_TYPE_ARTISTTYPES,        kListTypeArtistTypes },
+		{ GNSDK_LIST_TYPE_COMPOSITION_FORM,   kListTypeCompostionForm },
+		{ GNSDK_LIST_TYPE_CONTRIBUTORS,       kListTypeContributors },
+		{ GNSDK_LIST_TYPE_EPGAUDIOTYPES,      kListTypeEpgAudioTypes },
+		{ GNSDK_LIST_TYPE_EPGCAPTIONTYPES,    kListTypeEpgCaptionTypes },
+		{ GNSDK_LIST_TYPE_EPGDEVICETYPES,     kListTypeEpgDeviceTypes },
+		{ GNSDK_LIST_TYPE_EPGPRODUCTIONTYPES, kListTypeEpgProductionTypes },
+		{ GNSDK_LIST_TYPE_EPGVIDEOTYPES,      kListTypeEpgVideoTypes },
+		{ GNSDK_LIST_TYPE_EPGVIEWINGTYPES,    kListTypeEpgViewingTypes },
+		{ GNSDK_LIST_TYPE_ERAS,               kListTypeEras },
+		{ GNSDK_LIST_TYPE_FEATURETYPES,       kListTypeFeatureTypes },
+		{ GNSDK_LIST_TYPE_GENRES,             kListTypeGenres },
+		{ GNSDK_LIST_TYPE_GENRES_VIDEO,       kListTypeGenreVideos },
+		{ GNSDK_LIST_TYPE_INSTRUMENTATION,    kListTypeInstrumentation },
+		{ GNSDK_LIST_TYPE_IPGCATEGORIES_L1,   kListTypeIpgCategoriesL1 },
+		{ GNSDK_LIST_TYPE_IPGCATEGORIES_L2,   kListTypeIpgCategoriesL2 },
+		{ GNSDK_LIST_TYPE_LANGUAGES,          kListTypeLanguages },
+		{ GNSDK_LIST_TYPE_MEDIASPACES,        kListTypeMediaSpaces },
+		{ GNSDK_LIST_TYPE_MEDIATYPES,         kListTypeMediaTypes },
+		{ GNSDK_LIST_TYPE_MOODS,              kListTypeMoods },
+		{ GNSDK_LIST_TYPE_ORIGINS,            kListTypeOrigins },
+		{ GNSDK_LIST_TYPE_RATINGS,            kListTypeRatings },
+		{ GNSDK_LIST_TYPE_RATINGTYPES,        kListTypeRatingTypes },
+		{ GNSDK_LIST_TYPE_ROLES,              kListTypeRoles },
+		{ GNSDK_LIST_TYPE_SCRIPTS,            kListTypeScripts },
+		{ GNSDK_LIST_TYPE_TEMPOS,             kListTypeTempos },
+		{ GNSDK_LIST_TYPE_VIDEOAUDIENCE,      kListTypeVideoAudience },
+		{ GNSDK_LIST_TYPE_VIDEOMOOD,          kListTypeVideoMood },
+		{ GNSDK_LIST_TYPE_VIDEOREGIONS,       kListTypeVideoRegions },
+		{ GNSDK_LIST_TYPE_VIDEOREPUTATION,    kListTypeVideoReputation },
+		{ GNSDK_LIST_TYPE_VIDEOSCENARIO,      kListTypeVideoScenario },
+		{ GNSDK_LIST_TYPE_VIDEOSERIALTYPES,   kListTypeVideoSerialTypes },
+		{ GNSDK_LIST_TYPE_VIDEOSETTINGENV,    kListTypeVideoSettingEnv },
+		{ GNSDK_LIST_TYPE_VIDEOSETTINGPERIOD, kListTypeVideoSettingPeriod },
+		{ GNSDK_LIST_TYPE_VIDEOSOURCE,        kListTypeVideoSource },
+		{ GNSDK_LIST_TYPE_VIDEOSTORYTYPE,     kListTypeVideoStoryType },
+		{ GNSDK_LIST_TYPE_VIDEOSTYLE,         kListTypeVideoStyle },
+		{ GNSDK_LIST_TYPE_VIDEOTOPIC,         kListTypeVideoTopic },
+		{ GNSDK_LIST_TYPE_VIDEOTYPES,         kListTypeVideoTypes },
+		{ GNSDK_LIST_TYPE_WORKTYPES,          kListTypeWorkTypes }
+	};
+
+	return (GnListType)gnconvert::_lookup( listTypes, GN_CONVERT_COUNT(listTypes), c_list_type, kListTypeLanguages );
 }
 
 static gnsdk_cstr_t
 _convertListTypeCppC( GnListType descriptor )
 {
-	switch ( descriptor )
-	{
-	case kListTypeArtistTypes:        return GNSDK_LIST_TYPE_ARTISTTYPES;
-	case kListTypeCompostionForm:     return GNSDK_LIST_TYPE_COMPOSITION_FORM;
-	case kListTypeContributors:       return GNSDK_LIST_TYPE_CONTRIBUTORS;
-	case kListTypeEpgAudioTypes:      return GNSDK_LIST_TYPE_EPGAUDIOTYPES;
-	case kListTypeEpgCaptionTypes:    return GNSDK_LIST_TYPE_EPGCAPTIONTYPES;
-	case kListTypeEpgDeviceTypes:     return GNSDK_LIST_TYPE_EPGDEVICETYPES;
-	case kListTypeEpgProductionTypes: return GNSDK_LIST_TYPE_EPGPRODUCTIONTYPES;
-	case kListTypeEpgVideoTypes:      return GNSDK_LIST_TYPE_EPGVIDEOTYPES;
-	case kListTypeEpgViewingTypes:    return GNSDK_LIST_TYPE_EPGVIEWINGTYPES;
-	case kListTypeEras:               return GNSDK_LIST_TYPE_ERAS;
-	case kListTypeFeatureTypes:       return GNSDK_LIST_TYPE_FEATURETYPES;
-	case kListTypeGenres:             return GNSDK_LIST_TYPE_GENRES;
-	case kListTypeGenreVideos:        return GNSDK_LIST_TYPE_GENRES_VIDEO;
-	case kListTypeInstrumentation:    return GNSDK_LIST_TYPE_INSTRUMENTATION;
-	case kListTypeIpgCategoriesL1:    return GNSDK_LIST_TYPE_IPGCATEGORIES_L1;
-	case kListTypeIpgCategoriesL2:    return GNSDK_LIST_TYPE_IPGCATEGORIES_L2;
-	case kListTypeLanguages:          return GNSDK_LIST_TYPE_LANGUAGES;
-	case kListTypeScripts:            return GNSDK_LIST_TYPE_SCRIPTS;
-	case kListTypeMediaSpaces:        return GNSDK_LIST_TYPE_MEDIASPACES;
-	case kListTypeMediaTypes:         return GNSDK_LIST_TYPE_MEDIATYPES;
-	case kListTypeMoods:              return GNSDK_LIST_TYPE_MOODS;
-	case kListTypeOrigins:            return GNSDK_LIST_TYPE_ORIGINS;
-	case kListTypeRatings:            return GNSDK_LIST_TYPE_RATINGS;
-	case kListTypeRatingTypes:        return GNSDK_LIST_TYPE_RATINGTYPES;
-	case kListTypeRoles:              return GNSDK_LIST_TYPE_ROLES;
-	case kListTypeTempos:             return GNSDK_LIST_TYPE_TEMPOS;
-	case kListTypeVideoAudience:      return GNSDK_LIST_TYPE_VIDEOAUDIENCE;
-	case kListTypeVideoMood:          return GNSDK_LIST_TYPE_VIDEOMOOD;
-	case kListTypeVideoRegions:       return GNSDK_LIST_TYPE_VIDEOREGIONS;
-	case kListTypeVideoReputation:    return GNSDK_LIST_TYPE_VIDEOREPUTATION;
-	case kListTypeVideoScenario:      return GNSDK_LIST_TYPE_VIDEOSCENARIO;
-	case kListTypeVideoSerialTypes:   return GNSDK_LIST_TYPE_VIDEOSERIALTYPES;
-	case kListTypeVideoSettingEnv:    return GNSDK_LIST_TYPE_VIDEOSETTINGENV;
-	case kListTypeVideoSettingPeriod: return GNSDK_LIST_TYPE_VIDEOSETTINGPERIOD;
-	case kListTypeVideoSource:        return GNSDK_LIST_TYPE_VIDEOSOURCE;
-	case kListTypeVideoStoryType:     return GNSDK_LIST_TYPE_VIDEOSTORYTYPE;
-	case kListTypeVideoStyle:         return GNSDK_LIST_TYPE_VIDEOSTYLE;
-	case kListTypeVideoTopic:         return GNSDK_LIST_TYPE_VIDEOTOPIC;
-	case kListTypeVideoTypes:         return GNSDK_LIST_TYPE_VIDEOTYPES;
-	case kListTypeWorkTypes:          return GNSDK_LIST_TYPE_WORKTYPES;
-	case kListTypeInvalid:
-		break;
+	/* indexed by GnListType */
+	static const gnsdk_cstr_t listTypes[] =
+	{
+		GNSDK_NULL,                         /* kListTypeInvalid */
+		GNSDK_LIST_TYPE_LANGUAGES,          /* kListTypeLanguages */
+		GNSDK_LIST_TYPE_SCRIPTS,            /* kListTypeScripts */
+		GNSDK_LIST_TYPE_GENRES,             /* kListTypeGenres */
+		GNSDK_LIST_TYPE_ORIGINS,            /* kListTypeOrigins */
+		GNSDK_LIST_TYPE_ERAS,               /* kListTypeEras */
+		GNSDK_LIST_TYPE_ARTISTTYPES,        /* kListTypeArtistTypes */
+		GNSDK_LIST_TYPE_ROLES,              /* kListTypeRoles */
+		GNSDK_LIST_TYPE_GENRES_VIDEO,       /* kListTypeGenreVideos */
+		GNSDK_LIST_TYPE_RATINGS,            /* kListTypeRatings */
+		GNSDK_LIST_TYPE_RATINGTYPES,        /* kListTypeRatingTypes */
+		GNSDK_LIST_TYPE_CONTRIBUTORS,       /* kListTypeContributors */
+		GNSDK_LIST_TYPE_FEATURETYPES,       /* kListTypeFeatureTypes */
+		GNSDK_LIST_TYPE_VIDEOREGIONS,       /* kListTypeVideoRegions */
+		GNSDK_LIST_TYPE_VIDEOTYPES,         /* kListTypeVideoTypes */
+		GNSDK_LIST_TYPE_MEDIATYPES,         /* kListTypeMediaTypes */
+		GNSDK_LIST_TYPE_VIDEOSERIALTYPES,   /* kListTypeVideoSerialTypes */
+		GNSDK_LIST_TYPE_WORKTYPES,          /* kListTypeWorkTypes */
+		GNSDK_LIST_TYPE_MEDIASPACES,        /* kListTypeMediaSpaces */
+		GNSDK_LIST_TYPE_MOODS,              /* kListTypeMoods */
+		GNSDK_LIST_TYPE_TEMPOS,             /* kListTypeTempos */
+		GNSDK_LIST_TYPE_COMPOSITION_FORM,   /* kListTypeCompostionForm */
+		GNSDK_LIST_TYPE_INSTRUMENTATION,    /* kListTypeInstrumentation */
+		GNSDK_LIST_TYPE_VIDEOSTORYTYPE,     /* kListTypeVideoStoryType */
+		GNSDK_LIST_TYPE_VIDEOAUDIENCE,      /* kListTypeVideoAudience */
+		GNSDK_LIST_TYPE_VIDEOMOOD,          /* kListTypeVideoMood */
+		GNSDK_LIST_TYPE_VIDEOREPUTATION,    /* kListTypeVideoReputation */
+		GNSDK_LIST_TYPE_VIDEOSCENARIO,      /* kListTypeVideoScenario */
+		GNSDK_LIST_TYPE_VIDEOSETTINGENV,    /* kListTypeVideoSettingEnv */
+		GNSDK_LIST_TYPE_VIDEOSETTINGPERIOD, /* kListTypeVideoSettingPeriod */
+		GNSDK_LIST_TYPE_VIDEOSOURCE,        /* kListTypeVideoSource */
+		GNSDK_LIST_TYPE_VIDEOSTYLE,         /* kListTypeVideoStyle */
+		GNSDK_LIST_TYPE_VIDEOTOPIC,         /* kListTypeVideoTopic */
+		GNSDK_LIST_TYPE_EPGVIEWINGTYPES,    /* kListTypeEpgViewingTypes */
+		GNSDK_LIST_TYPE_EPGAUDIOTYPES,      /* kListTypeEpgAudioTypes */
+		GNSDK_LIST_TYPE_EPGVIDEOTYPES,      /* kListTypeEpgVideoTypes */
+		GNSDK_LIST_TYPE_EPGCAPTIONTYPES,    /* kListTypeEpgCaptionTypes */
+		GNSDK_LIST_TYPE_IPGCATEGORIES_L1,   /* kListTypeIpgCategoriesL1 */
+		GNSDK_LIST_TYPE_IPGCATEGORIES_L2,   /* kListTypeIpgCategoriesL2 */
+		GNSDK_LIST_TYPE_EPGPRODUCTIONTYPES, /* kListTypeEpgProductionTypes */
+		GNSDK_LIST_TYPE_EPGDEVICETYPES      /* kListTypeEpgDeviceTypes */
+	};
+
+	if ( (gnsdk_uint32_t)descriptor < GN_CONVERT_COUNT(listTypes) )
+	{
+		return listTypes[descriptor];
 	}
 
 	return GNSDK_NULL;
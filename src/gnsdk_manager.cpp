@@ -16,6 +16,7 @@
 #include "gnsdk_manager.hpp"
 #include "gnsdk_list.hpp"
 #include "gnsdk_convert.hpp"
+#include "gnsdk_thread.hpp"
 
 using namespace gracenote;
 
@@ -37,9 +38,17 @@ manager_init_dec(void);
 
 /* static private vars */
 static gnsdk_manager_handle_t sManagerHandle = GNSDK_NULL;
-static gnsdk_uint32_t         sModulesInit   = 0;
+static gn_atomic_uint32       sModulesInit;
 static bool                   sInitialized   = false;
 
+/* constructed on first use, so queries created by other static initializers find it ready */
+static gn_mutex&
+_modules_lock()
+{
+	static gn_mutex lock;
+	return lock;
+}
+
 
 /******************************************************************************
 ** GnManager
@@ -251,6 +260,26 @@ GnManager::TestGracenoteConnection(const GnUser& user) throw (GnError)
 }
 
 
+/*-----------------------------------------------------------------------------
+ *  Preload
+ */
+gnsdk_uint32_t
+GnManager::Preload(gnsdk_uint32_t moduleMask) throw (GnError)
+{
+	gnsdk_uint32_t module_id;
+
+	for (module_id = 1; module_id && (module_id <= moduleMask); module_id <<= 1)
+	{
+		if (moduleMask & module_id)
+		{
+			_gnsdk_internal::module_initialize(module_id);
+		}
+	}
+
+	return _gnsdk_internal::modules_initialized() & moduleMask;
+}
+
+
 /******************************************************************************
  *  GnStoreOps
  */
@@ -345,208 +374,216 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 {
 	gnsdk_error_t error;
 
+	/* called by every query constructor, once warmed up this load is all it costs */
+	if (sModulesInit.load() & moduleId)
+	{
+		return;
+	}
+
+	gn_lock lock(_modules_lock());
+
 	switch (moduleId)
 	{
 #if GNSDK_MUSICID
 	case GNSDK_MODULE_MUSICID:
-		if (!( sModulesInit & GNSDK_MODULE_MUSICID ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_MUSICID ) )
 		{
 			error = gnsdk_musicid_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_MUSICID;
+			sModulesInit.fetch_or(GNSDK_MODULE_MUSICID);
 		}
 		break;
 #endif
 
 #if GNSDK_DSP
 	case GNSDK_MODULE_DSP:
-		if (!( sModulesInit & GNSDK_MODULE_DSP ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_DSP ) )
 		{
 			error = gnsdk_dsp_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_DSP;
+			sModulesInit.fetch_or(GNSDK_MODULE_DSP);
 		}
 		break;
 #endif
 
 #if GNSDK_MUSICID_FILE
 	case GNSDK_MODULE_MUSICIDFILE:
-		if (!( sModulesInit & GNSDK_MODULE_MUSICIDFILE ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_MUSICIDFILE ) )
 		{
 			error = gnsdk_musicidfile_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_MUSICIDFILE;
+			sModulesInit.fetch_or(GNSDK_MODULE_MUSICIDFILE);
 		}
 		break;
 #endif
 
 #if GNSDK_MUSICID_STREAM
 	case GNSDK_MODULE_MUSICIDSTREAM:
-		if (!( sModulesInit & GNSDK_MODULE_MUSICIDSTREAM ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_MUSICIDSTREAM ) )
 		{
 			error = gnsdk_musicidstream_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_MUSICIDSTREAM;
+			sModulesInit.fetch_or(GNSDK_MODULE_MUSICIDSTREAM);
 		}
 		break;
 #endif
 
 #if GNSDK_LINK
 	case GNSDK_MODULE_LINK:
-		if (!( sModulesInit & GNSDK_MODULE_LINK ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_LINK ) )
 		{
 			error = gnsdk_link_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_LINK;
+			sModulesInit.fetch_or(GNSDK_MODULE_LINK);
 		}
 		break;
 #endif
 
 #if GNSDK_MUSICID_MATCH
 	case GNSDK_MODULE_MUSICIDMATCH:
-		if (!( sModulesInit & GNSDK_MODULE_MUSICIDMATCH ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_MUSICIDMATCH ) )
 		{
 			error = gnsdk_musicidmatch_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_MUSICIDMATCH;
+			sModulesInit.fetch_or(GNSDK_MODULE_MUSICIDMATCH);
 		}
 		break;
 #endif
 
 #if GNSDK_STORAGE_SQLITE
 	case GNSDK_MODULE_STORAGE_SQLITE:
-		if (!( sModulesInit & GNSDK_MODULE_STORAGE_SQLITE ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_STORAGE_SQLITE ) )
 		{
 			error = gnsdk_storage_sqlite_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_STORAGE_SQLITE;
+			sModulesInit.fetch_or(GNSDK_MODULE_STORAGE_SQLITE);
 		}
 		break;
 #endif
 
 #if GNSDK_STORAGE_QNX
 	case GNSDK_MODULE_STORAGE_QNX:
-		if (!( sModulesInit & GNSDK_MODULE_STORAGE_QNX) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_STORAGE_QNX ) )
 		{
 			error = gnsdk_storage_qnx_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_STORAGE_QNX;
+			sModulesInit.fetch_or(GNSDK_MODULE_STORAGE_QNX);
 		}
 		break;
 #endif
 
 #if GNSDK_LOOKUP_LOCAL
 	case GNSDK_MODULE_LOOKUP_LOCAL:
-		if (!( sModulesInit & GNSDK_MODULE_LOOKUP_LOCAL ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_LOOKUP_LOCAL ) )
 		{
 			error = gnsdk_lookup_local_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_LOOKUP_LOCAL;
+			sModulesInit.fetch_or(GNSDK_MODULE_LOOKUP_LOCAL);
 		}
 		break;
 #endif
 
 #if GNSDK_LOOKUP_FPLOCAL
 	case GNSDK_MODULE_LOOKUP_FPLOCAL:
-		if (!( sModulesInit & GNSDK_MODULE_LOOKUP_FPLOCAL ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_LOOKUP_FPLOCAL ) )
 		{
 			error = gnsdk_lookup_fplocal_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_LOOKUP_FPLOCAL;
+			sModulesInit.fetch_or(GNSDK_MODULE_LOOKUP_FPLOCAL);
 		}
 		break;
 #endif
 
 #if GNSDK_LOOKUP_LOCALSTREAM
 	case GNSDK_MODULE_LOOKUP_LOCALSTREAM:
-		if (!( sModulesInit & GNSDK_MODULE_LOOKUP_LOCALSTREAM ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_LOOKUP_LOCALSTREAM ) )
 		{
 			error = gnsdk_lookup_localstream_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_LOOKUP_LOCALSTREAM;
+			sModulesInit.fetch_or(GNSDK_MODULE_LOOKUP_LOCALSTREAM);
 		}
 		break;
 #endif
 
 #if GNSDK_SUBMIT
 	case GNSDK_MODULE_SUBMIT:
-		if (!( sModulesInit & GNSDK_MODULE_SUBMIT ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_SUBMIT ) )
 		{
 			error = gnsdk_submit_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_SUBMIT;
+			sModulesInit.fetch_or(GNSDK_MODULE_SUBMIT);
 		}
 		break;
 #endif
 
 #if GNSDK_VIDEO
 	case GNSDK_MODULE_VIDEO:
-		if (!( sModulesInit & GNSDK_MODULE_VIDEO ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_VIDEO ) )
 		{
 			error = gnsdk_video_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_VIDEO;
+			sModulesInit.fetch_or(GNSDK_MODULE_VIDEO);
 		}
 		break;
 #endif
 
 #if GNSDK_PLAYLIST
 	case GNSDK_MODULE_PLAYLIST:
-		if (!( sModulesInit & GNSDK_MODULE_PLAYLIST ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_PLAYLIST ) )
 		{
 			error = gnsdk_playlist_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_PLAYLIST;
+			sModulesInit.fetch_or(GNSDK_MODULE_PLAYLIST);
 		}
 		break;
 #endif
 
 #if GNSDK_MOODGRID
 	case GNSDK_MODULE_MOODGRID:
-		if (!( sModulesInit & GNSDK_MODULE_MOODGRID ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_MOODGRID ) )
 		{
 			error = gnsdk_moodgrid_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_MOODGRID;
+			sModulesInit.fetch_or(GNSDK_MODULE_MOODGRID);
 		}
 		break;
 #endif
 
 #if GNSDK_ACR
 	case GNSDK_MODULE_ACR:
-		if (!( sModulesInit & GNSDK_MODULE_ACR ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_ACR ) )
 		{
 			error = gnsdk_acr_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_ACR;
+			sModulesInit.fetch_or(GNSDK_MODULE_ACR);
 		}
 		break;
 #endif
 
 #if GNSDK_CORRELATES
 	case GNSDK_MODULE_CORRELATES:
-		if (!( sModulesInit & GNSDK_MODULE_CORRELATES ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_CORRELATES ) )
 		{
 			error = gnsdk_correlates_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
 
-			sModulesInit |= GNSDK_MODULE_CORRELATES;
+			sModulesInit.fetch_or(GNSDK_MODULE_CORRELATES);
 		}
 		break;
 
@@ -554,11 +591,11 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 
 #if GNSDK_EPG
 	case GNSDK_MODULE_EPG:
-		if (!( sModulesInit & GNSDK_MODULE_EPG ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_EPG ) )
 		{
 			error = gnsdk_epg_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
-			sModulesInit |= GNSDK_MODULE_EPG;
+			sModulesInit.fetch_or(GNSDK_MODULE_EPG);
 		}
 		break;
 
@@ -566,11 +603,11 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 
 #if GNSDK_TASTEPROFILE
 	case GNSDK_MODULE_TASTEPROFILE:
-		if (!( sModulesInit & GNSDK_MODULE_TASTEPROFILE ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_TASTEPROFILE ) )
 		{
 			error = gnsdk_tasteprofile_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
-			sModulesInit |= GNSDK_MODULE_TASTEPROFILE;
+			sModulesInit.fetch_or(GNSDK_MODULE_TASTEPROFILE);
 		}
 		break;
 
@@ -578,11 +615,11 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 
 /*#if GNSDK_TASTE
 	case GNSDK_MODULE_TASTE:
-		if (!( sModulesInit & GNSDK_MODULE_TASTE ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_TASTE ) )
 		{
 			error = gnsdk_taste_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
-			sModulesInit |= GNSDK_MODULE_TASTE;
+			sModulesInit.fetch_or(GNSDK_MODULE_TASTE);
 		}
 		break;
 
@@ -590,11 +627,11 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 
 #if GNSDK_RHYTHM
 	case GNSDK_MODULE_RHYTHM:
-		if (!( sModulesInit & GNSDK_MODULE_RHYTHM ) )
+		if (!( sModulesInit.load() & GNSDK_MODULE_RHYTHM ) )
 		{
 			error = gnsdk_rhythm_initialize(sManagerHandle);
 			if (error) { throw GnError(); }
-			sModulesInit |= GNSDK_MODULE_RHYTHM;
+			sModulesInit.fetch_or(GNSDK_MODULE_RHYTHM);
 		}
 		break;
 
@@ -605,6 +642,12 @@ _gnsdk_internal::module_initialize(gnsdk_uint32_t moduleId) throw (GnError)
 	}
 }
 
+gnsdk_uint32_t
+_gnsdk_internal::modules_initialized()
+{
+	return sModulesInit.load();
+}
+
 bool
 _gnsdk_internal::manager_initialized()
 {
@@ -626,7 +669,9 @@ _gnsdk_internal::manager_release()
 	if (init_count == 0)
 	{
 		/* manager is shutdown */
-		sModulesInit = 0;
+		gn_lock lock(_modules_lock());
+
+		sModulesInit.store(0);
 		sInitialized = false;
 	}
 }
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_metadata.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "metadata.hpp"
+
+using namespace gracenote;
+using namespace gracenote::metadata;
+
+
+/* parent index of nodes and fields read directly from the extracted object */
+#define FIELDSET_ROOT		GN_UINT32_MAX
+
+/* Child lookup shared by all fields below it */
+struct GnFieldSet::node
+{
+	gnsdk_str_t		key;
+	gnsdk_uint32_t	ordinal;
+	gnsdk_uint32_t	parent;
+};
+
+/* Value read from the object or one of its child lookups */
+struct GnFieldSet::field
+{
+	gnsdk_str_t		key;
+	gnsdk_uint32_t	ordinal;
+	gnsdk_uint32_t	node;
+};
+
+
+static gnsdk_str_t
+_fieldset_key_copy(gnsdk_cstr_t key, gnsdk_size_t keyLen)
+{
+	gnsdk_str_t copy = new char[keyLen + 1];
+
+	for (gnsdk_size_t i = 0; i < keyLen; i++)
+	{
+		copy[i] = key[i];
+	}
+	copy[keyLen] = 0;
+
+	return copy;
+}
+
+static bool
+_fieldset_key_equal(gnsdk_cstr_t key, gnsdk_cstr_t segment, gnsdk_size_t segmentLen)
+{
+	gnsdk_size_t i;
+
+	for (i = 0; i < segmentLen; i++)
+	{
+		if (key[i] != segment[i])
+		{
+			return false;
+		}
+	}
+
+	return (0 == key[i]);
+}
+
+/* Splits "key#ordinal" at the start of a path, returns the position after the segment */
+static gnsdk_cstr_t
+_fieldset_segment(gnsdk_cstr_t path, gnsdk_size_t* pKeyLen, gnsdk_uint32_t* pOrdinal) throw (GnError)
+{
+	gnsdk_cstr_t p = path;
+
+	while (*p && ('/' != *p) && ('#' != *p))
+	{
+		p++;
+	}
+	*pKeyLen  = (gnsdk_size_t)(p - path);
+	*pOrdinal = 1;
+
+	if ('#' == *p)
+	{
+		*pOrdinal = 0;
+		for (p++; ('0' <= *p) && (*p <= '9'); p++)
+		{
+			*pOrdinal = (*pOrdinal * 10) + (gnsdk_uint32_t)(*p - '0');
+		}
+	}
+
+	if ((0 == *pKeyLen) || (0 == *pOrdinal) || (*p && ('/' != *p)))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Invalid field path");
+	}
+
+	return p;
+}
+
+
+/******************************************************************************
+** GnFieldSet
+*/
+GnFieldSet::GnFieldSet() :
+	nodes_(GNSDK_NULL),
+	node_count_(0),
+	node_capacity_(0),
+	fields_(GNSDK_NULL),
+	field_count_(0),
+	field_capacity_(0)
+{
+}
+
+GnFieldSet::~GnFieldSet()
+{
+	gnsdk_uint32_t i;
+
+	for (i = 0; i < node_count_; i++)
+	{
+		delete [] nodes_[i].key;
+	}
+	for (i = 0; i < field_count_; i++)
+	{
+		delete [] fields_[i].key;
+	}
+
+	delete [] nodes_;
+	delete [] fields_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Add
+ */
+gnsdk_uint32_t
+GnFieldSet::Add(gnsdk_cstr_t path) throw (GnError)
+{
+	gnsdk_uint32_t	parent = FIELDSET_ROOT;
+	gnsdk_cstr_t	segment;
+	gnsdk_cstr_t	next;
+	gnsdk_size_t	key_len;
+	gnsdk_uint32_t	ordinal;
+
+	if ((GNSDK_NULL == path) || (0 == *path))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Invalid field path");
+	}
+
+	/* validate the whole path before adding lookups for it */
+	for (segment = path; *segment; segment = *next ? next + 1 : next)
+	{
+		next = _fieldset_segment(segment, &key_len, &ordinal);
+		if (('/' == *next) && (0 == next[1]))
+		{
+			throw GnError(GNSDKERR_InvalidArg, "Invalid field path");
+		}
+	}
+
+	for (segment = path; ; segment = next + 1)
+	{
+		next = _fieldset_segment(segment, &key_len, &ordinal);
+		if (0 == *next)
+		{
+			break;
+		}
+		parent = _node(parent, segment, key_len, ordinal);
+	}
+
+	if (field_count_ == field_capacity_)
+	{
+		gnsdk_uint32_t	capacity = field_capacity_ ? field_capacity_ * 2 : 16;
+		field*			fields   = new field[capacity];
+
+		for (gnsdk_uint32_t i = 0; i < field_count_; i++)
+		{
+			fields[i] = fields_[i];
+		}
+		delete [] fields_;
+
+		fields_         = fields;
+		field_capacity_ = capacity;
+	}
+
+	fields_[field_count_].key     = _fieldset_key_copy(segment, key_len);
+	fields_[field_count_].ordinal = ordinal;
+	fields_[field_count_].node    = parent;
+
+	return field_count_++;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _node
+ */
+gnsdk_uint32_t
+GnFieldSet::_node(gnsdk_uint32_t parent, gnsdk_cstr_t key, gnsdk_size_t keyLen, gnsdk_uint32_t ordinal)
+{
+	gnsdk_uint32_t i;
+
+	for (i = 0; i < node_count_; i++)
+	{
+		if ((nodes_[i].parent == parent) && (nodes_[i].ordinal == ordinal) && _fieldset_key_equal(nodes_[i].key, key, keyLen))
+		{
+			return i;
+		}
+	}
+
+	if (node_count_ == node_capacity_)
+	{
+		gnsdk_uint32_t	capacity = node_capacity_ ? node_capacity_ * 2 : 8;
+		node*			nodes    = new node[capacity];
+
+		for (i = 0; i < node_count_; i++)
+		{
+			nodes[i] = nodes_[i];
+		}
+		delete [] nodes_;
+
+		nodes_         = nodes;
+		node_capacity_ = capacity;
+	}
+
+	/* parents are always added before their children, so one forward pass resolves all lookups */
+	nodes_[node_count_].key     = _fieldset_key_copy(key, keyLen);
+	nodes_[node_count_].ordinal = ordinal;
+	nodes_[node_count_].parent  = parent;
+
+	return node_count_++;
+}
+
+
+/******************************************************************************
+** GnFieldRecord
+*/
+GnFieldRecord::GnFieldRecord() :
+	values_(GNSDK_NULL),
+	value_count_(0),
+	value_capacity_(0),
+	handles_(GNSDK_NULL),
+	handle_count_(0),
+	handle_capacity_(0)
+{
+}
+
+GnFieldRecord::~GnFieldRecord()
+{
+	Clear();
+
+	delete [] values_;
+	delete [] handles_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Value
+ */
+gnsdk_cstr_t
+GnFieldRecord::Value(gnsdk_uint32_t fieldIndex) const
+{
+	if ((fieldIndex < value_count_) && values_[fieldIndex])
+	{
+		return values_[fieldIndex];
+	}
+
+	return gnstd::kEmptyString;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Has
+ */
+bool
+GnFieldRecord::Has(gnsdk_uint32_t fieldIndex) const
+{
+	return (fieldIndex < value_count_) && (GNSDK_NULL != values_[fieldIndex]);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Clear
+ */
+void
+GnFieldRecord::Clear()
+{
+	for (gnsdk_uint32_t i = 0; i < handle_count_; i++)
+	{
+		if (handles_[i])
+		{
+			gnsdk_manager_gdo_release(handles_[i]);
+		}
+	}
+
+	handle_count_ = 0;
+	value_count_  = 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _reserve
+ */
+void
+GnFieldRecord::_reserve(gnsdk_uint32_t valueCount, gnsdk_uint32_t handleCount)
+{
+	if (value_capacity_ < valueCount)
+	{
+		delete [] values_;
+		values_         = new gnsdk_cstr_t[valueCount];
+		value_capacity_ = valueCount;
+	}
+
+	if (handle_capacity_ < handleCount)
+	{
+		delete [] handles_;
+		handles_         = new gnsdk_gdo_handle_t[handleCount];
+		handle_capacity_ = handleCount;
+	}
+}
+
+
+/******************************************************************************
+** GnDataObject
+*/
+
+/*-----------------------------------------------------------------------------
+ *  Extract
+ */
+void
+GnDataObject::Extract(const GnFieldSet& fieldSet, GnFieldRecord& record) const throw (GnError)
+{
+	gnsdk_gdo_handle_t	root = get<gnsdk_gdo_handle_t>();
+	gnsdk_gdo_handle_t	parent;
+	gnsdk_gdo_handle_t	h_child;
+	gnsdk_cstr_t		value;
+	gnsdk_error_t		error;
+	gnsdk_uint32_t		i;
+
+	record.Clear();
+	record._reserve(fieldSet.field_count_, fieldSet.node_count_);
+
+	for (i = 0; i < fieldSet.node_count_; i++)
+	{
+		const GnFieldSet::node& n = fieldSet.nodes_[i];
+
+		parent  = (FIELDSET_ROOT == n.parent) ? root : record.handles_[n.parent];
+		h_child = GNSDK_NULL;
+
+		if (parent)
+		{
+			error = gnsdk_manager_gdo_child_get(parent, n.key, n.ordinal, &h_child);
+			if (error)
+			{
+				/* a missing child leaves its fields empty, anything else is a failure */
+				if (GNSDKERR_ERROR_CODE(error) != GNSDKERR_NotFound) { throw GnError(); }
+
+				h_child = GNSDK_NULL;
+			}
+		}
+
+		/* counted as they are taken, so a later throw still lets the record release them */
+		record.handles_[i]   = h_child;
+		record.handle_count_ = i + 1;
+	}
+
+	for (i = 0; i < fieldSet.field_count_; i++)
+	{
+		const GnFieldSet::field& f = fieldSet.fields_[i];
+
+		parent = (FIELDSET_ROOT == f.node) ? root : record.handles_[f.node];
+		value  = GNSDK_NULL;
+
+		if (parent)
+		{
+			error = gnsdk_manager_gdo_value_get(parent, f.key, f.ordinal, &value);
+			if (error)
+			{
+				if (GNSDKERR_ERROR_CODE(error) != GNSDKERR_NotFound) { throw GnError(); }
+
+				value = GNSDK_NULL;
+			}
+		}
+
+		record.values_[i] = value;
+	}
+	record.value_count_ = fieldSet.field_count_;
+}
@@ -18,6 +18,7 @@
 #if GNSDK_MUSICID
 
 #include "gnsdk_musicid.hpp"
+#include "gnsdk_audiobuffer.hpp"
 #include "metadata_music.hpp"
 
 using namespace gracenote;
@@ -25,12 +26,25 @@ using namespace gracenote::musicid;
 using namespace gracenote::metadata;
 
 
+/* default duration of audio written per call by FingerprintFromSource */
+#define MUSICID_CHUNK_DURATION_MS	1000
 
-static metadata::GnResponseAlbums
-_intFindAlbums(gnsdk_musicid_query_handle_t handle) throw (GnError);
+/* worker threads and queue capacity of the executor running FindAlbumsAsync and FindMatchesAsync */
+#ifndef GNWRAPPER_MUSICID_ASYNC_THREADS
+#define GNWRAPPER_MUSICID_ASYNC_THREADS		8
+#endif
+#ifndef GNWRAPPER_MUSICID_ASYNC_QUEUE
+#define GNWRAPPER_MUSICID_ASYNC_QUEUE		64
+#endif
 
-static void
-_intSetText(gnsdk_musicid_query_handle_t handle, gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName ) throw (GnError);
+static gnsdk_error_t
+_intFindAlbums(gnsdk_musicid_query_handle_t handle, metadata::GnResponseAlbums& response) throw (GnError);
+
+static gnsdk_error_t
+_intFindMatches(gnsdk_musicid_query_handle_t handle, metadata::GnResponseDataMatches& response) throw (GnError);
+
+static gnsdk_error_t
+_intSetText(gnsdk_musicid_query_handle_t handle, gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName );
 
 static gnsdk_cstr_t
 _MapfPTypeCStr(GnFingerprintType fpType);
@@ -148,6 +162,38 @@ GnMusicIdOptions::NetworkInterface(gnsdk_cstr_t ipAddress) throw (GnError)
 	if (error) { throw GnError(); }
 }
 
+/*-----------------------------------------------------------------------------
+ *  Profile
+ */
+
+/* MusicID option keys, indexed by GnQueryProfile::gn_option */
+static const gnsdk_cstr_t s_profile_keys[GnQueryProfile::kOptionCount] =
+{
+	GNSDK_MUSICID_OPTION_LOOKUP_MODE,            /* kOptionLookupMode */
+	GNSDK_MUSICID_OPTION_ENABLE_CONTENT_DATA,    /* kOptionContentData */
+	GNSDK_MUSICID_OPTION_ENABLE_CLASSICAL_DATA,  /* kOptionClassicalData */
+	GNSDK_MUSICID_OPTION_ENABLE_SONIC_DATA,      /* kOptionSonicData */
+	GNSDK_MUSICID_OPTION_ENABLE_PLAYLIST,        /* kOptionPlaylist */
+	GNSDK_MUSICID_OPTION_ENABLE_EXTERNAL_IDS,    /* kOptionExternalIds */
+	GNSDK_MUSICID_OPTION_ENABLE_GLOBALIDS,       /* kOptionGlobalIds */
+	GNSDK_MUSICID_OPTION_ADDITIONAL_CREDITS,     /* kOptionAdditionalCredits */
+	GNSDK_MUSICID_OPTION_PREFERRED_LANG,         /* kOptionPreferredLanguage */
+	GNSDK_MUSICID_OPTION_RESULT_PREFER_XID,      /* kOptionPreferredExternalId */
+	GNSDK_MUSICID_OPTION_RESULT_PREFER_COVERART, /* kOptionPreferCoverart */
+	GNSDK_MUSICID_OPTION_RESULT_SINGLE,          /* kOptionResultSingle */
+	GNSDK_MUSICID_OPTION_REVISION_CHECK,         /* kOptionRevisionCheck */
+	GNSDK_MUSICID_OPTION_RESULT_RANGE_START,     /* kOptionResultRangeStart */
+	GNSDK_MUSICID_OPTION_RESULT_RANGE_SIZE,      /* kOptionResultRangeSize */
+	GNSDK_QUERY_OPTION_NETWORK_INTERFACE         /* kOptionNetworkInterface */
+};
+
+void
+GnMusicIdOptions::Profile(const GnQueryProfile& profile) throw (GnError)
+{
+	profile.apply(weakhandle_, gnsdk_musicid_query_option_set, s_profile_keys);
+}
+
+
 
 /*-----------------------------------------------------------------------------
  *  OptionCustom
@@ -439,7 +485,6 @@ GnMusicId::FingerprintEnd() throw (GnError)
 void
 GnMusicId::FingerprintFromSource(IGnAudioSource& audioSource, GnFingerprintType fpType) throw (GnError)
 {
-	gnsdk_byte_t  audio_buffer[1024];
 	gnsdk_size_t  audioData_size;
 	gnsdk_bool_t  b_complete;
 	gnsdk_error_t error;
@@ -462,11 +507,14 @@ GnMusicId::FingerprintFromSource(IGnAudioSource& audioSource, GnFingerprintType
 	error = gnsdk_musicid_query_fingerprint_begin(get<gnsdk_musicid_query_handle_t>(), _MapfPTypeCStr(fpType), audioSource.SamplesPerSecond(), audioSource.SampleSizeInBits(), audioSource.NumberOfChannels() );
 	if (!error)
 	{
+		gn_audio_reader		audio_reader(audioSource, gn_audio_reader::chunk_size(audioSource, options_.chunk_duration_ms_ ? options_.chunk_duration_ms_ : MUSICID_CHUNK_DURATION_MS));
+		const gnsdk_byte_t*	audio_data;
+
 		b_complete = GNSDK_FALSE;
 
-		while (0 < ( audioData_size = audioSource.GetData(audio_buffer, sizeof( audio_buffer ) ) ) )
+		while (0 < ( audioData_size = audio_reader.read(&audio_data) ) )
 		{
-			error = gnsdk_musicid_query_fingerprint_write(get<gnsdk_musicid_query_handle_t>(), audio_buffer, audioData_size, &b_complete);
+			error = gnsdk_musicid_query_fingerprint_write(get<gnsdk_musicid_query_handle_t>(), audio_data, audioData_size, &b_complete);
 			if (error)
 			{
 				break;
@@ -496,11 +544,7 @@ GnMusicId::FingerprintFromSource(IGnAudioSource& audioSource, GnFingerprintType
 GnResponseAlbums
 GnMusicId::FindAlbums(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
 {
-	cancelled_ = false;
-
-	_intSetText(get<gnsdk_musicid_query_handle_t>(), albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
-
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+	return TryFindAlbums(albumTitle, trackTitle, albumArtistName, trackArtistName, composerName).Value();
 }
 
 
@@ -511,14 +555,27 @@ GnResponseAlbums
 GnMusicId::FindAlbums(gnsdk_cstr_t strCDTOC)
 throw (GnError)
 {
-	gnsdk_error_t error;
+	return TryFindAlbums(strCDTOC).Value();
+}
 
-	cancelled_ = false;
 
-	error = gnsdk_musicid_query_set_toc_string(get<gnsdk_musicid_query_handle_t>(), strCDTOC);
-	if (error) { throw GnError(); }
+/*-----------------------------------------------------------------------------
+ *  FindAlbums
+ */
+GnResponseAlbums
+GnMusicId::FindAlbums(gnsdk_cstr_t strCDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+{
+	return TryFindAlbums(strCDTOC, strFingerprintData, fpType).Value();
+}
+
 
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+/*-----------------------------------------------------------------------------
+ *  FindAlbums
+ */
+GnResponseAlbums
+GnMusicId::FindAlbums(gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+{
+	return TryFindAlbums(strFingerprintData, fpType).Value();
 }
 
 
@@ -526,157 +583,630 @@ throw (GnError)
  *  FindAlbums
  */
 GnResponseAlbums
-GnMusicId::FindAlbums(gnsdk_cstr_t strCDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+GnMusicId::FindAlbums(const GnDataObject& gnObj) throw (GnError)
 {
-	gnsdk_error_t error;
+	return TryFindAlbums(gnObj).Value();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbums
+ */
+GnResponseAlbums
+GnMusicId::FindAlbums(IGnAudioSource& audioSource, GnFingerprintType fpType) throw (GnError)
+{
+	GnResponseAlbums response;
 
 	cancelled_ = false;
 
-	error = gnsdk_musicid_query_set_toc_string(get<gnsdk_musicid_query_handle_t>(), strCDTOC);
-	if (error) { throw GnError(); }
+	FingerprintFromSource(audioSource, fpType);
 
-	error = gnsdk_musicid_query_set_fp_data(get<gnsdk_musicid_query_handle_t>(), strFingerprintData, _MapfPTypeCStr(fpType) );
-	if (error) { throw GnError(); }
+	if (_intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response)) { throw GnError(); }
 
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+	return response;
 }
 
 
+
+
 /*-----------------------------------------------------------------------------
- *  FindAlbums
+ *  FindMatches
  */
-GnResponseAlbums
-GnMusicId::FindAlbums(gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+GnResponseDataMatches
+GnMusicId::FindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
 {
-	gnsdk_error_t error;
+	return TryFindMatches(albumTitle, trackTitle, albumArtistName, trackArtistName, composerName).Value();
+}
 
+
+/*-----------------------------------------------------------------------------
+ *  TryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::TryFindAlbums(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
+{
 	cancelled_ = false;
 
-	error = gnsdk_musicid_query_set_fp_data(get<gnsdk_musicid_query_handle_t>(), strFingerprintData, _MapfPTypeCStr(fpType) );
-	if (error) { throw GnError(); }
+	return _tryFindAlbums(albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  TryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::TryFindAlbums(gnsdk_cstr_t strCDTOC) throw (GnError)
+{
+	cancelled_ = false;
 
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+	return _tryFindAlbums(strCDTOC);
 }
 
 
 /*-----------------------------------------------------------------------------
- *  FindAlbums
+ *  TryFindAlbums
  */
-GnResponseAlbums
-GnMusicId::FindAlbums(const GnDataObject& gnObj) throw (GnError)
+GnResult<GnResponseAlbums>
+GnMusicId::TryFindAlbums(gnsdk_cstr_t strCDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
 {
-	gnsdk_error_t error;
+	cancelled_ = false;
+
+	return _tryFindAlbums(strCDTOC, strFingerprintData, fpType);
+}
 
+
+/*-----------------------------------------------------------------------------
+ *  TryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::TryFindAlbums(gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+{
 	cancelled_ = false;
 
-	error = gnsdk_musicid_query_set_gdo(get<gnsdk_musicid_query_handle_t>(), gnObj.native() );
-	if (error) { throw GnError(); }
+	return _tryFindAlbums(strFingerprintData, fpType);
+}
+
 
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+/*-----------------------------------------------------------------------------
+ *  TryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::TryFindAlbums(const GnDataObject& gnObj) throw (GnError)
+{
+	cancelled_ = false;
+
+	return _tryFindAlbums(gnObj);
 }
 
 
 /*-----------------------------------------------------------------------------
- *  FindAlbums
+ *  TryFindMatches
  */
-GnResponseAlbums
-GnMusicId::FindAlbums(IGnAudioSource& audioSource, GnFingerprintType fpType) throw (GnError)
+GnResult<GnResponseDataMatches>
+GnMusicId::TryFindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
 {
 	cancelled_ = false;
 
-	FingerprintFromSource(audioSource, fpType);
+	return _tryFindMatches(albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
+}
+
 
-	return _intFindAlbums(get<gnsdk_musicid_query_handle_t>());
+/*-----------------------------------------------------------------------------
+ *  _tryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::_tryFindAlbums(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
+{
+	GnResponseAlbums response;
+	gnsdk_error_t    error;
+
+	error = _intSetText(get<gnsdk_musicid_query_handle_t>(), albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
+	if (!error)
+	{
+		error = _intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response);
+	}
+
+	return GnResult<GnResponseAlbums>(error, response);
 }
 
 
+/*-----------------------------------------------------------------------------
+ *  _tryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::_tryFindAlbums(gnsdk_cstr_t strCDTOC) throw (GnError)
+{
+	GnResponseAlbums response;
+	gnsdk_error_t    error;
+
+	error = gnsdk_musicid_query_set_toc_string(get<gnsdk_musicid_query_handle_t>(), strCDTOC);
+	if (!error)
+	{
+		error = _intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response);
+	}
+
+	return GnResult<GnResponseAlbums>(error, response);
+}
 
 
 /*-----------------------------------------------------------------------------
- *  FindMatches
+ *  _tryFindAlbums
  */
-GnResponseDataMatches
-GnMusicId::FindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
+GnResult<GnResponseAlbums>
+GnMusicId::_tryFindAlbums(gnsdk_cstr_t strCDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
 {
+	GnResponseAlbums response;
+	gnsdk_error_t    error;
 
-	gnsdk_gdo_handle_t response_gdo;
+	error = gnsdk_musicid_query_set_toc_string(get<gnsdk_musicid_query_handle_t>(), strCDTOC);
+	if (!error)
+	{
+		error = gnsdk_musicid_query_set_fp_data(get<gnsdk_musicid_query_handle_t>(), strFingerprintData, _MapfPTypeCStr(fpType) );
+	}
+	if (!error)
+	{
+		error = _intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response);
+	}
 
-	cancelled_ = false;
+	return GnResult<GnResponseAlbums>(error, response);
+}
 
-	_intSetText(get<gnsdk_musicid_query_handle_t>(), albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
 
-	gnsdk_error_t error = gnsdk_musicid_query_find_matches(get<gnsdk_musicid_query_handle_t>(), &response_gdo);
-	if (error) { throw GnError(); }
+/*-----------------------------------------------------------------------------
+ *  _tryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::_tryFindAlbums(gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType) throw (GnError)
+{
+	GnResponseAlbums response;
+	gnsdk_error_t    error;
+
+	error = gnsdk_musicid_query_set_fp_data(get<gnsdk_musicid_query_handle_t>(), strFingerprintData, _MapfPTypeCStr(fpType) );
+	if (!error)
+	{
+		error = _intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response);
+	}
 
-	GnResponseDataMatches result(response_gdo);
+	return GnResult<GnResponseAlbums>(error, response);
+}
 
-	error = gnsdk_manager_gdo_release(response_gdo);
-	if (error) { throw GnError(); }
 
-	return result;
+/*-----------------------------------------------------------------------------
+ *  _tryFindAlbums
+ */
+GnResult<GnResponseAlbums>
+GnMusicId::_tryFindAlbums(const GnDataObject& gnObj) throw (GnError)
+{
+	GnResponseAlbums response;
+	gnsdk_error_t    error;
+
+	error = gnsdk_musicid_query_set_gdo(get<gnsdk_musicid_query_handle_t>(), gnObj.native() );
+	if (!error)
+	{
+		error = _intFindAlbums(get<gnsdk_musicid_query_handle_t>(), response);
+	}
+
+	return GnResult<GnResponseAlbums>(error, response);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _tryFindMatches
+ */
+GnResult<GnResponseDataMatches>
+GnMusicId::_tryFindMatches(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName) throw (GnError)
+{
+	GnResponseDataMatches response;
+	gnsdk_error_t         error;
+
+	error = _intSetText(get<gnsdk_musicid_query_handle_t>(), albumTitle, trackTitle, albumArtistName, trackArtistName, composerName);
+	if (!error)
+	{
+		error = _intFindMatches(get<gnsdk_musicid_query_handle_t>(), response);
+	}
+
+	return GnResult<GnResponseDataMatches>(error, response);
+}
+
+
+/******************************************************************************
+** GnMusicId asynchronous finds
+*/
+
+/* Inputs of an asynchronous find, strings are interned copies */
+struct musicid_async_input
+{
+	enum kind
+	{
+		kText,
+		kTOC,
+		kTOCFingerprint,
+		kFingerprint,
+		kDataObject
+	};
+
+	musicid_async_input(kind k) : type(k), fptype(kFingerprintTypeFile)
+	{
+		for (gnsdk_uint32_t i = 0; i < 5; i++)
+		{
+			str[i] = GNSDK_NULL;
+		}
+	}
+
+	~musicid_async_input()
+	{
+		for (gnsdk_uint32_t i = 0; i < 5; i++)
+		{
+			gn_string_table::release(str[i]);
+		}
+	}
+
+	/* null inputs stay null, intern would make them empty */
+	void
+	set(gnsdk_uint32_t i, gnsdk_cstr_t value)
+	{
+		str[i] = value ? gn_string_table::intern(value) : GNSDK_NULL;
+	}
+
+	kind				type;
+	gnsdk_cstr_t		str[5];
+	GnFingerprintType	fptype;
+	GnDataObject		gdo;
+};
+
+
+namespace gracenote
+{
+namespace musicid
+{
+
+/* Finds of the async tasks, these keep the cancel state so a cancel applied by running() is not lost */
+struct musicid_async_find
+{
+	static GnResult<GnResponseAlbums>
+	find(GnMusicId& query, const musicid_async_input& in, GnResponseAlbums*) throw (GnError)
+	{
+		switch (in.type)
+		{
+			case musicid_async_input::kTOC:
+				return query._tryFindAlbums(in.str[0]);
+
+			case musicid_async_input::kTOCFingerprint:
+				return query._tryFindAlbums(in.str[0], in.str[1], in.fptype);
+
+			case musicid_async_input::kFingerprint:
+				return query._tryFindAlbums(in.str[0], in.fptype);
+
+			case musicid_async_input::kDataObject:
+				return query._tryFindAlbums(in.gdo);
+
+			default:
+				return query._tryFindAlbums(in.str[0], in.str[1], in.str[2], in.str[3], in.str[4]);
+		}
+	}
+
+	static GnResult<GnResponseDataMatches>
+	find(GnMusicId& query, const musicid_async_input& in, GnResponseDataMatches*) throw (GnError)
+	{
+		return query._tryFindMatches(in.str[0], in.str[1], in.str[2], in.str[3], in.str[4]);
+	}
+};
+
+} /* namespace musicid */
+} /* namespace gracenote */
+
+
+/* Runs one find on the executor, cancelling the future cancels the query */
+template<typename R>
+class musicid_async_task : public gn_task, public IGnCancellable
+{
+public:
+	musicid_async_task(GnMusicId& query, musicid_async_input* input, gn_future_state<R>* state) :
+		query_(query), input_(input), state_(state), ran_(false)
+	{
+		state_->retain();
+	}
+
+	/* a task deleted without running, e.g. by a shut down executor, reports an abort */
+	~musicid_async_task()
+	{
+		if (!ran_)
+		{
+			state_->fail(GnError(GNSDKERR_Aborted, "MusicID async find was not run"));
+		}
+		state_->release();
+		delete input_;
+	}
+
+	virtual void
+	run()
+	{
+		ran_ = true;
+
+		if (state_->cancelled())
+		{
+			state_->fail(GnError(GNSDKERR_Aborted, "MusicID async find cancelled"));
+			return;
+		}
+
+		try
+		{
+			/* reset before running() so a cancel it applies stays set for the find */
+			query_.SetCancel(false);
+			state_->running(this);
+
+			GnResult<R> result = musicid_async_find::find(query_, *input_, (R*)GNSDK_NULL);
+
+			state_->running(GNSDK_NULL);
+
+			/* a cancel just before the find started is not seen by the query */
+			if (state_->cancelled())
+			{
+				state_->fail(GnError(GNSDKERR_Aborted, "MusicID async find cancelled"));
+			}
+			else if (result.IsOk())
+			{
+				state_->complete(result.Value());
+			}
+			else
+			{
+				state_->fail(result.Error());
+			}
+		}
+		catch (GnError& e)
+		{
+			state_->running(GNSDK_NULL);
+			state_->fail(e);
+		}
+		catch (...)
+		{
+			state_->running(GNSDK_NULL);
+			state_->fail(GnError(GNSDKERR_Unknown, "MusicID async find failed"));
+		}
+	}
+
+	virtual void
+	SetCancel(bool bCancel) { query_.SetCancel(bCancel); }
+
+	virtual bool
+	IsCancelled() { return query_.IsCancelled(); }
+
+private:
+	GnMusicId&				query_;
+	musicid_async_input*	input_;
+	gn_future_state<R>*		state_;
+	bool					ran_;
+
+	DISALLOW_COPY_AND_ASSIGN(musicid_async_task);
+};
+
+
+/* Executor shared by all GnMusicId objects. Created on first use and intentionally never
+ * destroyed, its workers may be inside GNSDK while the process exits. */
+static gn_thread_pool*	s_async_pool = GNSDK_NULL;
+
+/* constructed on first use, so queries started by other static initializers find it ready */
+static gn_mutex&
+_asyncMutex()
+{
+	static gn_mutex lock;
+	return lock;
+}
+
+static gn_thread_pool&
+_asyncPool() throw (GnError)
+{
+	gn_lock lock(_asyncMutex());
+
+	if (GNSDK_NULL == s_async_pool)
+	{
+		s_async_pool = new gn_thread_pool(GNWRAPPER_MUSICID_ASYNC_THREADS, GNWRAPPER_MUSICID_ASYNC_QUEUE);
+	}
+	return *s_async_pool;
+}
+
+template<typename R>
+static GnFuture<R>
+_asyncPost(GnMusicId& query, musicid_async_input* input, IGnAsyncEvents<R>* pEventHandler) throw (GnError)
+{
+	gn_future_state<R>*	state;
+	gn_thread_pool*		pool;
+
+	try
+	{
+		pool = &_asyncPool();
+	}
+	catch (GnError&)
+	{
+		delete input;
+		throw;
+	}
+
+	state = new gn_future_state<R>(pEventHandler);
+
+	GnFuture<R> future(state);
+
+	state->release();
+
+	/* blocks while the queue is full, a rejected task reports an abort when deleted */
+	pool->post(new musicid_async_task<R>(query, input, state));
+
+	return future;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbumsAsync
+ */
+GnFuture<GnResponseAlbums>
+GnMusicId::FindAlbumsAsync(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName,
+						   IGnAsyncEvents<GnResponseAlbums>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kText);
+
+	input->set(0, albumTitle);
+	input->set(1, trackTitle);
+	input->set(2, albumArtistName);
+	input->set(3, trackArtistName);
+	input->set(4, composerName);
+
+	return _asyncPost(*this, input, pEventHandler);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbumsAsync
+ */
+GnFuture<GnResponseAlbums>
+GnMusicId::FindAlbumsAsync(gnsdk_cstr_t strCDTOC, IGnAsyncEvents<GnResponseAlbums>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kTOC);
+
+	input->set(0, strCDTOC);
+
+	return _asyncPost(*this, input, pEventHandler);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbumsAsync
+ */
+GnFuture<GnResponseAlbums>
+GnMusicId::FindAlbumsAsync(gnsdk_cstr_t strCDTOC, gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType,
+						   IGnAsyncEvents<GnResponseAlbums>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kTOCFingerprint);
+
+	input->set(0, strCDTOC);
+	input->set(1, strFingerprintData);
+	input->fptype = fpType;
+
+	return _asyncPost(*this, input, pEventHandler);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbumsAsync
+ */
+GnFuture<GnResponseAlbums>
+GnMusicId::FindAlbumsAsync(gnsdk_cstr_t strFingerprintData, GnFingerprintType fpType, IGnAsyncEvents<GnResponseAlbums>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kFingerprint);
+
+	input->set(0, strFingerprintData);
+	input->fptype = fpType;
 
+	return _asyncPost(*this, input, pEventHandler);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindAlbumsAsync
+ */
+GnFuture<GnResponseAlbums>
+GnMusicId::FindAlbumsAsync(const GnDataObject& gnObj, IGnAsyncEvents<GnResponseAlbums>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kDataObject);
+
+	input->gdo = gnObj;
+
+	return _asyncPost(*this, input, pEventHandler);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  FindMatchesAsync
+ */
+GnFuture<GnResponseDataMatches>
+GnMusicId::FindMatchesAsync(gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName,
+							IGnAsyncEvents<GnResponseDataMatches>* pEventHandler) throw (GnError)
+{
+	musicid_async_input* input = new musicid_async_input(musicid_async_input::kText);
+
+	input->set(0, albumTitle);
+	input->set(1, trackTitle);
+	input->set(2, albumArtistName);
+	input->set(3, trackArtistName);
+	input->set(4, composerName);
+
+	return _asyncPost(*this, input, pEventHandler);
 }
 
 
 /*-----------------------------------------------------------------------------
  *  _intFindAlbums
  */
-GnResponseAlbums
-_intFindAlbums(gnsdk_musicid_query_handle_t handle) throw (GnError)
+gnsdk_error_t
+_intFindAlbums(gnsdk_musicid_query_handle_t handle, GnResponseAlbums& response) throw (GnError)
 {
 	gnsdk_gdo_handle_t response_gdo;
 	gnsdk_error_t      error;
 	
 	error = gnsdk_musicid_query_find_albums(handle, &response_gdo);
-	if (error) { throw GnError(); }
+	if (error) { return error; }
 	
-	GnResponseAlbums tmp = GnResponseAlbums(response_gdo);
-	
-	error = gnsdk_manager_gdo_release(response_gdo);
-	if (error) { throw GnError(); }
+	response = GnResponseAlbums(response_gdo);
 	
-	return tmp;
+	return gnsdk_manager_gdo_release(response_gdo);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _intFindMatches
+ */
+gnsdk_error_t
+_intFindMatches(gnsdk_musicid_query_handle_t handle, GnResponseDataMatches& response) throw (GnError)
+{
+	gnsdk_gdo_handle_t response_gdo;
+	gnsdk_error_t      error;
+
+	error = gnsdk_musicid_query_find_matches(handle, &response_gdo);
+	if (error) { return error; }
+
+	response = GnResponseDataMatches(response_gdo);
+
+	return gnsdk_manager_gdo_release(response_gdo);
 }
 
 
 /*-----------------------------------------------------------------------------
  *  _intSetText
  */
-void
-_intSetText(gnsdk_musicid_query_handle_t handle, gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName ) throw (GnError)
+gnsdk_error_t
+_intSetText(gnsdk_musicid_query_handle_t handle, gnsdk_cstr_t albumTitle, gnsdk_cstr_t trackTitle, gnsdk_cstr_t albumArtistName, gnsdk_cstr_t trackArtistName, gnsdk_cstr_t composerName )
 {
 	gnsdk_error_t error = MIDERR_NoError;
 
 	if (albumTitle)
 	{
 		error = gnsdk_musicid_query_set_text(handle, GNSDK_MUSICID_FIELD_ALBUM, albumTitle);
-		if (error) { throw GnError(); }
+		if (error) { return error; }
 	}
 
 	if (trackTitle)
 	{
 		error = gnsdk_musicid_query_set_text(handle, GNSDK_MUSICID_FIELD_TITLE, trackTitle);
-		if (error) { throw GnError(); }
+		if (error) { return error; }
 	}
 
 	if (albumArtistName)
 	{
 		error = gnsdk_musicid_query_set_text(handle, GNSDK_MUSICID_FIELD_ALBUM_ARTIST, albumArtistName);
-		if (error) { throw GnError(); }
+		if (error) { return error; }
 	}
 
 	if (trackArtistName)
 	{
 		error = gnsdk_musicid_query_set_text(handle, GNSDK_MUSICID_FIELD_TRACK_ARTIST, trackArtistName);
-		if (error) { throw GnError(); }
+		if (error) { return error; }
 	}
 
 	if (composerName)
 	{
 		error = gnsdk_musicid_query_set_text(handle, GNSDK_MUSICID_FIELD_COMPOSER, composerName);
-		if (error) { throw GnError(); }
 	}
 
+	return error;
 }
 
 
@@ -733,11 +1263,17 @@ _callback_status(void* callback_data, gnsdk_status_t mid_status, gnsdk_uint32_t
 			p_musicid->EventHandler()->StatusEvent((GnStatus)mid_status, percent_complete, bytes_total_sent, bytes_total_received, canceller);
 		}
 
-		if (canceller.IsCancelled() || p_musicid->IsCancelled())
+		if (canceller.IsCancelled())
 		{
 			*p_abort = GNSDK_TRUE;
 		}
 	}
+
+	/* SetCancel aborts queries with or without an event handler */
+	if (p_musicid->IsCancelled())
+	{
+		*p_abort = GNSDK_TRUE;
+	}
 }
 
 
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_musicidbatch.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+
+#if GNSDK_MUSICID
+
+#include "gnsdk_musicidbatch.hpp"
+
+using namespace gracenote;
+using namespace gracenote::metadata;
+using namespace gracenote::musicid;
+
+
+/******************************************************************************
+** GnMusicIdBatch internals
+*/
+
+/* One audio source travelling through the batch */
+class GnMusicIdBatch::item
+{
+public:
+	item(gnsdk_uint32_t index, IGnAudioSource& audioSource) :
+		index_(index), source_(audioSource) { }
+
+	gnsdk_uint32_t		index_;
+	IGnAudioSource&		source_;
+	GnString			fingerprint_;
+};
+
+
+/* Status delegate given to every batch query so Cancel can abort running queries */
+class GnMusicIdBatch::canceller : public IGnStatusEvents
+{
+public:
+	explicit
+	canceller(GnMusicIdBatch* pBatch) : batch_(pBatch) { }
+
+	void
+	StatusEvent(GnStatus status, gnsdk_uint32_t percentComplete, gnsdk_size_t bytesTotalSent, gnsdk_size_t bytesTotalReceived, IGnCancellable& cancellable)
+	{
+		GNSDK_UNUSED(status);
+		GNSDK_UNUSED(percentComplete);
+		GNSDK_UNUSED(bytesTotalSent);
+		GNSDK_UNUSED(bytesTotalReceived);
+
+		if (batch_->cancelled_.load())
+		{
+			cancellable.SetCancel(true);
+		}
+	}
+
+private:
+	GnMusicIdBatch*	batch_;
+};
+
+
+/* Owns a batch query, deleting it on any way out of scope */
+class batch_query
+{
+public:
+	explicit
+	batch_query(GnMusicId* pQuery) : query_(pQuery) { }
+
+	~batch_query() { delete query_; }
+
+	GnMusicId*
+	operator->() { return query_; }
+
+private:
+	GnMusicId*	query_;
+
+	DISALLOW_COPY_AND_ASSIGN(batch_query);
+};
+
+
+/* Second stage, look up the fingerprint generated by the first */
+class GnMusicIdBatch::lookup_task : public gn_task
+{
+public:
+	lookup_task(GnMusicIdBatch* pBatch, item* pItem) : batch_(pBatch), item_(pItem) { }
+
+	void
+	run()
+	{
+		if (batch_->cancelled_.load())
+		{
+			GnError error(GNSDKERR_Aborted, "Batch cancelled");
+			batch_->_report(item_, GNSDK_NULL, &error);
+			return;
+		}
+
+		try
+		{
+			/* the query is deleted once the result is constructed, before reporting */
+			GnResponseAlbums result = batch_query(batch_->_create_query())->FindAlbums(item_->fingerprint_, batch_->fptype_);
+
+			batch_->_report(item_, &result, GNSDK_NULL);
+		}
+		catch (GnError& error)
+		{
+			batch_->_report(item_, GNSDK_NULL, &error);
+		}
+		catch (...)
+		{
+			GnError error(GNSDKERR_Unknown, "Batch lookup failed");
+			batch_->_report(item_, GNSDK_NULL, &error);
+		}
+	}
+
+private:
+	GnMusicIdBatch*	batch_;
+	item*			item_;
+};
+
+
+/* First stage, decode and fingerprint the audio source then hand over to lookup */
+class GnMusicIdBatch::fingerprint_task : public gn_task
+{
+public:
+	fingerprint_task(GnMusicIdBatch* pBatch, item* pItem) : batch_(pBatch), item_(pItem) { }
+
+	void
+	run()
+	{
+		if (batch_->cancelled_.load())
+		{
+			GnError error(GNSDKERR_Aborted, "Batch cancelled");
+			batch_->_report(item_, GNSDK_NULL, &error);
+			return;
+		}
+
+		try
+		{
+			batch_query query(batch_->_create_query());
+
+			query->FingerprintFromSource(item_->source_, batch_->fptype_);
+			item_->fingerprint_ = query->FingerprintDataGet();
+		}
+		catch (GnError& error)
+		{
+			batch_->_report(item_, GNSDK_NULL, &error);
+			return;
+		}
+		catch (...)
+		{
+			GnError error(GNSDKERR_Unknown, "Batch fingerprinting failed");
+			batch_->_report(item_, GNSDK_NULL, &error);
+			return;
+		}
+
+		/* blocks while the lookup stage is full, which in turn throttles this stage */
+		batch_->lookup_pool_.post(new lookup_task(batch_, item_));
+	}
+
+private:
+	GnMusicIdBatch*	batch_;
+	item*			item_;
+};
+
+
+/******************************************************************************
+** GnMusicIdBatch
+*/
+GnMusicIdBatch::GnMusicIdBatch(const GnUser& user, IGnMusicIdBatchEvents* pEventHandler, GnFingerprintType fpType,
+							   gnsdk_uint32_t fingerprintThreads, gnsdk_uint32_t lookupThreads, gnsdk_uint32_t maxQueued) throw (GnError) :
+	user_(user),
+	has_locale_(false),
+	eventhandler_(pEventHandler),
+	fptype_(fpType),
+	canceller_(GNSDK_NULL),
+	next_index_(0),
+	pending_(0),
+	lookup_pool_(lookupThreads ? lookupThreads : 1, maxQueued),
+	fingerprint_pool_(fingerprintThreads, maxQueued)
+{
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_MUSICID);
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_DSP);
+
+	canceller_ = new canceller(this);
+}
+
+GnMusicIdBatch::GnMusicIdBatch(const GnUser& user, const GnLocale& locale, IGnMusicIdBatchEvents* pEventHandler, GnFingerprintType fpType,
+							   gnsdk_uint32_t fingerprintThreads, gnsdk_uint32_t lookupThreads, gnsdk_uint32_t maxQueued) throw (GnError) :
+	user_(user),
+	locale_(locale),
+	has_locale_(true),
+	eventhandler_(pEventHandler),
+	fptype_(fpType),
+	canceller_(GNSDK_NULL),
+	next_index_(0),
+	pending_(0),
+	lookup_pool_(lookupThreads ? lookupThreads : 1, maxQueued),
+	fingerprint_pool_(fingerprintThreads, maxQueued)
+{
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_MUSICID);
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_DSP);
+
+	canceller_ = new canceller(this);
+}
+
+GnMusicIdBatch::~GnMusicIdBatch()
+{
+	/* fingerprint tasks feed the lookup stage so it must drain first */
+	fingerprint_pool_.shutdown();
+	lookup_pool_.shutdown();
+
+	delete canceller_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Add
+ */
+gnsdk_uint32_t
+GnMusicIdBatch::Add(IGnAudioSource& audioSource) throw (GnError)
+{
+	item*          p_item;
+	gnsdk_uint32_t index;
+
+	{
+		gn_lock lock(mutex_);
+
+		index  = next_index_++;
+		p_item = new item(index, audioSource);
+		pending_ += 1;
+	}
+
+	/* the item may be reported and deleted by a worker as soon as it is posted */
+	if (!fingerprint_pool_.post(new fingerprint_task(this, p_item)))
+	{
+		GnError error(GNSDKERR_InvalidCall, "Batch is shutting down");
+		_report(p_item, GNSDK_NULL, &error);
+	}
+
+	return index;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  WaitForComplete
+ */
+bool
+GnMusicIdBatch::WaitForComplete(gnsdk_uint32_t timeout_ms)
+{
+	gn_lock        lock(mutex_);
+	gnsdk_uint64_t deadline = gn_thread::tick_ms() + timeout_ms;
+	gnsdk_uint64_t now;
+
+	while (pending_)
+	{
+		if (GN_UINT32_MAX == timeout_ms)
+		{
+			complete_cond_.wait(mutex_);
+			continue;
+		}
+
+		now = gn_thread::tick_ms();
+		if (now >= deadline)
+		{
+			return false;
+		}
+		complete_cond_.wait(mutex_, (gnsdk_uint32_t)(deadline - now));
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Cancel
+ */
+void
+GnMusicIdBatch::Cancel()
+{
+	cancelled_.store(1);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Pending
+ */
+gnsdk_uint32_t
+GnMusicIdBatch::Pending() const
+{
+	gn_lock lock(mutex_);
+
+	return pending_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _create_query
+ */
+GnMusicId*
+GnMusicIdBatch::_create_query()
+{
+	GnMusicId* p_query;
+
+	if (has_locale_)
+	{
+		p_query = new GnMusicId(user_, locale_, canceller_);
+	}
+	else
+	{
+		p_query = new GnMusicId(user_, canceller_);
+	}
+
+	if (eventhandler_)
+	{
+		try
+		{
+			eventhandler_->MusicIdBatchQueryPrepare(*p_query);
+		}
+		catch (...)
+		{
+			delete p_query;
+			throw;
+		}
+	}
+
+	return p_query;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _report
+ *  Deliver the outcome of an item and retire it.
+ */
+void
+GnMusicIdBatch::_report(item* p_item, GnResponseAlbums* p_result, GnError* p_error)
+{
+	if (eventhandler_)
+	{
+		/* a throwing delegate must not leave the item pending forever */
+		try
+		{
+			if (p_result)
+			{
+				eventhandler_->MusicIdBatchResult(p_item->index_, p_item->source_, *p_result);
+			}
+			else
+			{
+				eventhandler_->MusicIdBatchError(p_item->index_, p_item->source_, *p_error);
+			}
+		}
+		catch (...)
+		{
+		}
+	}
+
+	delete p_item;
+
+	gn_lock lock(mutex_);
+
+	pending_ -= 1;
+	if (0 == pending_)
+	{
+		complete_cond_.notify_all();
+	}
+}
+
+
+#endif /* GNSDK_MUSICID */
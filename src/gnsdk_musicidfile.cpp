@@ -18,12 +18,20 @@
 #if GNSDK_MUSICID_FILE
 
 #include "gnsdk_musicidfile.hpp"
+#include "gnsdk_musicidfileprefetch.hpp"
+#include "gnsdk_musicidfilecache.hpp"
+#include "gnsdk_audiobuffer.hpp"
 #include "metadata_music.hpp"
 
+#include <string.h>
+
 using namespace gracenote;
 using namespace gracenote::metadata;
 using namespace gracenote::musicid_file;
 
+/* default duration of audio written per call by GnMusicIdFileInfo::FingerprintFromSource */
+#define MUSICIDFILE_CHUNK_DURATION_MS	4000
+
 /**************************************************************************
 ** GnMusicIdFile
 */
@@ -164,6 +172,38 @@ GnMusicIdFileOptions::NetworkInterface(gnsdk_cstr_t ipAddress) throw (GnError)
 	if (error) { throw GnError(); }
 }
 
+/*-----------------------------------------------------------------------------
+ *  Profile
+ */
+
+/* MusicID-File option keys, indexed by GnQueryProfile::gn_option */
+static const gnsdk_cstr_t s_profile_keys[GnQueryProfile::kOptionCount] =
+{
+	GNSDK_MUSICIDFILE_OPTION_LOOKUP_MODE,           /* kOptionLookupMode */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_CONTENT_DATA,   /* kOptionContentData */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_CLASSICAL_DATA, /* kOptionClassicalData */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_SONIC_DATA,     /* kOptionSonicData */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_PLAYLIST,       /* kOptionPlaylist */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_EXTERNAL_IDS,   /* kOptionExternalIds */
+	GNSDK_MUSICIDFILE_OPTION_ENABLE_GLOBALIDS,      /* kOptionGlobalIds */
+	GNSDK_NULL,                                     /* kOptionAdditionalCredits */
+	GNSDK_MUSICIDFILE_OPTION_PREFERRED_LANG,        /* kOptionPreferredLanguage */
+	GNSDK_MUSICIDFILE_OPTION_PREFERRED_XID,         /* kOptionPreferredExternalId */
+	GNSDK_NULL,                                     /* kOptionPreferCoverart */
+	GNSDK_NULL,                                     /* kOptionResultSingle */
+	GNSDK_NULL,                                     /* kOptionRevisionCheck */
+	GNSDK_NULL,                                     /* kOptionResultRangeStart */
+	GNSDK_NULL,                                     /* kOptionResultRangeSize */
+	GNSDK_QUERY_OPTION_NETWORK_INTERFACE            /* kOptionNetworkInterface */
+};
+
+void
+GnMusicIdFileOptions::Profile(const GnQueryProfile& profile) throw (GnError)
+{
+	profile.apply(weakhandle_, gnsdk_musicidfile_query_option_set, s_profile_keys);
+}
+
+
 /*-----------------------------------------------------------------------------
  *  Custom
  */
@@ -361,6 +401,374 @@ GnMusicIdFileInfoManager::AddFromXml(gnsdk_cstr_t xmlStr) throw (GnError)
 	return count;
 }
 
+/*-----------------------------------------------------------------------------
+ *  RenderToStream
+ */
+
+/* A stream is a header then one record per file. A record is its size then fields, each a key index, the
+ * value size and the value with its terminator; a record size of 0 ends the stream. Sizes are 32 bit little
+ * endian. Keys are only ever appended, readers skip indexes they do not know.
+ */
+#define FILEINFO_STREAM_MAGIC			"GNFI"
+#define FILEINFO_STREAM_VERSION			1
+#define FILEINFO_STREAM_HEADER_SIZE		8
+#define FILEINFO_STREAM_FIELD_SIZE		5
+
+/* data is passed to the delegates in chunks of this size */
+#define FILEINFO_STREAM_CHUNK_SIZE		(64 * 1024)
+
+/* larger records are taken to be a corrupt stream */
+#define FILEINFO_STREAM_RECORD_MAX		(16 * 1024 * 1024)
+
+/* file info value keys, indexed by their index in the stream; the identifier comes first */
+static const gnsdk_cstr_t s_stream_keys[] =
+{
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_IDENT,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_FILENAME,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TAGID,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TUI,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TUI_TAG,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_CDDB_IDS,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_MUI,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_MEDIA_ID,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_ALBUMARTIST,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_ALBUMTITLE,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TRACKARTIST,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TRACKTITLE,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TRACKNUMBER,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_DISCNUMBER,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_FINGERPRINT,
+	GNSDK_MUSICIDFILE_FILEINFO_VALUE_TOC_OFFSETS
+};
+
+#define FILEINFO_STREAM_KEY_COUNT		(sizeof(s_stream_keys) / sizeof(s_stream_keys[0]))
+
+static void
+_stream_put_uint32(gnsdk_byte_t* p, gnsdk_uint32_t value)
+{
+	p[0] = (gnsdk_byte_t)(value);
+	p[1] = (gnsdk_byte_t)(value >> 8);
+	p[2] = (gnsdk_byte_t)(value >> 16);
+	p[3] = (gnsdk_byte_t)(value >> 24);
+}
+
+static gnsdk_uint32_t
+_stream_get_uint32(const gnsdk_byte_t* p)
+{
+	return (gnsdk_uint32_t)p[0] | ((gnsdk_uint32_t)p[1] << 8) | ((gnsdk_uint32_t)p[2] << 16) | ((gnsdk_uint32_t)p[3] << 24);
+}
+
+
+/* Buffers stream data and passes it to the writer a chunk at a time */
+class _fileinfo_stream_writer
+{
+public:
+	explicit _fileinfo_stream_writer(IGnMusicIdFileInfoWriter& writer) : writer_(writer), used_(0) { }
+
+	void
+	write(const void* data, gnsdk_size_t size) throw (GnError)
+	{
+		const gnsdk_byte_t* p = (const gnsdk_byte_t*)data;
+
+		while (size)
+		{
+			gnsdk_size_t chunk = FILEINFO_STREAM_CHUNK_SIZE - used_;
+
+			if (chunk > size)
+			{
+				chunk = size;
+			}
+			memcpy(buffer_ + used_, p, chunk);
+			used_ += chunk;
+			p     += chunk;
+			size  -= chunk;
+
+			if (FILEINFO_STREAM_CHUNK_SIZE == used_)
+			{
+				flush();
+			}
+		}
+	}
+
+	void
+	write_uint32(gnsdk_uint32_t value) throw (GnError)
+	{
+		gnsdk_byte_t bytes[4];
+
+		_stream_put_uint32(bytes, value);
+		write(bytes, sizeof(bytes));
+	}
+
+	void
+	flush() throw (GnError)
+	{
+		if (used_ && !writer_.WriteData(buffer_, used_))
+		{
+			throw GnError(GNSDKERR_Aborted, "File info stream writer stopped rendering");
+		}
+		used_ = 0;
+	}
+
+private:
+	IGnMusicIdFileInfoWriter&	writer_;
+	gnsdk_byte_t				buffer_[FILEINFO_STREAM_CHUNK_SIZE];
+	gnsdk_size_t				used_;
+
+	DISALLOW_COPY_AND_ASSIGN(_fileinfo_stream_writer);
+};
+
+
+/* Reads stream data from the reader a chunk at a time */
+class _fileinfo_stream_reader
+{
+public:
+	explicit _fileinfo_stream_reader(IGnMusicIdFileInfoReader& reader) : reader_(reader), pos_(0), used_(0) { }
+
+	void
+	read(void* data, gnsdk_size_t size) throw (GnError)
+	{
+		gnsdk_byte_t* p = (gnsdk_byte_t*)data;
+
+		while (size)
+		{
+			if (pos_ == used_)
+			{
+				pos_  = 0;
+				used_ = reader_.ReadData(buffer_, FILEINFO_STREAM_CHUNK_SIZE);
+				if (0 == used_)
+				{
+					throw GnError(GNSDKERR_InvalidData, "File info stream is truncated");
+				}
+				if (used_ > FILEINFO_STREAM_CHUNK_SIZE)
+				{
+					throw GnError(GNSDKERR_InvalidArg, "File info stream reader overran the buffer");
+				}
+			}
+
+			gnsdk_size_t chunk = used_ - pos_;
+
+			if (chunk > size)
+			{
+				chunk = size;
+			}
+			memcpy(p, buffer_ + pos_, chunk);
+			pos_ += chunk;
+			p    += chunk;
+			size -= chunk;
+		}
+	}
+
+	gnsdk_uint32_t
+	read_uint32() throw (GnError)
+	{
+		gnsdk_byte_t bytes[4];
+
+		read(bytes, sizeof(bytes));
+		return _stream_get_uint32(bytes);
+	}
+
+private:
+	IGnMusicIdFileInfoReader&	reader_;
+	gnsdk_byte_t				buffer_[FILEINFO_STREAM_CHUNK_SIZE];
+	gnsdk_size_t				pos_;
+	gnsdk_size_t				used_;
+
+	DISALLOW_COPY_AND_ASSIGN(_fileinfo_stream_reader);
+};
+
+
+gnsdk_uint32_t
+GnMusicIdFileInfoManager::RenderToStream(IGnMusicIdFileInfoWriter& writer) throw (GnError)
+{
+	_fileinfo_stream_writer*	p_writer = new _fileinfo_stream_writer(writer);
+	gnsdk_uint32_t				count    = 0;
+	gnsdk_error_t				error;
+
+	try
+	{
+		gnsdk_byte_t header[FILEINFO_STREAM_HEADER_SIZE] = { 0 };
+
+		memcpy(header, FILEINFO_STREAM_MAGIC, 4);
+		header[4] = FILEINFO_STREAM_VERSION;
+		p_writer->write(header, sizeof(header));
+
+		error = gnsdk_musicidfile_query_fileinfo_count(weakhandle_, &count);
+		if (error) { throw GnError(); }
+
+		for (gnsdk_uint32_t i = 0; i < count; i++)
+		{
+			gnsdk_musicidfile_fileinfo_handle_t	fileinfo_handle = GNSDK_NULL;
+			gnsdk_cstr_t						values[FILEINFO_STREAM_KEY_COUNT];
+			gnsdk_uint32_t						sizes[FILEINFO_STREAM_KEY_COUNT];
+			gnsdk_uint32_t						record_size = 0;
+			gnsdk_uint32_t						k;
+
+			error = gnsdk_musicidfile_query_fileinfo_get_by_index(weakhandle_, i, &fileinfo_handle);
+			if (error) { throw GnError(); }
+
+			for (k = 0; k < FILEINFO_STREAM_KEY_COUNT; k++)
+			{
+				gnsdk_cstr_t value  = GNSDK_NULL;
+				gnsdk_cstr_t source = GNSDK_NULL;
+
+				error = gnsdk_musicidfile_fileinfo_metadata_get(fileinfo_handle, s_stream_keys[k], &value, &source);
+				if (GNSDKERR_SEVERE(error)) { throw GnError(); }
+
+				/* values parsed from the file name are parsed again when it is set on import */
+				if (error || (GNSDK_NULL == value) || (0 == *value) ||
+					(source && (0 == gnstd::gn_strcmp(source, GNSDK_MUSICIDFILE_FILEINFO_VALUE_SOURCE_FILENAME))))
+				{
+					values[k] = GNSDK_NULL;
+					sizes[k]  = 0;
+					continue;
+				}
+
+				values[k]    = value;
+				sizes[k]     = (gnsdk_uint32_t)gnstd::gn_strlen(value) + 1;
+				record_size += FILEINFO_STREAM_FIELD_SIZE + sizes[k];
+			}
+
+			if ((GNSDK_NULL == values[0]) || (record_size > FILEINFO_STREAM_RECORD_MAX))
+			{
+				throw GnError(GNSDKERR_InvalidData, "File info cannot be rendered to a stream");
+			}
+
+			p_writer->write_uint32(record_size);
+			for (k = 0; k < FILEINFO_STREAM_KEY_COUNT; k++)
+			{
+				if (values[k])
+				{
+					gnsdk_byte_t key = (gnsdk_byte_t)k;
+
+					p_writer->write(&key, 1);
+					p_writer->write_uint32(sizes[k]);
+					p_writer->write(values[k], sizes[k]);
+				}
+			}
+		}
+
+		p_writer->write_uint32(0);
+		p_writer->flush();
+	}
+	catch (...)
+	{
+		/* delegates may throw anything, the writer is freed either way */
+		delete p_writer;
+		throw;
+	}
+
+	delete p_writer;
+	return count;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddFromStream
+ */
+gnsdk_uint32_t
+GnMusicIdFileInfoManager::AddFromStream(IGnMusicIdFileInfoReader& reader, IGnMusicIdFileInfoEvents* pEventHandler) throw (GnError)
+{
+	_fileinfo_stream_reader*	p_reader      = new _fileinfo_stream_reader(reader);
+	gnsdk_byte_t*				record        = GNSDK_NULL;
+	gnsdk_uint32_t				record_buffer = 0;
+	gnsdk_uint32_t				count         = 0;
+	gnsdk_error_t				error;
+
+	try
+	{
+		gnsdk_byte_t header[FILEINFO_STREAM_HEADER_SIZE];
+
+		p_reader->read(header, sizeof(header));
+		if (memcmp(header, FILEINFO_STREAM_MAGIC, 4) || (FILEINFO_STREAM_VERSION != header[4]))
+		{
+			throw GnError(GNSDKERR_InvalidFormat, "Not a file info stream");
+		}
+
+		for (;;)
+		{
+			gnsdk_uint32_t record_size = p_reader->read_uint32();
+			gnsdk_uint32_t pos         = 0;
+
+			if (0 == record_size)
+			{
+				break;
+			}
+			if (record_size > FILEINFO_STREAM_RECORD_MAX)
+			{
+				throw GnError(GNSDKERR_InvalidData, "File info stream is corrupt");
+			}
+
+			/* one record is held at a time, in a buffer sized for the largest so far */
+			if (record_size > record_buffer)
+			{
+				delete [] record;
+				record        = new gnsdk_byte_t[record_size];
+				record_buffer = record_size;
+			}
+			p_reader->read(record, record_size);
+
+			GnMusicIdFileInfo fileinfo;
+
+			while (pos < record_size)
+			{
+				gnsdk_uint32_t	key;
+				gnsdk_uint32_t	value_size;
+				gnsdk_cstr_t	value;
+
+				if (record_size - pos < FILEINFO_STREAM_FIELD_SIZE)
+				{
+					throw GnError(GNSDKERR_InvalidData, "File info stream is corrupt");
+				}
+				key        = record[pos];
+				value_size = _stream_get_uint32(record + pos + 1);
+				pos       += FILEINFO_STREAM_FIELD_SIZE;
+
+				if ((0 == value_size) || (value_size > record_size - pos) || (0 != record[pos + value_size - 1]))
+				{
+					throw GnError(GNSDKERR_InvalidData, "File info stream is corrupt");
+				}
+				value = (gnsdk_cstr_t)(record + pos);
+				pos  += value_size;
+
+				if (0 == key)
+				{
+					if (pos != FILEINFO_STREAM_FIELD_SIZE + value_size)
+					{
+						throw GnError(GNSDKERR_InvalidData, "File info stream is corrupt");
+					}
+					fileinfo = Add(value, pEventHandler);
+				}
+				else if (GNSDK_NULL == fileinfo.fileInfohandle_)
+				{
+					throw GnError(GNSDKERR_InvalidData, "File info stream record has no identifier");
+				}
+				else if (key < FILEINFO_STREAM_KEY_COUNT)
+				{
+					error = gnsdk_musicidfile_fileinfo_metadata_set(fileinfo.fileInfohandle_, s_stream_keys[key], value);
+					if (error) { throw GnError(); }
+				}
+			}
+
+			if (GNSDK_NULL == fileinfo.fileInfohandle_)
+			{
+				throw GnError(GNSDKERR_InvalidData, "File info stream record has no identifier");
+			}
+			count += 1;
+		}
+	}
+	catch (...)
+	{
+		delete [] record;
+		delete p_reader;
+		throw;
+	}
+
+	delete [] record;
+	delete p_reader;
+	return count;
+}
+
+
 GnMusicIdFileInfo
 GnMusicIdFileInfoManager::GetByIdentifier(gnsdk_cstr_t ident) throw (GnError)
 {
@@ -403,7 +811,9 @@ GnMusicIdFileInfoManager::GetByFolder(gnsdk_cstr_t folder, gnsdk_uint32_t index)
  */
 
 GnMusicIdFile::GnMusicIdFile(const GnUser& user, IGnMusicIdFileEvents* pEventHandler) throw (GnError) :
-	eventhandler_(pEventHandler)
+	eventhandler_(pEventHandler),
+	prefetch_(GNSDK_NULL),
+	fingerprintcache_(GNSDK_NULL)
 {
 	gnsdk_musicidfile_query_handle_t	query_handle = GNSDK_NULL;
 	gnsdk_error_t						error;
@@ -606,6 +1016,13 @@ _callback_status(void* callback_data, gnsdk_musicidfile_query_handle_t query_han
 
 	(void)query_handle;
 
+	/* a processed file no longer holds a place in the prefetch window */
+	if (p_midf->Prefetch() && fileinfo_handle &&
+		((gnsdk_musicidfile_status_fileinfo_processing_complete == status) || (gnsdk_musicidfile_status_fileinfo_processing_error == status)))
+	{
+		p_midf->Prefetch()->Release(GnMusicIdFileInfo(query_handle, fileinfo_handle));
+	}
+
 	if (p_midf->EventHandler())
 	{
 		GnMusicIdFileInfo			fileinfo = GnMusicIdFileInfo(query_handle, fileinfo_handle);
@@ -641,6 +1058,30 @@ _callback_get_fingerprint(void* callback_data, gnsdk_musicidfile_query_handle_t
 
 	GNSDK_UNUSED(query_handle);
 
+	if (p_midf->Prefetch())
+	{
+		if (p_midf->Prefetch()->Gather(GnMusicIdFileInfo(query_handle, fileinfo_handle)))
+		{
+			return;
+		}
+	}
+
+	if (p_midf->FingerprintCache())
+	{
+		GnMusicIdFileInfo fileinfo = GnMusicIdFileInfo(query_handle, fileinfo_handle);
+
+		try
+		{
+			if (p_midf->FingerprintCache()->Lookup(fileinfo))
+			{
+				return;
+			}
+		}
+		catch (GnError&)
+		{
+		}
+	}
+
 	if (p_midf->EventHandler())
 	{
 		GnMusicIdFileInfo	fileinfo = GnMusicIdFileInfo(query_handle, fileinfo_handle);
@@ -651,7 +1092,17 @@ _callback_get_fingerprint(void* callback_data, gnsdk_musicidfile_query_handle_t
         {
             *p_abort = GNSDK_TRUE;
         }
-		
+		else if (p_midf->FingerprintCache())
+		{
+			/* a cache that cannot be updated only costs a decode on the next scan */
+			try
+			{
+				p_midf->FingerprintCache()->Store(fileinfo);
+			}
+			catch (GnError&)
+			{
+			}
+		}
 	}
 }
 
@@ -1361,10 +1812,9 @@ GnMusicIdFileInfo::FingerprintEnd() throw (GnError)
  *  FingerprintFromSource
  */
 void
-GnMusicIdFileInfo::FingerprintFromSource(IGnAudioSource& audioSource)  throw (GnError)
+GnMusicIdFileInfo::FingerprintFromSource(IGnAudioSource& audioSource, gnsdk_uint32_t chunkDurationMs)  throw (GnError)
 {
-	gnsdk_uint32_t	audioSizeInBytes;
-	gnsdk_byte_t*	pAudioBuffer = GNSDK_NULL;
+	gnsdk_size_t	audioSizeInBytes;
 	gnsdk_size_t	audioDataSize;
 	gnsdk_bool_t  	bComplete;
 	gnsdk_error_t 	error;
@@ -1391,30 +1841,24 @@ GnMusicIdFileInfo::FingerprintFromSource(IGnAudioSource& audioSource)  throw (Gn
 	{
 		// need to create a buffer to carry the raw audio, make it relative to the total size
 		// the raw audio we expect we need for generating the fingerprint
-		audioSizeInBytes = audioSource.SamplesPerSecond() * (audioSource.SampleSizeInBits()/8) * audioSource.NumberOfChannels() * 4; // 4 for 4 seconds
+		audioSizeInBytes = gn_audio_reader::chunk_size(audioSource, chunkDurationMs ? chunkDurationMs : MUSICIDFILE_CHUNK_DURATION_MS);
 		if ( audioSizeInBytes != 0 )
 		{
-			pAudioBuffer = new gnsdk_byte_t[audioSizeInBytes];
-			if ( pAudioBuffer == GNSDK_NULL )
-				error = GNSDKERR_NoMemory;
+			gn_audio_reader		audioReader(audioSource, audioSizeInBytes);
+			const gnsdk_byte_t*	pAudioData;
 
-			if (!error)
+			while (0 < ( audioDataSize = audioReader.read(&pAudioData) ) )
 			{
-				while (0 < ( audioDataSize = audioSource.GetData(pAudioBuffer, audioSizeInBytes ) ) )
+				error = gnsdk_musicidfile_fileinfo_fingerprint_write(fileInfohandle_, pAudioData, audioDataSize, &bComplete);
+				if (error)
 				{
-					error = gnsdk_musicidfile_fileinfo_fingerprint_write(fileInfohandle_, pAudioBuffer, audioDataSize, &bComplete);
-					if (error)
-					{
-						break;
-					}
-
-					if (bComplete)
-					{
-						break;
-					}
+					break;
 				}
 
-				delete[] pAudioBuffer;
+				if (bComplete)
+				{
+					break;
+				}
 			}
 
 			if (!bComplete)
@@ -0,0 +1,827 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_musicidfilecache.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+
+#if GNSDK_MUSICID_FILE
+
+#include "gnsdk_musicidfilecache.hpp"
+
+#include <stdio.h>
+
+#if !defined(GNSDK_WINDOWS)
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+#endif
+
+using namespace gracenote;
+using namespace gracenote::musicid_file;
+
+
+/* cache file layout, in host byte order:
+ *   file_header
+ *   gnsdk_uint32_t buckets[bucket_count]	entry index + 1 by path hash, linear probing, 0 if empty
+ *   file_entry entries[count]
+ *   char strings[strings_size]				NUL terminated paths and fingerprints
+ */
+#define FPCACHE_MAGIC				0x43464E47		/* "GNFC", reads differently on a host of the other byte order */
+#define FPCACHE_VERSION				1
+#define FPCACHE_FLAG_CONTENT_HASH	0x00000001
+#define FPCACHE_BUCKETS_MIN			16
+
+/* bytes hashed at the start, middle and end of a file for the content hash */
+#define FPCACHE_SAMPLE_SIZE			(64 * 1024)
+
+/* initial number of in memory lookup buckets, doubled as fingerprints are stored */
+#define FPCACHE_RAM_BUCKETS_INITIAL	64
+
+
+/******************************************************************************
+** GnMusicIdFileFingerprintCache internals
+*/
+struct GnMusicIdFileFingerprintCache::file_key
+{
+	gnsdk_uint64_t	size;
+	gnsdk_uint64_t	mtime;
+	gnsdk_uint64_t	content;
+};
+
+struct GnMusicIdFileFingerprintCache::file_header
+{
+	gnsdk_uint32_t	magic;
+	gnsdk_uint32_t	version;
+	gnsdk_uint32_t	flags;
+	gnsdk_uint32_t	count;
+	gnsdk_uint32_t	bucket_count;
+	gnsdk_uint32_t	reserved;
+	gnsdk_uint64_t	strings_size;
+};
+
+struct GnMusicIdFileFingerprintCache::file_entry
+{
+	gnsdk_uint64_t	size;
+	gnsdk_uint64_t	mtime;
+	gnsdk_uint64_t	content;
+	gnsdk_uint32_t	path_hash;
+	gnsdk_uint32_t	path_offset;
+	gnsdk_uint32_t	path_length;
+	gnsdk_uint32_t	fp_offset;
+	gnsdk_uint32_t	fp_length;
+	gnsdk_uint32_t	reserved;
+};
+
+struct GnMusicIdFileFingerprintCache::ram_entry
+{
+	file_key		key;
+	gnsdk_uint32_t	path_hash;
+	char*			path;
+	gnsdk_uint32_t	path_length;
+	char*			fingerprint;
+	gnsdk_uint32_t	fp_length;
+	ram_entry*		next;
+};
+
+
+static gnsdk_uint32_t
+_hash_path(gnsdk_cstr_t path)
+{
+	gnsdk_uint32_t hash = 2166136261U;
+
+	for (const unsigned char* p = (const unsigned char*)path; *p; p++)
+	{
+		hash = (hash ^ *p) * 16777619U;
+	}
+	return hash;
+}
+
+static gnsdk_uint64_t
+_hash_bytes(gnsdk_uint64_t hash, const unsigned char* p, gnsdk_size_t size)
+{
+	while (size--)
+	{
+		hash = (hash ^ *p++) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+static char*
+_copy_string(gnsdk_cstr_t str, gnsdk_uint32_t length)
+{
+	char* copy = new char[length + 1];
+
+	gnstd::gn_strcpy(copy, length + 1, str);
+	return copy;
+}
+
+/* hash of samples of the content, reading the whole file would cost about as much as decoding it */
+static bool
+_hash_content(gnsdk_cstr_t path, gnsdk_uint64_t size, gnsdk_uint64_t* p_hash)
+{
+	unsigned char	buffer[4096];
+	gnsdk_uint64_t	offsets[3];
+	gnsdk_uint64_t	hash = 14695981039346656037ULL;
+	gnsdk_uint32_t	samples;
+	FILE*			file;
+
+	file = fopen(path, "rb");
+	if (GNSDK_NULL == file)
+	{
+		return false;
+	}
+
+	if (size <= 3 * FPCACHE_SAMPLE_SIZE)
+	{
+		offsets[0] = 0;
+		samples    = 1;
+	}
+	else
+	{
+		offsets[0] = 0;
+		offsets[1] = (size / 2) - (FPCACHE_SAMPLE_SIZE / 2);
+		offsets[2] = size - FPCACHE_SAMPLE_SIZE;
+		samples    = 3;
+	}
+
+	for (gnsdk_uint32_t i = 0; i < samples; i++)
+	{
+		gnsdk_uint64_t remaining = (1 == samples) ? size : FPCACHE_SAMPLE_SIZE;
+
+		if (!gnstd::gn_fseek(file, offsets[i]))
+		{
+			fclose(file);
+			return false;
+		}
+
+		while (remaining)
+		{
+			gnsdk_size_t want = (remaining < sizeof(buffer)) ? (gnsdk_size_t)remaining : sizeof(buffer);
+			gnsdk_size_t got  = fread(buffer, 1, want, file);
+
+			if (0 == got)
+			{
+				break;
+			}
+			hash       = _hash_bytes(hash, buffer, got);
+			remaining -= got;
+		}
+	}
+
+	fclose(file);
+
+	*p_hash = hash;
+	return true;
+}
+
+
+/******************************************************************************
+** GnMusicIdFileFingerprintCache
+*/
+GnMusicIdFileFingerprintCache::GnMusicIdFileFingerprintCache(gnsdk_cstr_t cachePath, bool bContentHash) throw (GnError) :
+	path_(GNSDK_NULL),
+	content_hash_(bContentHash),
+	map_(GNSDK_NULL),
+	map_size_(0),
+	header_(GNSDK_NULL),
+	buckets_(GNSDK_NULL),
+	entries_(GNSDK_NULL),
+	strings_(GNSDK_NULL),
+#if defined(GNSDK_WINDOWS)
+	file_(INVALID_HANDLE_VALUE),
+	mapping_(GNSDK_NULL),
+#endif
+	ram_buckets_(GNSDK_NULL),
+	ram_bucket_count_(FPCACHE_RAM_BUCKETS_INITIAL),
+	ram_count_(0),
+	ram_new_(0)
+{
+	if ((GNSDK_NULL == cachePath) || (0 == *cachePath))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Cache path required");
+	}
+
+	path_        = _copy_string(cachePath, (gnsdk_uint32_t)gnstd::gn_strlen(cachePath));
+	ram_buckets_ = new ram_entry*[ram_bucket_count_];
+	for (gnsdk_uint32_t i = 0; i < ram_bucket_count_; i++)
+	{
+		ram_buckets_[i] = GNSDK_NULL;
+	}
+
+	_map();
+}
+
+GnMusicIdFileFingerprintCache::~GnMusicIdFileFingerprintCache()
+{
+	try
+	{
+		Flush();
+	}
+	catch (GnError&)
+	{
+	}
+
+	_unmap();
+	_clear_ram();
+	delete [] ram_buckets_;
+	delete [] path_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Lookup
+ */
+bool
+GnMusicIdFileFingerprintCache::Lookup(GnMusicIdFileInfo& fileInfo) throw (GnError)
+{
+	gnsdk_cstr_t	path = fileInfo.FileName();
+	file_key		key;
+
+	if ((GNSDK_NULL == path) || (0 == *path) || !_key(path, key))
+	{
+		misses_.fetch_add(1);
+		return false;
+	}
+
+	gnsdk_uint32_t	path_hash = _hash_path(path);
+	gn_lock			lock(mutex_);
+
+	/* stored fingerprints replace those of the cache file */
+	ram_entry* p_ram = _find_ram(path, path_hash);
+	if (p_ram)
+	{
+		if ((p_ram->key.size == key.size) && (p_ram->key.mtime == key.mtime) && (p_ram->key.content == key.content))
+		{
+			fileInfo.Fingerprint(p_ram->fingerprint);
+			hits_.fetch_add(1);
+			return true;
+		}
+	}
+	else
+	{
+		const file_entry* p_entry = _find_mapped(path, path_hash);
+
+		if (p_entry && (p_entry->size == key.size) && (p_entry->mtime == key.mtime) && (p_entry->content == key.content))
+		{
+			gnsdk_cstr_t fingerprint = _mapped_string(p_entry->fp_offset, p_entry->fp_length);
+
+			if (fingerprint)
+			{
+				fileInfo.Fingerprint(fingerprint);
+				hits_.fetch_add(1);
+				return true;
+			}
+		}
+	}
+
+	misses_.fetch_add(1);
+	return false;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Store
+ */
+void
+GnMusicIdFileFingerprintCache::Store(GnMusicIdFileInfo& fileInfo) throw (GnError)
+{
+	gnsdk_cstr_t	path        = fileInfo.FileName();
+	gnsdk_cstr_t	fingerprint;
+	file_key		key;
+	ram_entry*		p_new;
+
+	if ((GNSDK_NULL == path) || (0 == *path))
+	{
+		return;
+	}
+
+	fingerprint = fileInfo.Fingerprint();
+	if ((GNSDK_NULL == fingerprint) || (0 == *fingerprint) || !_key(path, key))
+	{
+		return;
+	}
+
+	p_new              = new ram_entry;
+	p_new->key         = key;
+	p_new->path_hash   = _hash_path(path);
+	p_new->path_length = (gnsdk_uint32_t)gnstd::gn_strlen(path);
+	p_new->path        = _copy_string(path, p_new->path_length);
+	p_new->fp_length   = (gnsdk_uint32_t)gnstd::gn_strlen(fingerprint);
+	p_new->fingerprint = _copy_string(fingerprint, p_new->fp_length);
+	p_new->next        = GNSDK_NULL;
+
+	gn_lock lock(mutex_);
+
+	ram_entry* p_ram = _find_ram(p_new->path, p_new->path_hash);
+	if (p_ram)
+	{
+		/* keep the entry in its chain, take over the new values */
+		delete [] p_ram->fingerprint;
+		p_ram->key         = p_new->key;
+		p_ram->fingerprint = p_new->fingerprint;
+		p_ram->fp_length   = p_new->fp_length;
+
+		delete [] p_new->path;
+		delete p_new;
+		return;
+	}
+
+	if (ram_count_ >= ram_bucket_count_ * 2)
+	{
+		gnsdk_uint32_t	count   = ram_bucket_count_ * 2;
+		ram_entry**		buckets = new ram_entry*[count];
+		gnsdk_uint32_t	i;
+
+		for (i = 0; i < count; i++)
+		{
+			buckets[i] = GNSDK_NULL;
+		}
+
+		for (i = 0; i < ram_bucket_count_; i++)
+		{
+			ram_entry* p_chain = ram_buckets_[i];
+
+			while (p_chain)
+			{
+				ram_entry*		p_next = p_chain->next;
+				gnsdk_uint32_t	index  = p_chain->path_hash & (count - 1);
+
+				p_chain->next  = buckets[index];
+				buckets[index] = p_chain;
+				p_chain        = p_next;
+			}
+		}
+
+		delete [] ram_buckets_;
+		ram_buckets_      = buckets;
+		ram_bucket_count_ = count;
+	}
+
+	gnsdk_uint32_t index = p_new->path_hash & (ram_bucket_count_ - 1);
+
+	p_new->next         = ram_buckets_[index];
+	ram_buckets_[index] = p_new;
+	ram_count_         += 1;
+
+	if (GNSDK_NULL == _find_mapped(p_new->path, p_new->path_hash))
+	{
+		ram_new_ += 1;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Flush
+ */
+void
+GnMusicIdFileFingerprintCache::Flush() throw (GnError)
+{
+	gn_lock lock(mutex_);
+
+	if (0 == ram_count_)
+	{
+		return;
+	}
+
+	gnsdk_uint32_t	length   = (gnsdk_uint32_t)gnstd::gn_strlen(path_);
+	char*			tmp_path = new char[length + 5];
+
+	gnstd::gn_strcpy(tmp_path, length + 5, path_);
+	gnstd::gn_strcpy(tmp_path + length, 5, ".tmp");
+
+	try
+	{
+		_write(tmp_path);
+	}
+	catch (GnError&)
+	{
+		delete [] tmp_path;
+		throw;
+	}
+
+	/* the mapping is only needed while writing; Windows cannot replace a mapped file */
+	_unmap();
+
+	if (!gnstd::gn_file_replace(tmp_path, path_))
+	{
+		remove(tmp_path);
+		delete [] tmp_path;
+
+		/* stored fingerprints are kept for the next flush */
+		_map();
+		throw GnError(GNSDKERR_IOError, "Failed to replace fingerprint cache file");
+	}
+	delete [] tmp_path;
+
+	_clear_ram();
+	_map();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Count
+ */
+gnsdk_uint32_t
+GnMusicIdFileFingerprintCache::Count() const
+{
+	gn_lock lock(mutex_);
+
+	return (header_ ? header_->count : 0) + ram_new_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _key
+ */
+bool
+GnMusicIdFileFingerprintCache::_key(gnsdk_cstr_t path, file_key& key) const
+{
+	if (!gnstd::gn_file_stat(path, &key.size, &key.mtime))
+	{
+		return false;
+	}
+
+	key.content = 0;
+	if (content_hash_)
+	{
+		return _hash_content(path, key.size, &key.content);
+	}
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _find_mapped
+ */
+const GnMusicIdFileFingerprintCache::file_entry*
+GnMusicIdFileFingerprintCache::_find_mapped(gnsdk_cstr_t path, gnsdk_uint32_t path_hash) const
+{
+	if (GNSDK_NULL == header_)
+	{
+		return GNSDK_NULL;
+	}
+
+	gnsdk_uint32_t mask = header_->bucket_count - 1;
+
+	/* bounded so a damaged file cannot loop */
+	for (gnsdk_uint32_t probe = 0; probe < header_->bucket_count; probe++)
+	{
+		gnsdk_uint32_t index = buckets_[(path_hash + probe) & mask];
+
+		if ((0 == index) || (index > header_->count))
+		{
+			return GNSDK_NULL;
+		}
+
+		const file_entry* p_entry = &entries_[index - 1];
+
+		if (p_entry->path_hash == path_hash)
+		{
+			gnsdk_cstr_t entry_path = _mapped_string(p_entry->path_offset, p_entry->path_length);
+
+			if (entry_path && (0 == gnstd::gn_strcmp(entry_path, path)))
+			{
+				return p_entry;
+			}
+		}
+	}
+	return GNSDK_NULL;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _find_ram
+ */
+GnMusicIdFileFingerprintCache::ram_entry*
+GnMusicIdFileFingerprintCache::_find_ram(gnsdk_cstr_t path, gnsdk_uint32_t path_hash) const
+{
+	ram_entry* p_entry = ram_buckets_[path_hash & (ram_bucket_count_ - 1)];
+
+	while (p_entry)
+	{
+		if ((p_entry->path_hash == path_hash) && (0 == gnstd::gn_strcmp(p_entry->path, path)))
+		{
+			return p_entry;
+		}
+		p_entry = p_entry->next;
+	}
+	return GNSDK_NULL;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _mapped_string
+ */
+gnsdk_cstr_t
+GnMusicIdFileFingerprintCache::_mapped_string(gnsdk_uint32_t offset, gnsdk_uint32_t length) const
+{
+	if (((gnsdk_uint64_t)offset + length >= header_->strings_size) || (0 != strings_[offset + length]))
+	{
+		return GNSDK_NULL;
+	}
+	return strings_ + offset;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _map
+ */
+void
+GnMusicIdFileFingerprintCache::_map()
+{
+#if defined(GNSDK_WINDOWS)
+	LARGE_INTEGER size;
+
+	file_ = CreateFileA(path_, GENERIC_READ, FILE_SHARE_READ, GNSDK_NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, GNSDK_NULL);
+	if (INVALID_HANDLE_VALUE == file_)
+	{
+		return;
+	}
+	if (!GetFileSizeEx(file_, &size) || (size.QuadPart < (LONGLONG)sizeof(file_header)))
+	{
+		_unmap();
+		return;
+	}
+
+	mapping_ = CreateFileMappingA(file_, GNSDK_NULL, PAGE_READONLY, 0, 0, GNSDK_NULL);
+	if (GNSDK_NULL == mapping_)
+	{
+		_unmap();
+		return;
+	}
+
+	map_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+	if (GNSDK_NULL == map_)
+	{
+		_unmap();
+		return;
+	}
+	map_size_ = (gnsdk_size_t)size.QuadPart;
+#else
+	struct stat	info;
+	void*		p_map;
+	int			fd;
+
+	fd = open(path_, O_RDONLY);
+	if (fd < 0)
+	{
+		return;
+	}
+	if ((0 != fstat(fd, &info)) || (info.st_size < (off_t)sizeof(file_header)))
+	{
+		close(fd);
+		return;
+	}
+
+	p_map = mmap(GNSDK_NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (MAP_FAILED == p_map)
+	{
+		return;
+	}
+	map_      = p_map;
+	map_size_ = (gnsdk_size_t)info.st_size;
+#endif
+
+	/* a file that does not check out is treated as empty and replaced by the next flush */
+	const file_header*	p_header     = (const file_header*)map_;
+	gnsdk_uint32_t		bucket_count = p_header->bucket_count;
+	gnsdk_uint64_t		expected;
+
+	if ((FPCACHE_MAGIC != p_header->magic) || (FPCACHE_VERSION != p_header->version) ||
+		((0 != (p_header->flags & FPCACHE_FLAG_CONTENT_HASH)) != content_hash_) ||
+		(bucket_count < FPCACHE_BUCKETS_MIN) || (0 != (bucket_count & (bucket_count - 1))) ||
+		(p_header->count >= bucket_count))
+	{
+		_unmap();
+		return;
+	}
+
+	expected = sizeof(file_header) + ((gnsdk_uint64_t)bucket_count * sizeof(gnsdk_uint32_t)) +
+			   ((gnsdk_uint64_t)p_header->count * sizeof(file_entry)) + p_header->strings_size;
+	if (expected != (gnsdk_uint64_t)map_size_)
+	{
+		_unmap();
+		return;
+	}
+
+	header_  = p_header;
+	buckets_ = (const gnsdk_uint32_t*)(header_ + 1);
+	entries_ = (const file_entry*)(buckets_ + bucket_count);
+	strings_ = (const char*)(entries_ + header_->count);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _unmap
+ */
+void
+GnMusicIdFileFingerprintCache::_unmap()
+{
+#if defined(GNSDK_WINDOWS)
+	if (map_)
+	{
+		UnmapViewOfFile(map_);
+	}
+	if (mapping_)
+	{
+		CloseHandle(mapping_);
+		mapping_ = GNSDK_NULL;
+	}
+	if (INVALID_HANDLE_VALUE != file_)
+	{
+		CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (map_)
+	{
+		munmap(map_, map_size_);
+	}
+#endif
+
+	map_      = GNSDK_NULL;
+	map_size_ = 0;
+	header_   = GNSDK_NULL;
+	buckets_  = GNSDK_NULL;
+	entries_  = GNSDK_NULL;
+	strings_  = GNSDK_NULL;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _write
+ */
+void
+GnMusicIdFileFingerprintCache::_write(gnsdk_cstr_t path) throw (GnError)
+{
+	gnsdk_uint32_t	mapped_count = header_ ? header_->count : 0;
+	gnsdk_uint32_t	capacity     = ram_count_ + mapped_count;
+	file_entry*		entries      = new file_entry[capacity];
+	gnsdk_cstr_t*	strings      = new gnsdk_cstr_t[capacity * 2];
+	gnsdk_uint32_t*	buckets      = GNSDK_NULL;
+	gnsdk_uint32_t	bucket_count = FPCACHE_BUCKETS_MIN;
+	gnsdk_uint64_t	strings_size = 0;
+	gnsdk_uint32_t	count        = 0;
+	gnsdk_uint32_t	i;
+	file_header		header;
+	FILE*			file;
+	bool			b_ok;
+
+	for (i = 0; i < ram_bucket_count_; i++)
+	{
+		for (ram_entry* p_ram = ram_buckets_[i]; p_ram; p_ram = p_ram->next)
+		{
+			file_entry& entry = entries[count];
+
+			entry.size        = p_ram->key.size;
+			entry.mtime       = p_ram->key.mtime;
+			entry.content     = p_ram->key.content;
+			entry.path_hash   = p_ram->path_hash;
+			entry.path_length = p_ram->path_length;
+			entry.fp_length   = p_ram->fp_length;
+			entry.reserved    = 0;
+
+			strings[count * 2]     = p_ram->path;
+			strings[count * 2 + 1] = p_ram->fingerprint;
+			count += 1;
+		}
+	}
+
+	/* cached fingerprints carry over unless stored again */
+	for (i = 0; i < mapped_count; i++)
+	{
+		const file_entry&	mapped      = entries_[i];
+		gnsdk_cstr_t		entry_path  = _mapped_string(mapped.path_offset, mapped.path_length);
+		gnsdk_cstr_t		fingerprint = _mapped_string(mapped.fp_offset, mapped.fp_length);
+
+		if (!entry_path || !fingerprint || _find_ram(entry_path, mapped.path_hash))
+		{
+			continue;
+		}
+
+		entries[count]         = mapped;
+		strings[count * 2]     = entry_path;
+		strings[count * 2 + 1] = fingerprint;
+		count += 1;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		entries[i].path_offset = (gnsdk_uint32_t)strings_size;
+		strings_size          += entries[i].path_length + 1;
+		entries[i].fp_offset   = (gnsdk_uint32_t)strings_size;
+		strings_size          += entries[i].fp_length + 1;
+	}
+
+	/* offsets are 32 bit */
+	if (strings_size > GN_UINT32_MAX)
+	{
+		delete [] entries;
+		delete [] strings;
+		throw GnError(GNSDKERR_FileTooLarge, "Fingerprint cache too large");
+	}
+
+	while (bucket_count < count * 2)
+	{
+		bucket_count *= 2;
+	}
+	buckets = new gnsdk_uint32_t[bucket_count];
+	for (i = 0; i < bucket_count; i++)
+	{
+		buckets[i] = 0;
+	}
+	for (i = 0; i < count; i++)
+	{
+		gnsdk_uint32_t index = entries[i].path_hash & (bucket_count - 1);
+
+		while (buckets[index])
+		{
+			index = (index + 1) & (bucket_count - 1);
+		}
+		buckets[index] = i + 1;
+	}
+
+	header.magic        = FPCACHE_MAGIC;
+	header.version      = FPCACHE_VERSION;
+	header.flags        = content_hash_ ? FPCACHE_FLAG_CONTENT_HASH : 0;
+	header.count        = count;
+	header.bucket_count = bucket_count;
+	header.reserved     = 0;
+	header.strings_size = strings_size;
+
+	file = fopen(path, "wb");
+	b_ok = (GNSDK_NULL != file);
+	if (b_ok)
+	{
+		b_ok = (1 == fwrite(&header, sizeof(header), 1, file)) &&
+			   (bucket_count == fwrite(buckets, sizeof(gnsdk_uint32_t), bucket_count, file)) &&
+			   (count == fwrite(entries, sizeof(file_entry), count, file));
+
+		for (i = 0; b_ok && (i < count); i++)
+		{
+			b_ok = (1 == fwrite(strings[i * 2], entries[i].path_length + 1, 1, file)) &&
+				   (1 == fwrite(strings[i * 2 + 1], entries[i].fp_length + 1, 1, file));
+		}
+
+		if (0 != fclose(file))
+		{
+			b_ok = false;
+		}
+		if (!b_ok)
+		{
+			remove(path);
+		}
+	}
+
+	delete [] buckets;
+	delete [] entries;
+	delete [] strings;
+
+	if (!b_ok)
+	{
+		throw GnError(GNSDKERR_IOError, "Failed to write fingerprint cache file");
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _clear_ram
+ */
+void
+GnMusicIdFileFingerprintCache::_clear_ram()
+{
+	for (gnsdk_uint32_t i = 0; i < ram_bucket_count_; i++)
+	{
+		ram_entry* p_entry = ram_buckets_[i];
+
+		while (p_entry)
+		{
+			ram_entry* p_next = p_entry->next;
+
+			delete [] p_entry->path;
+			delete [] p_entry->fingerprint;
+			delete p_entry;
+			p_entry = p_next;
+		}
+		ram_buckets_[i] = GNSDK_NULL;
+	}
+
+	ram_count_ = 0;
+	ram_new_   = 0;
+}
+
+
+#endif /* GNSDK_MUSICID_FILE */
@@ -0,0 +1,787 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_musicidfilemanifest.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+
+#if GNSDK_MUSICID_FILE
+
+#include "gnsdk_musicidfilemanifest.hpp"
+
+#include <stdio.h>
+
+using namespace gracenote;
+using namespace gracenote::metadata;
+using namespace gracenote::musicid_file;
+
+
+/* manifest file layout, one line each, fields separated by tabs with tab, newline and backslash escaped:
+ *   MANIFEST_MAGIC
+ *   identifier  path  size  mtime  status  tui  mui  serialized album response
+ */
+#define MANIFEST_MAGIC				"GNMIDF-MANIFEST\t1"
+#define MANIFEST_FIELDS				8
+
+/* initial number of entries and lookup buckets, doubled as entries are added */
+#define MANIFEST_INITIAL_SIZE		64
+
+/* bytes copied at a time when carrying responses over to a new manifest file */
+#define MANIFEST_COPY_SIZE			4096
+
+
+/******************************************************************************
+** GnMusicIdFileManifest internals
+*/
+struct GnMusicIdFileManifest::entry
+{
+	char*					identifier;
+	gnsdk_uint32_t			hash;
+	char*					path;
+	gnsdk_uint64_t			size;
+	gnsdk_uint64_t			mtime;
+	GnMusicIdFileInfoStatus	status;
+	char*					tui;
+	char*					mui;
+
+	/* a recorded response is held until saved, a loaded one is read from the file when needed */
+	char*					response;
+	gnsdk_uint64_t			response_offset;
+	gnsdk_uint32_t			response_length;
+
+	bool					seen;
+	entry*					next;
+};
+
+
+static gnsdk_uint32_t
+_hash_string(gnsdk_cstr_t str)
+{
+	gnsdk_uint32_t hash = 2166136261U;
+
+	for (const unsigned char* p = (const unsigned char*)str; *p; p++)
+	{
+		hash = (hash ^ *p) * 16777619U;
+	}
+	return hash;
+}
+
+static char*
+_copy_string(gnsdk_cstr_t str)
+{
+	gnsdk_size_t	length;
+	char*			copy;
+
+	if (GNSDK_NULL == str)
+	{
+		str = gnstd::kEmptyString;
+	}
+
+	length = gnstd::gn_strlen(str);
+	copy   = new char[length + 1];
+	gnstd::gn_strcpy(copy, length + 1, str);
+	return copy;
+}
+
+static void
+_replace_string(char** p_str, gnsdk_cstr_t str)
+{
+	char* copy = _copy_string(str);
+
+	delete [] *p_str;
+	*p_str = copy;
+}
+
+static gnsdk_uint64_t
+_parse_uint64(gnsdk_cstr_t str)
+{
+	gnsdk_uint64_t value = 0;
+
+	for (; (*str >= '0') && (*str <= '9'); str++)
+	{
+		value = (value * 10) + (gnsdk_uint64_t)(*str - '0');
+	}
+	return value;
+}
+
+static bool
+_write_uint64(FILE* file, gnsdk_uint64_t value)
+{
+	char	buffer[24];
+	int		i = sizeof(buffer);
+
+	do
+	{
+		buffer[--i] = (char)('0' + (value % 10));
+		value      /= 10;
+	} while (value);
+
+	return 1 == fwrite(buffer + i, sizeof(buffer) - i, 1, file);
+}
+
+static bool
+_write_escaped(FILE* file, gnsdk_cstr_t str)
+{
+	gnsdk_cstr_t run = str;
+
+	for (; *str; str++)
+	{
+		gnsdk_cstr_t escape = GNSDK_NULL;
+
+		switch (*str)
+		{
+			case '\t': escape = "\\t";  break;
+			case '\n': escape = "\\n";  break;
+			case '\\': escape = "\\\\"; break;
+			default:   continue;
+		}
+
+		if ((str > run) && (1 != fwrite(run, str - run, 1, file)))
+		{
+			return false;
+		}
+		if (1 != fwrite(escape, 2, 1, file))
+		{
+			return false;
+		}
+		run = str + 1;
+	}
+
+	return (str == run) || (1 == fwrite(run, str - run, 1, file));
+}
+
+/* in place, the result is never longer */
+static void
+_unescape(char* str)
+{
+	char* out = str;
+
+	for (; *str; str++)
+	{
+		if (('\\' == *str) && str[1])
+		{
+			str++;
+			*out++ = ('t' == *str) ? '\t' : ('n' == *str) ? '\n' : *str;
+		}
+		else
+		{
+			*out++ = *str;
+		}
+	}
+	*out = 0;
+}
+
+/* read a line without its newline into a buffer grown as needed, returns the bytes consumed, 0 at the end */
+static gnsdk_size_t
+_read_line(FILE* file, char** p_buffer, gnsdk_size_t* p_capacity)
+{
+	gnsdk_size_t length = 0;
+
+	for (;;)
+	{
+		if (*p_capacity - length < 2)
+		{
+			gnsdk_size_t	capacity = *p_capacity ? *p_capacity * 2 : 256;
+			char*			buffer   = new char[capacity];
+
+			if (length)
+			{
+				gnstd::gn_strcpy(buffer, capacity, *p_buffer);
+			}
+			delete [] *p_buffer;
+			*p_buffer   = buffer;
+			*p_capacity = capacity;
+		}
+
+		if (GNSDK_NULL == fgets(*p_buffer + length, (int)(*p_capacity - length), file))
+		{
+			return length;
+		}
+		length += gnstd::gn_strlen(*p_buffer + length);
+
+		if ((length > 0) && ('\n' == (*p_buffer)[length - 1]))
+		{
+			(*p_buffer)[length - 1] = 0;
+			return length;
+		}
+	}
+}
+
+static bool
+_is_complete(GnMusicIdFileInfoStatus status)
+{
+	return (kMusicIdFileInfoStatusResultNone == status) || (kMusicIdFileInfoStatusResultSingle == status) ||
+		   (kMusicIdFileInfoStatusResultAll == status);
+}
+
+
+/******************************************************************************
+** GnMusicIdFileManifest
+*/
+GnMusicIdFileManifest::GnMusicIdFileManifest(gnsdk_cstr_t manifestPath) throw (GnError) :
+	path_(GNSDK_NULL),
+	file_(GNSDK_NULL),
+	entries_(GNSDK_NULL),
+	count_(0),
+	capacity_(0),
+	buckets_(GNSDK_NULL),
+	bucket_count_(0)
+{
+	if ((GNSDK_NULL == manifestPath) || (0 == *manifestPath))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Manifest path required");
+	}
+
+	path_ = _copy_string(manifestPath);
+	_load();
+}
+
+GnMusicIdFileManifest::~GnMusicIdFileManifest()
+{
+	_clear();
+	delete [] path_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Check
+ */
+GnMusicIdFileManifestChange
+GnMusicIdFileManifest::Check(gnsdk_cstr_t identifier, gnsdk_cstr_t filePath) throw (GnError)
+{
+	gnsdk_uint64_t	size  = 0;
+	gnsdk_uint64_t	mtime = 0;
+	bool			b_exists;
+	entry*			p_entry;
+
+	if ((GNSDK_NULL == identifier) || (GNSDK_NULL == filePath))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Identifier and file path required");
+	}
+
+	b_exists = gnstd::gn_file_stat(filePath, &size, &mtime);
+
+	p_entry = _find(identifier);
+	if (GNSDK_NULL == p_entry)
+	{
+		return kMusicIdFileManifestNew;
+	}
+	p_entry->seen = true;
+
+	/* files without a result from the last scan are identified again */
+	if (!b_exists || !_is_complete(p_entry->status) || (0 != gnstd::gn_strcmp(p_entry->path, filePath)) ||
+		(p_entry->size != size) || (p_entry->mtime != mtime))
+	{
+		return kMusicIdFileManifestChanged;
+	}
+	return kMusicIdFileManifestUnchanged;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddIfChanged
+ */
+bool
+GnMusicIdFileManifest::AddIfChanged(GnMusicIdFileInfoManager& fileInfos, gnsdk_cstr_t identifier, gnsdk_cstr_t filePath, IGnMusicIdFileInfoEvents* pEventHandler) throw (GnError)
+{
+	if (kMusicIdFileManifestUnchanged == Check(identifier, filePath))
+	{
+		return false;
+	}
+
+	GnMusicIdFileInfo fileinfo = fileInfos.Add(identifier, pEventHandler);
+
+	fileinfo.FileName(filePath);
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Record
+ */
+void
+GnMusicIdFileManifest::Record(GnMusicIdFileInfo& fileInfo) throw (GnError)
+{
+	gnsdk_cstr_t	identifier = fileInfo.Identifier();
+	gnsdk_cstr_t	path       = fileInfo.FileName();
+	entry*			p_entry;
+
+	if ((GNSDK_NULL == identifier) || (0 == *identifier))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "File info has no identifier");
+	}
+
+	p_entry = _find(identifier);
+	if (GNSDK_NULL == p_entry)
+	{
+		p_entry = _add(identifier);
+	}
+	p_entry->seen = true;
+
+	_replace_string(&p_entry->path, path);
+	if (!path || !gnstd::gn_file_stat(path, &p_entry->size, &p_entry->mtime))
+	{
+		p_entry->size  = 0;
+		p_entry->mtime = 0;
+	}
+
+	p_entry->status = fileInfo.Status();
+	_replace_string(&p_entry->tui, fileInfo.Tui());
+	_replace_string(&p_entry->mui, fileInfo.Mui());
+
+	delete [] p_entry->response;
+	p_entry->response        = GNSDK_NULL;
+	p_entry->response_offset = 0;
+	p_entry->response_length = 0;
+
+	if ((kMusicIdFileInfoStatusResultSingle == p_entry->status) || (kMusicIdFileInfoStatusResultAll == p_entry->status))
+	{
+		/* queries run for match responses have no album response to keep */
+		try
+		{
+			GnString serialized = fileInfo.AlbumResponse().Serialize();
+
+			p_entry->response = _copy_string(serialized);
+		}
+		catch (GnError&)
+		{
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Record
+ */
+void
+GnMusicIdFileManifest::Record(GnMusicIdFileInfoManager& fileInfos) throw (GnError)
+{
+	musicid_file_info_iterator it  = fileInfos.begin();
+	musicid_file_info_iterator end = fileInfos.end();
+
+	for (; it != end; ++it)
+	{
+		Record(*it);
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Save
+ */
+void
+GnMusicIdFileManifest::Save() throw (GnError)
+{
+	gnsdk_size_t	length   = gnstd::gn_strlen(path_);
+	char*			tmp_path = new char[length + 5];
+	char			buffer[MANIFEST_COPY_SIZE];
+	FILE*			out;
+	bool			b_ok;
+
+	gnstd::gn_strcpy(tmp_path, length + 5, path_);
+	gnstd::gn_strcpy(tmp_path + length, 5, ".tmp");
+
+	out  = fopen(tmp_path, "wb");
+	b_ok = (GNSDK_NULL != out);
+	if (b_ok)
+	{
+		b_ok = (EOF != fputs(MANIFEST_MAGIC "\n", out));
+
+		for (gnsdk_uint32_t i = 0; b_ok && (i < count_); i++)
+		{
+			const entry* p_entry = entries_[i];
+
+			if (!p_entry->seen)
+			{
+				continue;
+			}
+
+			b_ok = _write_escaped(out, p_entry->identifier) && (EOF != fputc('\t', out)) &&
+				   _write_escaped(out, p_entry->path) && (EOF != fputc('\t', out)) &&
+				   _write_uint64(out, p_entry->size) && (EOF != fputc('\t', out)) &&
+				   _write_uint64(out, p_entry->mtime) && (EOF != fputc('\t', out)) &&
+				   _write_uint64(out, (gnsdk_uint64_t)p_entry->status) && (EOF != fputc('\t', out)) &&
+				   _write_escaped(out, p_entry->tui) && (EOF != fputc('\t', out)) &&
+				   _write_escaped(out, p_entry->mui) && (EOF != fputc('\t', out));
+
+			if (b_ok && p_entry->response)
+			{
+				b_ok = _write_escaped(out, p_entry->response);
+			}
+			else if (b_ok && p_entry->response_length)
+			{
+				/* still escaped as read, copied over unchanged */
+				gnsdk_uint32_t remaining = p_entry->response_length;
+
+				b_ok = gnstd::gn_fseek(file_, p_entry->response_offset);
+				while (b_ok && remaining)
+				{
+					gnsdk_size_t chunk = (remaining < sizeof(buffer)) ? remaining : sizeof(buffer);
+
+					b_ok = (1 == fread(buffer, chunk, 1, (FILE*)file_)) && (1 == fwrite(buffer, chunk, 1, out));
+					remaining -= (gnsdk_uint32_t)chunk;
+				}
+			}
+
+			b_ok = b_ok && (EOF != fputc('\n', out));
+		}
+
+		if (0 != fclose(out))
+		{
+			b_ok = false;
+		}
+	}
+
+	if (!b_ok)
+	{
+		remove(tmp_path);
+		delete [] tmp_path;
+		throw GnError(GNSDKERR_IOError, "Failed to write manifest file");
+	}
+
+	/* responses are read from the old file until it is replaced */
+	if (file_)
+	{
+		fclose((FILE*)file_);
+		file_ = GNSDK_NULL;
+	}
+
+	b_ok = gnstd::gn_file_replace(tmp_path, path_);
+	if (!b_ok)
+	{
+		remove(tmp_path);
+	}
+	delete [] tmp_path;
+
+	/* reload so the next scan starts from what is on disk, the old manifest if replacing failed */
+	_clear();
+	_load();
+
+	if (!b_ok)
+	{
+		throw GnError(GNSDKERR_IOError, "Failed to replace manifest file");
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Identifier
+ */
+gnsdk_cstr_t
+GnMusicIdFileManifest::Identifier(gnsdk_uint32_t index) const
+{
+	if (index >= count_)
+	{
+		return GNSDK_NULL;
+	}
+	return entries_[index]->identifier;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Seen
+ */
+bool
+GnMusicIdFileManifest::Seen(gnsdk_cstr_t identifier) const
+{
+	entry* p_entry = _find(identifier);
+
+	return p_entry && p_entry->seen;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Status
+ */
+GnMusicIdFileInfoStatus
+GnMusicIdFileManifest::Status(gnsdk_cstr_t identifier) const
+{
+	entry* p_entry = _find(identifier);
+
+	return p_entry ? p_entry->status : kMusicIdFileInfoStatusUnprocessed;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Tui
+ */
+gnsdk_cstr_t
+GnMusicIdFileManifest::Tui(gnsdk_cstr_t identifier) const
+{
+	entry* p_entry = _find(identifier);
+
+	return p_entry ? p_entry->tui : gnstd::kEmptyString;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Mui
+ */
+gnsdk_cstr_t
+GnMusicIdFileManifest::Mui(gnsdk_cstr_t identifier) const
+{
+	entry* p_entry = _find(identifier);
+
+	return p_entry ? p_entry->mui : gnstd::kEmptyString;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AlbumResponse
+ */
+GnResponseAlbums
+GnMusicIdFileManifest::AlbumResponse(gnsdk_cstr_t identifier) throw (GnError)
+{
+	entry* p_entry = _find(identifier);
+
+	if (GNSDK_NULL == p_entry)
+	{
+		return GnResponseAlbums();
+	}
+
+	if (p_entry->response)
+	{
+		return GnDataObject::Deserialize(p_entry->response).Reflect<GnResponseAlbums>();
+	}
+
+	if ((0 == p_entry->response_length) || (GNSDK_NULL == file_))
+	{
+		return GnResponseAlbums();
+	}
+
+	char* serialized = new char[p_entry->response_length + 1];
+
+	if (!gnstd::gn_fseek(file_, p_entry->response_offset) || (1 != fread(serialized, p_entry->response_length, 1, (FILE*)file_)))
+	{
+		delete [] serialized;
+		throw GnError(GNSDKERR_IOError, "Failed to read manifest file");
+	}
+	serialized[p_entry->response_length] = 0;
+	_unescape(serialized);
+
+	try
+	{
+		GnResponseAlbums response = GnDataObject::Deserialize(serialized).Reflect<GnResponseAlbums>();
+
+		delete [] serialized;
+		return response;
+	}
+	catch (GnError&)
+	{
+		delete [] serialized;
+		throw;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _find
+ */
+GnMusicIdFileManifest::entry*
+GnMusicIdFileManifest::_find(gnsdk_cstr_t identifier) const
+{
+	if ((GNSDK_NULL == identifier) || (0 == bucket_count_))
+	{
+		return GNSDK_NULL;
+	}
+
+	gnsdk_uint32_t	hash    = _hash_string(identifier);
+	entry*			p_entry = buckets_[hash & (bucket_count_ - 1)];
+
+	while (p_entry)
+	{
+		if ((p_entry->hash == hash) && (0 == gnstd::gn_strcmp(p_entry->identifier, identifier)))
+		{
+			return p_entry;
+		}
+		p_entry = p_entry->next;
+	}
+	return GNSDK_NULL;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _add
+ */
+GnMusicIdFileManifest::entry*
+GnMusicIdFileManifest::_add(gnsdk_cstr_t identifier)
+{
+	gnsdk_uint32_t	i;
+	entry*			p_entry;
+
+	if (count_ == capacity_)
+	{
+		gnsdk_uint32_t	capacity = capacity_ ? capacity_ * 2 : MANIFEST_INITIAL_SIZE;
+		entry**			entries  = new entry*[capacity];
+
+		for (i = 0; i < count_; i++)
+		{
+			entries[i] = entries_[i];
+		}
+		delete [] entries_;
+		entries_  = entries;
+		capacity_ = capacity;
+	}
+
+	/* one bucket per entry slot keeps chains short */
+	if (bucket_count_ < capacity_)
+	{
+		delete [] buckets_;
+		bucket_count_ = capacity_;
+		buckets_      = new entry*[bucket_count_];
+
+		for (i = 0; i < bucket_count_; i++)
+		{
+			buckets_[i] = GNSDK_NULL;
+		}
+		for (i = 0; i < count_; i++)
+		{
+			gnsdk_uint32_t index = entries_[i]->hash & (bucket_count_ - 1);
+
+			entries_[i]->next = buckets_[index];
+			buckets_[index]   = entries_[i];
+		}
+	}
+
+	p_entry = new entry;
+	p_entry->identifier      = _copy_string(identifier);
+	p_entry->hash            = _hash_string(identifier);
+	p_entry->path            = _copy_string(GNSDK_NULL);
+	p_entry->size            = 0;
+	p_entry->mtime           = 0;
+	p_entry->status          = kMusicIdFileInfoStatusUnprocessed;
+	p_entry->tui             = _copy_string(GNSDK_NULL);
+	p_entry->mui             = _copy_string(GNSDK_NULL);
+	p_entry->response        = GNSDK_NULL;
+	p_entry->response_offset = 0;
+	p_entry->response_length = 0;
+	p_entry->seen            = false;
+
+	gnsdk_uint32_t index = p_entry->hash & (bucket_count_ - 1);
+
+	p_entry->next       = buckets_[index];
+	buckets_[index]     = p_entry;
+	entries_[count_++]  = p_entry;
+
+	return p_entry;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _load
+ */
+void
+GnMusicIdFileManifest::_load() throw (GnError)
+{
+	char*			line     = GNSDK_NULL;
+	gnsdk_size_t	capacity = 0;
+	gnsdk_uint64_t	offset   = 0;
+	gnsdk_size_t	consumed;
+
+	file_ = fopen(path_, "rb");
+	if (GNSDK_NULL == file_)
+	{
+		return;
+	}
+
+	/* a file that is not a manifest is treated as empty and replaced by the next save */
+	consumed = _read_line((FILE*)file_, &line, &capacity);
+	if ((0 == consumed) || (0 != gnstd::gn_strcmp(line, MANIFEST_MAGIC)))
+	{
+		delete [] line;
+		fclose((FILE*)file_);
+		file_ = GNSDK_NULL;
+		return;
+	}
+	offset += consumed;
+
+	while (0 != (consumed = _read_line((FILE*)file_, &line, &capacity)))
+	{
+		char*			fields[MANIFEST_FIELDS];
+		gnsdk_uint32_t	field = 0;
+		char*			p     = line;
+
+		fields[field++] = p;
+		for (; *p && (field < MANIFEST_FIELDS); p++)
+		{
+			if ('\t' == *p)
+			{
+				*p = 0;
+				fields[field++] = p + 1;
+			}
+		}
+
+		/* the response is the last field, skipped by lines cut short */
+		if ((MANIFEST_FIELDS == field) && (0 != *fields[0]))
+		{
+			_unescape(fields[0]);
+			if (GNSDK_NULL == _find(fields[0]))
+			{
+				entry* p_entry = _add(fields[0]);
+
+				_unescape(fields[1]);
+				_unescape(fields[5]);
+				_unescape(fields[6]);
+				_replace_string(&p_entry->path, fields[1]);
+				_replace_string(&p_entry->tui, fields[5]);
+				_replace_string(&p_entry->mui, fields[6]);
+
+				p_entry->size            = _parse_uint64(fields[2]);
+				p_entry->mtime           = _parse_uint64(fields[3]);
+				p_entry->status          = (GnMusicIdFileInfoStatus)_parse_uint64(fields[4]);
+				p_entry->response_offset = offset + (gnsdk_uint64_t)(fields[7] - line);
+				p_entry->response_length = (gnsdk_uint32_t)gnstd::gn_strlen(fields[7]);
+			}
+		}
+
+		offset += consumed;
+	}
+
+	delete [] line;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _clear
+ */
+void
+GnMusicIdFileManifest::_clear()
+{
+	for (gnsdk_uint32_t i = 0; i < count_; i++)
+	{
+		entry* p_entry = entries_[i];
+
+		delete [] p_entry->identifier;
+		delete [] p_entry->path;
+		delete [] p_entry->tui;
+		delete [] p_entry->mui;
+		delete [] p_entry->response;
+		delete p_entry;
+	}
+
+	delete [] entries_;
+	delete [] buckets_;
+	entries_      = GNSDK_NULL;
+	buckets_      = GNSDK_NULL;
+	count_        = 0;
+	capacity_     = 0;
+	bucket_count_ = 0;
+
+	if (file_)
+	{
+		fclose((FILE*)file_);
+		file_ = GNSDK_NULL;
+	}
+}
+
+
+#endif /* GNSDK_MUSICID_FILE */
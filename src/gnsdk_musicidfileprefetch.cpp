@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_musicidfileprefetch.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+
+#if GNSDK_MUSICID_FILE
+
+#include "gnsdk_musicidfileprefetch.hpp"
+
+using namespace gracenote;
+using namespace gracenote::musicid_file;
+
+
+/* initial number of file lookup buckets, doubled as files are added */
+#define PREFETCH_BUCKETS_INITIAL	64
+
+
+/******************************************************************************
+** GnMusicIdFilePrefetch internals
+*/
+
+/* One file, referenced by the lookup table and by its decode task. Guarded by the prefetch mutex. */
+class GnMusicIdFilePrefetch::item
+{
+public:
+	enum state
+	{
+		kQueued,
+		kDecoding,		/* on a prefetch worker */
+		kInline,		/* on a GNSDK thread */
+		kReady,
+		kGathered,
+		kFailed
+	};
+
+	item(const GnMusicIdFileInfo& fileInfo, IGnAudioSource& audioSource) :
+		fileinfo_(fileInfo), source_(audioSource), state_(kQueued), listed_(true), refs_(2), next_(GNSDK_NULL) { }
+
+	GnMusicIdFileInfo	fileinfo_;
+	IGnAudioSource&		source_;
+	state				state_;
+	bool				listed_;
+	gnsdk_uint32_t		refs_;
+	item*				next_;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(item);
+};
+
+
+/* Decode and fingerprint one file on a prefetch worker */
+class GnMusicIdFilePrefetch::decode_task : public gn_task
+{
+public:
+	decode_task(GnMusicIdFilePrefetch* pPrefetch, item* pItem) : prefetch_(pPrefetch), item_(pItem) { }
+
+	~decode_task() { prefetch_->_release(item_); }
+
+	void
+	run()
+	{
+		{
+			gn_lock lock(prefetch_->mutex_);
+
+			/* stay within the window, the file may be claimed by GNSDK meanwhile */
+			while ((item::kQueued == item_->state_) && !prefetch_->cancelled_ &&
+				   (prefetch_->stats_.decoding + prefetch_->stats_.ready >= prefetch_->max_ahead_))
+			{
+				prefetch_->window_cond_.wait(prefetch_->mutex_);
+			}
+
+			/* cancelled files stay queued for GNSDK to claim */
+			if ((item::kQueued != item_->state_) || prefetch_->cancelled_)
+			{
+				return;
+			}
+
+			item_->state_             = item::kDecoding;
+			prefetch_->stats_.queued   -= 1;
+			prefetch_->stats_.decoding += 1;
+		}
+
+		bool b_ok = prefetch_->_decode(item_);
+
+		{
+			gn_lock lock(prefetch_->mutex_);
+
+			prefetch_->stats_.decoding -= 1;
+			if (b_ok)
+			{
+				item_->state_ = item::kReady;
+
+				/* a file GNSDK has already processed does not hold a place in the window */
+				if (item_->listed_)
+				{
+					prefetch_->stats_.ready += 1;
+				}
+			}
+			else
+			{
+				item_->state_             = item::kFailed;
+				prefetch_->stats_.failed += 1;
+			}
+			prefetch_->window_cond_.notify_all();
+			prefetch_->done_cond_.notify_all();
+		}
+	}
+
+private:
+	GnMusicIdFilePrefetch*	prefetch_;
+	item*					item_;
+};
+
+
+/******************************************************************************
+** GnMusicIdFilePrefetch
+*/
+GnMusicIdFilePrefetch::GnMusicIdFilePrefetch(gnsdk_uint32_t threads, gnsdk_uint32_t maxAhead, gnsdk_uint32_t chunkMs) throw (GnError) :
+	buckets_(GNSDK_NULL),
+	bucket_count_(PREFETCH_BUCKETS_INITIAL),
+	item_count_(0),
+	max_ahead_(maxAhead ? maxAhead : 1),
+	chunk_ms_(chunkMs),
+	cache_(GNSDK_NULL),
+	cancelled_(false),
+	pool_(threads, 0)
+{
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_MUSICIDFILE);
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_DSP);
+
+	buckets_ = new item*[bucket_count_];
+	for (gnsdk_uint32_t i = 0; i < bucket_count_; i++)
+	{
+		buckets_[i] = GNSDK_NULL;
+	}
+}
+
+GnMusicIdFilePrefetch::~GnMusicIdFilePrefetch()
+{
+	Cancel();
+	pool_.shutdown();
+
+	for (gnsdk_uint32_t i = 0; i < bucket_count_; i++)
+	{
+		item* p_item = buckets_[i];
+
+		while (p_item)
+		{
+			item* p_next = p_item->next_;
+
+			p_item->listed_ = false;
+			_release(p_item);
+			p_item = p_next;
+		}
+	}
+	delete [] buckets_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Add
+ */
+void
+GnMusicIdFilePrefetch::Add(const GnMusicIdFileInfo& fileInfo, IGnAudioSource& audioSource) throw (GnError)
+{
+	item* p_item;
+
+	{
+		gn_lock lock(mutex_);
+
+		if (_find(fileInfo.fileInfohandle_, false))
+		{
+			throw GnError(GNSDKERR_InvalidArg, "File info already added");
+		}
+
+		p_item = new item(fileInfo, audioSource);
+		_insert(p_item);
+		stats_.queued += 1;
+	}
+
+	/* the pool is unbounded, the window is applied by the workers */
+	pool_.post(new decode_task(this, p_item));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Gather
+ */
+bool
+GnMusicIdFilePrefetch::Gather(const GnMusicIdFileInfo& fileInfo)
+{
+	item* p_item;
+	bool  b_ok;
+
+	{
+		gn_lock lock(mutex_);
+
+		p_item = _find(fileInfo.fileInfohandle_, false);
+		if (GNSDK_NULL == p_item)
+		{
+			return false;
+		}
+
+		if (item::kQueued == p_item->state_)
+		{
+			/* not started yet, decode here rather than wait behind the queue */
+			p_item->state_  = item::kInline;
+			p_item->refs_  += 1;
+			stats_.queued  -= 1;
+			stats_.inlined += 1;
+		}
+		else
+		{
+			if ((item::kDecoding == p_item->state_) || (item::kInline == p_item->state_))
+			{
+				stats_.waited += 1;
+				while ((item::kDecoding == p_item->state_) || (item::kInline == p_item->state_))
+				{
+					done_cond_.wait(mutex_);
+				}
+			}
+			else if (item::kReady == p_item->state_)
+			{
+				stats_.gathered += 1;
+			}
+
+			if (item::kReady == p_item->state_)
+			{
+				p_item->state_ = item::kGathered;
+				stats_.ready  -= 1;
+				window_cond_.notify_all();
+			}
+			return (item::kGathered == p_item->state_);
+		}
+	}
+
+	b_ok = _decode(p_item);
+
+	{
+		gn_lock lock(mutex_);
+
+		if (b_ok)
+		{
+			p_item->state_ = item::kGathered;
+		}
+		else
+		{
+			p_item->state_ = item::kFailed;
+			stats_.failed += 1;
+		}
+		done_cond_.notify_all();
+	}
+
+	_release(p_item);
+	return b_ok;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Release
+ */
+void
+GnMusicIdFilePrefetch::Release(const GnMusicIdFileInfo& fileInfo)
+{
+	item* p_item;
+
+	{
+		gn_lock lock(mutex_);
+
+		p_item = _find(fileInfo.fileInfohandle_, true);
+		if (GNSDK_NULL == p_item)
+		{
+			return;
+		}
+
+		if (item::kQueued == p_item->state_)
+		{
+			/* GNSDK no longer needs it, the decode task skips it */
+			p_item->state_ = item::kFailed;
+			stats_.queued -= 1;
+		}
+		else if (item::kReady == p_item->state_)
+		{
+			stats_.ready -= 1;
+			window_cond_.notify_all();
+		}
+		p_item->listed_ = false;
+	}
+
+	_release(p_item);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Cancel
+ */
+void
+GnMusicIdFilePrefetch::Cancel()
+{
+	gn_lock lock(mutex_);
+
+	cancelled_ = true;
+	window_cond_.notify_all();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Stats
+ */
+GnMusicIdFilePrefetchStats
+GnMusicIdFilePrefetch::Stats() const
+{
+	GnMusicIdFilePrefetchStats stats;
+
+	{
+		gn_lock lock(mutex_);
+
+		stats = stats_;
+	}
+	stats.stolen = pool_.stolen();
+
+	return stats;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _decode
+ */
+bool
+GnMusicIdFilePrefetch::_decode(item* p_item)
+{
+	/* errors are left for the event handler to deal with when GNSDK asks again */
+	try
+	{
+		if (cache_ && cache_->Lookup(p_item->fileinfo_))
+		{
+			return true;
+		}
+
+		p_item->fileinfo_.FingerprintFromSource(p_item->source_, chunk_ms_);
+	}
+	catch (GnError&)
+	{
+		return false;
+	}
+
+	if (cache_)
+	{
+		try
+		{
+			cache_->Store(p_item->fileinfo_);
+		}
+		catch (GnError&)
+		{
+		}
+	}
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _release
+ */
+void
+GnMusicIdFilePrefetch::_release(item* p_item)
+{
+	bool b_delete;
+
+	{
+		gn_lock lock(mutex_);
+
+		p_item->refs_ -= 1;
+		b_delete = (0 == p_item->refs_);
+	}
+
+	if (b_delete)
+	{
+		delete p_item;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _find
+ */
+GnMusicIdFilePrefetch::item*
+GnMusicIdFilePrefetch::_find(gnsdk_musicidfile_fileinfo_handle_t handle, bool bRemove)
+{
+	item** pp_link = &buckets_[_bucket(handle, bucket_count_)];
+
+	while (*pp_link)
+	{
+		item* p_item = *pp_link;
+
+		if (p_item->fileinfo_.fileInfohandle_ == handle)
+		{
+			if (bRemove)
+			{
+				*pp_link        = p_item->next_;
+				p_item->next_   = GNSDK_NULL;
+				item_count_    -= 1;
+			}
+			return p_item;
+		}
+		pp_link = &p_item->next_;
+	}
+	return GNSDK_NULL;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _insert
+ */
+void
+GnMusicIdFilePrefetch::_insert(item* p_item)
+{
+	gnsdk_uint32_t index;
+
+	if (item_count_ >= bucket_count_ * 2)
+	{
+		gnsdk_uint32_t	count   = bucket_count_ * 2;
+		item**			buckets = new item*[count];
+
+		for (index = 0; index < count; index++)
+		{
+			buckets[index] = GNSDK_NULL;
+		}
+
+		for (gnsdk_uint32_t i = 0; i < bucket_count_; i++)
+		{
+			item* p_chain = buckets_[i];
+
+			while (p_chain)
+			{
+				item* p_next = p_chain->next_;
+
+				index            = _bucket(p_chain->fileinfo_.fileInfohandle_, count);
+				p_chain->next_   = buckets[index];
+				buckets[index]   = p_chain;
+				p_chain          = p_next;
+			}
+		}
+
+		delete [] buckets_;
+		buckets_      = buckets;
+		bucket_count_ = count;
+	}
+
+	index           = _bucket(p_item->fileinfo_.fileInfohandle_, bucket_count_);
+	p_item->next_   = buckets_[index];
+	buckets_[index] = p_item;
+	item_count_    += 1;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _bucket
+ */
+gnsdk_uint32_t
+GnMusicIdFilePrefetch::_bucket(gnsdk_musicidfile_fileinfo_handle_t handle, gnsdk_uint32_t count)
+{
+	/* handles are heap addresses, drop the alignment bits; count is a power of two */
+	return (gnsdk_uint32_t)(((gnsdk_size_t)handle >> 4) & (count - 1));
+}
+
+
+#endif /* GNSDK_MUSICID_FILE */
@@ -0,0 +1,1158 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_musicidfilescan.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+
+#if GNSDK_MUSICID_FILE
+
+#include "gnsdk_musicidfilescan.hpp"
+#include "gnsdk_musicidfilemanifest.hpp"
+
+#if defined(GNSDK_WINDOWS)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <dirent.h>
+	#if defined(__linux__)
+		#include <sys/syscall.h>
+	#endif
+#endif
+
+using namespace gracenote;
+using namespace gracenote::musicid_file;
+
+
+#if defined(GNSDK_WINDOWS)
+	#define SCAN_PATH_SEPARATOR		'\\'
+#else
+	#define SCAN_PATH_SEPARATOR		'/'
+#endif
+
+/* directories nested deeper are skipped, guards against link cycles that cannot be detected */
+#define SCAN_MAX_DEPTH				256
+
+/* bytes of directory entries read at a time */
+#define SCAN_READ_SIZE				(64 * 1024)
+
+/* initial number of visited directory buckets, doubled as directories are added */
+#define SCAN_VISITED_INITIAL		256
+
+/* files the first batch of a scan has room for, batches grow as files are added */
+#define SCAN_BATCH_INITIAL			16
+
+
+/******************************************************************************
+** GnMusicIdFileScanner internals
+*/
+
+/* Paths of files found, packed one after the other */
+struct GnMusicIdFileScanner::batch
+{
+	char*			data;
+	gnsdk_size_t	used;
+	gnsdk_size_t	capacity;
+	gnsdk_uint32_t	count;
+	batch*			next;
+};
+
+struct GnMusicIdFileScanner::visited_dir
+{
+	gnsdk_uint64_t	device;
+	gnsdk_uint64_t	inode;
+	visited_dir*	next;
+};
+
+
+/* Read one directory on a scan worker */
+class GnMusicIdFileScanner::directory_task : public gn_task
+{
+public:
+	directory_task(GnMusicIdFileScanner* pScanner, gnsdk_cstr_t path, gnsdk_uint32_t depth) :
+		scanner_(pScanner), path_(GNSDK_NULL), depth_(depth)
+	{
+		gnsdk_size_t length = gnstd::gn_strlen(path) + 1;
+
+		path_ = new char[length];
+		gnstd::gn_strcpy(path_, length, path);
+	}
+
+	/* tasks are deleted whether or not they ran, the scan waits for every directory posted */
+	~directory_task()
+	{
+		gn_lock lock(scanner_->mutex_);
+
+		delete [] path_;
+		scanner_->pending_ -= 1;
+		if (0 == scanner_->pending_)
+		{
+			scanner_->_flush_parked();
+			scanner_->ready_cond_.notify_all();
+		}
+	}
+
+	void
+	run()
+	{
+		scanner_->_read_directory(path_, depth_);
+	}
+
+private:
+	GnMusicIdFileScanner*	scanner_;
+	char*					path_;
+	gnsdk_uint32_t			depth_;
+};
+
+
+enum scan_entry_type
+{
+	kScanEntryEnd,
+	kScanEntryError,
+	kScanEntryFile,
+	kScanEntryDirectory,
+	kScanEntryOther
+};
+
+
+/* Reads the entries of one directory, in bulk where the platform allows */
+class _scan_directory_reader
+{
+public:
+	explicit _scan_directory_reader(bool bFollow);
+	~_scan_directory_reader();
+
+	bool
+	open(gnsdk_cstr_t path);
+
+	/* device and inode of the directory, volume serial number and file index on Windows.
+	 * False if they cannot be read */
+	bool
+	identity(gnsdk_uint64_t* p_device, gnsdk_uint64_t* p_inode);
+
+	/* next entry other than . and .., the name is valid until the next call */
+	scan_entry_type
+	next(gnsdk_cstr_t* p_name);
+
+private:
+#if defined(GNSDK_WINDOWS)
+	HANDLE				find_;
+	HANDLE				dir_;
+	WIN32_FIND_DATAA	data_;
+	bool				first_;
+#else
+	scan_entry_type
+	_stat_type(gnsdk_cstr_t name);
+
+	int					fd_;
+	#if defined(__linux__)
+	char*				buffer_;
+	long				used_;
+	long				pos_;
+	#else
+	DIR*				dir_;
+	#endif
+#endif
+	bool				follow_;
+
+	DISALLOW_COPY_AND_ASSIGN(_scan_directory_reader);
+};
+
+
+static bool
+_is_dot_entry(gnsdk_cstr_t name)
+{
+	return ('.' == name[0]) && ((0 == name[1]) || (('.' == name[1]) && (0 == name[2])));
+}
+
+static char
+_lower(char c)
+{
+	return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+}
+
+static bool
+_is_directory(gnsdk_cstr_t path)
+{
+#if defined(GNSDK_WINDOWS)
+	DWORD attributes = GetFileAttributesA(path);
+
+	return (INVALID_FILE_ATTRIBUTES != attributes) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	struct stat info;
+
+	return (0 == stat(path, &info)) && S_ISDIR(info.st_mode);
+#endif
+}
+
+/* directory and name joined into a buffer grown as needed */
+static gnsdk_cstr_t
+_join(gnsdk_cstr_t directory, gnsdk_cstr_t name, char** p_buffer, gnsdk_size_t* p_capacity)
+{
+	gnsdk_size_t	dir_length  = gnstd::gn_strlen(directory);
+	gnsdk_size_t	name_length = gnstd::gn_strlen(name);
+	bool			b_separator = (dir_length > 0) && (SCAN_PATH_SEPARATOR != directory[dir_length - 1]) && ('/' != directory[dir_length - 1]);
+	gnsdk_size_t	length      = dir_length + (b_separator ? 1 : 0) + name_length + 1;
+	char*			p;
+
+	if (length > *p_capacity)
+	{
+		delete [] *p_buffer;
+		*p_capacity = length * 2;
+		*p_buffer   = new char[*p_capacity];
+	}
+
+	p = *p_buffer;
+	gnstd::gn_strcpy(p, *p_capacity, directory);
+	p += dir_length;
+	if (b_separator)
+	{
+		*p++ = SCAN_PATH_SEPARATOR;
+	}
+	gnstd::gn_strcpy(p, name_length + 1, name);
+
+	return *p_buffer;
+}
+
+
+#if defined(GNSDK_WINDOWS)
+
+_scan_directory_reader::_scan_directory_reader(bool bFollow) :
+	find_(INVALID_HANDLE_VALUE), dir_(INVALID_HANDLE_VALUE), first_(false), follow_(bFollow)
+{
+}
+
+_scan_directory_reader::~_scan_directory_reader()
+{
+	if (INVALID_HANDLE_VALUE != find_)
+	{
+		FindClose(find_);
+	}
+	if (INVALID_HANDLE_VALUE != dir_)
+	{
+		CloseHandle(dir_);
+	}
+}
+
+bool
+_scan_directory_reader::open(gnsdk_cstr_t path)
+{
+	char*			pattern  = GNSDK_NULL;
+	gnsdk_size_t	capacity = 0;
+
+	/* basic info skips the short names, large fetch asks for entries in bigger blocks */
+	find_ = FindFirstFileExA(_join(path, "*", &pattern, &capacity), FindExInfoBasic, &data_,
+							 FindExSearchNameMatch, GNSDK_NULL, FIND_FIRST_EX_LARGE_FETCH);
+	delete [] pattern;
+
+	/* identity() is only asked for when following links, which is when the handle is needed */
+	if ((INVALID_HANDLE_VALUE != find_) && follow_)
+	{
+		dir_ = CreateFileA(path, FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+						   GNSDK_NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, GNSDK_NULL);
+	}
+
+	first_ = true;
+	return (INVALID_HANDLE_VALUE != find_);
+}
+
+bool
+_scan_directory_reader::identity(gnsdk_uint64_t* p_device, gnsdk_uint64_t* p_inode)
+{
+	BY_HANDLE_FILE_INFORMATION info;
+
+	if ((INVALID_HANDLE_VALUE == dir_) || !GetFileInformationByHandle(dir_, &info))
+	{
+		return false;
+	}
+
+	/* together they identify a directory the way device and inode do, also through junctions */
+	*p_device = (gnsdk_uint64_t)info.dwVolumeSerialNumber;
+	*p_inode  = ((gnsdk_uint64_t)info.nFileIndexHigh << 32) | (gnsdk_uint64_t)info.nFileIndexLow;
+	return true;
+}
+
+scan_entry_type
+_scan_directory_reader::next(gnsdk_cstr_t* p_name)
+{
+	for (;;)
+	{
+		if (!first_ && !FindNextFileA(find_, &data_))
+		{
+			return (ERROR_NO_MORE_FILES == GetLastError()) ? kScanEntryEnd : kScanEntryError;
+		}
+		first_ = false;
+
+		if (_is_dot_entry(data_.cFileName))
+		{
+			continue;
+		}
+
+		*p_name = data_.cFileName;
+		if ((data_.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) && !follow_)
+		{
+			return kScanEntryOther;
+		}
+		return (data_.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ? kScanEntryDirectory : kScanEntryFile;
+	}
+}
+
+#else /* GNSDK_WINDOWS */
+
+#if defined(__linux__)
+
+/* entry returned by getdents64 */
+struct _scan_dirent64
+{
+	gnsdk_uint64_t	d_ino;
+	gnsdk_int64_t	d_off;
+	unsigned short	d_reclen;
+	unsigned char	d_type;
+	char			d_name[1];
+};
+
+_scan_directory_reader::_scan_directory_reader(bool bFollow) :
+	fd_(-1), buffer_(GNSDK_NULL), used_(0), pos_(0), follow_(bFollow)
+{
+}
+
+_scan_directory_reader::~_scan_directory_reader()
+{
+	if (fd_ >= 0)
+	{
+		close(fd_);
+	}
+	delete [] buffer_;
+}
+
+bool
+_scan_directory_reader::open(gnsdk_cstr_t path)
+{
+	fd_ = ::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd_ < 0)
+	{
+		return false;
+	}
+
+	buffer_ = new char[SCAN_READ_SIZE];
+	return true;
+}
+
+scan_entry_type
+_scan_directory_reader::next(gnsdk_cstr_t* p_name)
+{
+	for (;;)
+	{
+		/* many entries per call, with their types so most need no stat */
+		if (pos_ >= used_)
+		{
+			used_ = syscall(SYS_getdents64, fd_, buffer_, SCAN_READ_SIZE);
+			pos_  = 0;
+			if (used_ <= 0)
+			{
+				return (0 == used_) ? kScanEntryEnd : kScanEntryError;
+			}
+		}
+
+		const _scan_dirent64* p_entry = (const _scan_dirent64*)(buffer_ + pos_);
+
+		pos_ += p_entry->d_reclen;
+		if (_is_dot_entry(p_entry->d_name))
+		{
+			continue;
+		}
+
+		*p_name = p_entry->d_name;
+		switch (p_entry->d_type)
+		{
+			case DT_REG:		return kScanEntryFile;
+			case DT_DIR:		return kScanEntryDirectory;
+			case DT_LNK:		return follow_ ? _stat_type(p_entry->d_name) : kScanEntryOther;
+			case DT_UNKNOWN:	return _stat_type(p_entry->d_name);
+			default:			return kScanEntryOther;
+		}
+	}
+}
+
+#else /* __linux__ */
+
+_scan_directory_reader::_scan_directory_reader(bool bFollow) :
+	fd_(-1), dir_(GNSDK_NULL), follow_(bFollow)
+{
+}
+
+_scan_directory_reader::~_scan_directory_reader()
+{
+	if (dir_)
+	{
+		closedir(dir_);
+	}
+}
+
+bool
+_scan_directory_reader::open(gnsdk_cstr_t path)
+{
+	dir_ = opendir(path);
+	if (GNSDK_NULL == dir_)
+	{
+		return false;
+	}
+
+	fd_ = dirfd(dir_);
+	return true;
+}
+
+scan_entry_type
+_scan_directory_reader::next(gnsdk_cstr_t* p_name)
+{
+	for (;;)
+	{
+		struct dirent* p_entry = readdir(dir_);
+
+		if (GNSDK_NULL == p_entry)
+		{
+			return kScanEntryEnd;
+		}
+		if (_is_dot_entry(p_entry->d_name))
+		{
+			continue;
+		}
+
+		*p_name = p_entry->d_name;
+		return _stat_type(p_entry->d_name);
+	}
+}
+
+#endif /* __linux__ */
+
+bool
+_scan_directory_reader::identity(gnsdk_uint64_t* p_device, gnsdk_uint64_t* p_inode)
+{
+	struct stat info;
+
+	if (0 != fstat(fd_, &info))
+	{
+		return false;
+	}
+
+	*p_device = (gnsdk_uint64_t)info.st_dev;
+	*p_inode  = (gnsdk_uint64_t)info.st_ino;
+	return true;
+}
+
+scan_entry_type
+_scan_directory_reader::_stat_type(gnsdk_cstr_t name)
+{
+	struct stat info;
+
+	if (0 != fstatat(fd_, name, &info, AT_SYMLINK_NOFOLLOW))
+	{
+		return kScanEntryOther;
+	}
+
+	/* a link that cannot be followed, such as a dangling one, is skipped */
+	if (S_ISLNK(info.st_mode) && (!follow_ || (0 != fstatat(fd_, name, &info, 0))))
+	{
+		return kScanEntryOther;
+	}
+
+	if (S_ISREG(info.st_mode))
+	{
+		return kScanEntryFile;
+	}
+	return S_ISDIR(info.st_mode) ? kScanEntryDirectory : kScanEntryOther;
+}
+
+#endif /* GNSDK_WINDOWS */
+
+
+/******************************************************************************
+** GnMusicIdFileScanner
+*/
+GnMusicIdFileScanner::GnMusicIdFileScanner(gnsdk_uint32_t threads, gnsdk_uint32_t batchSize) throw (GnError) :
+	ready_head_(GNSDK_NULL),
+	ready_tail_(GNSDK_NULL),
+	ready_count_(0),
+	ready_max_(0),
+	pending_(0),
+	parked_(GNSDK_NULL),
+	batch_bytes_(0),
+	visited_(GNSDK_NULL),
+	visited_bucket_count_(0),
+	visited_count_(0),
+	extensions_(GNSDK_NULL),
+	extension_count_(0),
+	batch_size_(batchSize ? batchSize : 1),
+	follow_symlinks_(false),
+	manifest_(GNSDK_NULL),
+	events_(GNSDK_NULL),
+	pool_(threads, 0)
+{
+	/* enough batches to keep every worker busy while the scanning thread adds files */
+	ready_max_ = pool_.thread_count() * 4;
+}
+
+GnMusicIdFileScanner::~GnMusicIdFileScanner()
+{
+	Cancel();
+	pool_.shutdown();
+
+	_clear_visited();
+	for (gnsdk_uint32_t i = 0; i < extension_count_; i++)
+	{
+		delete [] extensions_[i];
+	}
+	delete [] extensions_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddExtension
+ */
+void
+GnMusicIdFileScanner::AddExtension(gnsdk_cstr_t extension) throw (GnError)
+{
+	if ((GNSDK_NULL == extension) || (0 == *extension) || (('.' == extension[0]) && (0 == extension[1])))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Extension required");
+	}
+
+	if ('.' == *extension)
+	{
+		extension++;
+	}
+
+	gnsdk_size_t	length = gnstd::gn_strlen(extension);
+	char*			copy   = new char[length + 1];
+	char**			extensions;
+
+	for (gnsdk_size_t i = 0; i <= length; i++)
+	{
+		copy[i] = _lower(extension[i]);
+	}
+
+	extensions = new char*[extension_count_ + 1];
+	for (gnsdk_uint32_t i = 0; i < extension_count_; i++)
+	{
+		extensions[i] = extensions_[i];
+	}
+	extensions[extension_count_] = copy;
+
+	delete [] extensions_;
+	extensions_       = extensions;
+	extension_count_ += 1;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Scan
+ */
+gnsdk_uint32_t
+GnMusicIdFileScanner::Scan(gnsdk_cstr_t rootPath, GnMusicIdFileInfoManager& fileInfos, IGnMusicIdFileInfoEvents* pEventHandler) throw (GnError)
+{
+	gn_canceller	canceller;
+	bool			b_done = false;
+	batch*			p_list = GNSDK_NULL;
+
+	if ((GNSDK_NULL == rootPath) || (0 == *rootPath))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Root path required");
+	}
+	if (!_is_directory(rootPath))
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Root path is not a directory");
+	}
+
+	{
+		gn_lock lock(mutex_);
+
+		if (pending_)
+		{
+			throw GnError(GNSDKERR_InvalidCall, "Scan already running");
+		}
+		stats_   = GnMusicIdFileScanStats();
+		pending_ = 1;
+		cancelled_.store(0);
+	}
+	_clear_visited();
+
+	pool_.post(new directory_task(this, rootPath, 0));
+
+	try
+	{
+		while (!b_done)
+		{
+			{
+				gn_lock lock(mutex_);
+
+				while ((GNSDK_NULL == ready_head_) && pending_)
+				{
+					ready_cond_.wait(mutex_);
+				}
+
+				/* no more batches once every directory has been read */
+				b_done      = (0 == pending_);
+				p_list      = ready_head_;
+				ready_head_ = GNSDK_NULL;
+				ready_tail_ = GNSDK_NULL;
+				ready_count_ = 0;
+				space_cond_.notify_all();
+			}
+
+			while (p_list)
+			{
+				batch*			p_batch   = p_list;
+				gnsdk_cstr_t	path      = p_batch->data;
+				gnsdk_uint32_t	added     = 0;
+				gnsdk_uint32_t	unchanged = 0;
+				gnsdk_uint32_t	errors    = 0;
+
+				for (gnsdk_uint32_t i = 0; (i < p_batch->count) && !cancelled_.load(); i++)
+				{
+					/* a file that cannot be added does not stop the scan */
+					try
+					{
+						if (manifest_ && !manifest_->AddIfChanged(fileInfos, path, path, pEventHandler))
+						{
+							unchanged += 1;
+						}
+						else
+						{
+							if (GNSDK_NULL == manifest_)
+							{
+								GnMusicIdFileInfo fileinfo = fileInfos.Add(path, pEventHandler);
+
+								fileinfo.FileName(path);
+							}
+							added += 1;
+						}
+					}
+					catch (GnError&)
+					{
+						errors += 1;
+					}
+
+					path += gnstd::gn_strlen(path) + 1;
+				}
+
+				/* the batch stays on the list until freed, so a throw below frees it too */
+				p_list = p_batch->next;
+				delete [] p_batch->data;
+				delete p_batch;
+
+				{
+					gn_lock lock(mutex_);
+
+					stats_.added     += added;
+					stats_.unchanged += unchanged;
+					stats_.errors    += errors;
+				}
+
+				if (events_)
+				{
+					events_->ScanProgress(Stats(), canceller);
+					if (canceller.IsCancelled())
+					{
+						Cancel();
+					}
+				}
+			}
+		}
+
+		if (events_)
+		{
+			events_->ScanProgress(Stats(), canceller);
+		}
+	}
+	catch (...)
+	{
+		/* batches already taken from the ready list */
+		while (p_list)
+		{
+			batch* p_batch = p_list;
+
+			p_list = p_batch->next;
+			delete [] p_batch->data;
+			delete p_batch;
+		}
+
+		_finish();
+		throw;
+	}
+
+	_finish();
+	return Stats().added;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Cancel
+ */
+void
+GnMusicIdFileScanner::Cancel()
+{
+	gn_lock lock(mutex_);
+
+	cancelled_.store(1);
+	space_cond_.notify_all();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Stats
+ */
+GnMusicIdFileScanStats
+GnMusicIdFileScanner::Stats() const
+{
+	gn_lock lock(mutex_);
+
+	return stats_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _read_directory
+ */
+void
+GnMusicIdFileScanner::_read_directory(gnsdk_cstr_t path, gnsdk_uint32_t depth)
+{
+	_scan_directory_reader	reader(follow_symlinks_);
+	batch*					p_batch  = GNSDK_NULL;
+	char*					buffer   = GNSDK_NULL;
+	gnsdk_size_t			capacity = 0;
+	gnsdk_uint32_t			files    = 0;
+	gnsdk_uint32_t			filtered = 0;
+	bool					b_error  = false;
+	gnsdk_uint64_t			device;
+	gnsdk_uint64_t			inode;
+	scan_entry_type			type;
+	gnsdk_cstr_t			name;
+
+	if (cancelled_.load())
+	{
+		return;
+	}
+
+	if (!reader.open(path))
+	{
+		gn_lock lock(mutex_);
+
+		stats_.errors += 1;
+		return;
+	}
+
+	/* links can reach a directory more than once, or one of its parents */
+	if (follow_symlinks_ && reader.identity(&device, &inode) && !_visit(device, inode))
+	{
+		return;
+	}
+
+	while (!cancelled_.load())
+	{
+		type = reader.next(&name);
+		if (kScanEntryEnd == type)
+		{
+			break;
+		}
+		if (kScanEntryError == type)
+		{
+			b_error = true;
+			break;
+		}
+
+		if (kScanEntryDirectory == type)
+		{
+			if (depth + 1 < SCAN_MAX_DEPTH)
+			{
+				_post(_join(path, name, &buffer, &capacity), depth + 1);
+			}
+			else
+			{
+				filtered += 1;
+			}
+		}
+		else if ((kScanEntryFile == type) && _matches(name))
+		{
+			gnsdk_cstr_t	file_path = _join(path, name, &buffer, &capacity);
+			gnsdk_size_t	length    = gnstd::gn_strlen(file_path) + 1;
+
+			if (GNSDK_NULL == p_batch)
+			{
+				p_batch = _take_batch(length);
+			}
+			if (p_batch->used + length > p_batch->capacity)
+			{
+				gnsdk_size_t	grown = (p_batch->used + length) * 2;
+				char*			data  = new char[grown];
+
+				for (gnsdk_size_t i = 0; i < p_batch->used; i++)
+				{
+					data[i] = p_batch->data[i];
+				}
+				delete [] p_batch->data;
+				p_batch->data     = data;
+				p_batch->capacity = grown;
+			}
+
+			gnstd::gn_strcpy(p_batch->data + p_batch->used, length, file_path);
+			p_batch->used  += length;
+			p_batch->count += 1;
+			files          += 1;
+
+			if (p_batch->count == batch_size_)
+			{
+				_hand_off(p_batch);
+				p_batch = GNSDK_NULL;
+			}
+		}
+		else
+		{
+			filtered += 1;
+		}
+	}
+
+	if (p_batch)
+	{
+		_park(p_batch);
+	}
+	delete [] buffer;
+
+	{
+		gn_lock lock(mutex_);
+
+		stats_.directories += 1;
+		stats_.files       += files;
+		stats_.filtered    += filtered;
+		if (b_error)
+		{
+			stats_.errors += 1;
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _post
+ */
+void
+GnMusicIdFileScanner::_post(gnsdk_cstr_t path, gnsdk_uint32_t depth)
+{
+	{
+		gn_lock lock(mutex_);
+
+		pending_ += 1;
+	}
+
+	/* the pool is unbounded so a worker never blocks posting, a task not run is still deleted */
+	pool_.post(new directory_task(this, path, depth));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _visit
+ */
+bool
+GnMusicIdFileScanner::_visit(gnsdk_uint64_t device, gnsdk_uint64_t inode)
+{
+	gn_lock			lock(mutex_);
+	gnsdk_uint32_t	index;
+
+	if (visited_count_ >= visited_bucket_count_ * 2)
+	{
+		gnsdk_uint32_t	count   = visited_bucket_count_ ? visited_bucket_count_ * 2 : SCAN_VISITED_INITIAL;
+		visited_dir**	buckets = new visited_dir*[count];
+
+		for (index = 0; index < count; index++)
+		{
+			buckets[index] = GNSDK_NULL;
+		}
+
+		for (gnsdk_uint32_t i = 0; i < visited_bucket_count_; i++)
+		{
+			visited_dir* p_chain = visited_[i];
+
+			while (p_chain)
+			{
+				visited_dir* p_next = p_chain->next;
+
+				index          = (gnsdk_uint32_t)((p_chain->inode ^ p_chain->device) & (count - 1));
+				p_chain->next  = buckets[index];
+				buckets[index] = p_chain;
+				p_chain        = p_next;
+			}
+		}
+
+		delete [] visited_;
+		visited_              = buckets;
+		visited_bucket_count_ = count;
+	}
+
+	index = (gnsdk_uint32_t)((inode ^ device) & (visited_bucket_count_ - 1));
+	for (visited_dir* p_dir = visited_[index]; p_dir; p_dir = p_dir->next)
+	{
+		if ((p_dir->inode == inode) && (p_dir->device == device))
+		{
+			return false;
+		}
+	}
+
+	visited_dir* p_dir = new visited_dir;
+
+	p_dir->device   = device;
+	p_dir->inode    = inode;
+	p_dir->next     = visited_[index];
+	visited_[index] = p_dir;
+	visited_count_ += 1;
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _matches
+ */
+bool
+GnMusicIdFileScanner::_matches(gnsdk_cstr_t name) const
+{
+	gnsdk_cstr_t extension = GNSDK_NULL;
+
+	if (0 == extension_count_)
+	{
+		return true;
+	}
+
+	for (gnsdk_cstr_t p = name; *p; p++)
+	{
+		if ('.' == *p)
+		{
+			extension = p + 1;
+		}
+	}
+	if (GNSDK_NULL == extension)
+	{
+		return false;
+	}
+
+	for (gnsdk_uint32_t i = 0; i < extension_count_; i++)
+	{
+		gnsdk_cstr_t	p = extension;
+		gnsdk_cstr_t	q = extensions_[i];
+
+		while (*p && (_lower(*p) == *q))
+		{
+			p++;
+			q++;
+		}
+		if ((0 == *p) && (0 == *q))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _take_batch
+ *  A parked batch to add files to, or a new one.
+ */
+GnMusicIdFileScanner::batch*
+GnMusicIdFileScanner::_take_batch(gnsdk_size_t length)
+{
+	batch*			p_batch;
+	gnsdk_size_t	capacity;
+
+	{
+		gn_lock lock(mutex_);
+
+		p_batch = parked_;
+		if (p_batch)
+		{
+			parked_       = p_batch->next;
+			p_batch->next = GNSDK_NULL;
+			return p_batch;
+		}
+		capacity = batch_bytes_;
+	}
+
+	/* until a batch has filled, start small rather than guess the path length of every file */
+	if (0 == capacity)
+	{
+		capacity = length * (batch_size_ < SCAN_BATCH_INITIAL ? batch_size_ : SCAN_BATCH_INITIAL);
+	}
+
+	p_batch           = new batch;
+	p_batch->capacity = capacity;
+	p_batch->data     = new char[capacity];
+	p_batch->used     = 0;
+	p_batch->count    = 0;
+	p_batch->next     = GNSDK_NULL;
+
+	return p_batch;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _park
+ *  Hold a partly filled batch for the files of the next directory read.
+ */
+void
+GnMusicIdFileScanner::_park(batch* p_batch)
+{
+	/* with no directories waiting the workers go idle, pass the files on rather than hold them */
+	if (0 == pool_.queued())
+	{
+		_hand_off(p_batch);
+		return;
+	}
+
+	gn_lock lock(mutex_);
+
+	p_batch->next = parked_;
+	parked_       = p_batch;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _flush_parked
+ *  Called with the lock held once every directory has been read. At most one batch per
+ *  worker is parked, so they are queued without waiting for space.
+ */
+void
+GnMusicIdFileScanner::_flush_parked()
+{
+	while (parked_)
+	{
+		batch* p_batch = parked_;
+
+		parked_       = p_batch->next;
+		p_batch->next = GNSDK_NULL;
+		if (ready_tail_)
+		{
+			ready_tail_->next = p_batch;
+		}
+		else
+		{
+			ready_head_ = p_batch;
+		}
+		ready_tail_   = p_batch;
+		ready_count_ += 1;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _hand_off
+ */
+void
+GnMusicIdFileScanner::_hand_off(batch* p_batch)
+{
+	{
+		gn_lock lock(mutex_);
+
+		if ((p_batch->count == batch_size_) && (p_batch->used > batch_bytes_))
+		{
+			batch_bytes_ = p_batch->used;
+		}
+
+		/* bounds memory when files are found faster than they can be added */
+		while ((ready_count_ >= ready_max_) && !cancelled_.load())
+		{
+			space_cond_.wait(mutex_);
+		}
+
+		if (!cancelled_.load())
+		{
+			if (ready_tail_)
+			{
+				ready_tail_->next = p_batch;
+			}
+			else
+			{
+				ready_head_ = p_batch;
+			}
+			ready_tail_   = p_batch;
+			ready_count_ += 1;
+			ready_cond_.notify_all();
+			return;
+		}
+	}
+
+	delete [] p_batch->data;
+	delete p_batch;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _finish
+ */
+void
+GnMusicIdFileScanner::_finish()
+{
+	gn_lock lock(mutex_);
+
+	/* after a cancel or error the workers stop early, batches still queued are dropped */
+	cancelled_.store(1);
+	space_cond_.notify_all();
+	while (pending_)
+	{
+		ready_cond_.wait(mutex_);
+	}
+
+	while (ready_head_)
+	{
+		batch* p_batch = ready_head_;
+
+		ready_head_ = p_batch->next;
+		delete [] p_batch->data;
+		delete p_batch;
+	}
+	ready_tail_  = GNSDK_NULL;
+	ready_count_ = 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _clear_visited
+ */
+void
+GnMusicIdFileScanner::_clear_visited()
+{
+	gn_lock lock(mutex_);
+
+	for (gnsdk_uint32_t i = 0; i < visited_bucket_count_; i++)
+	{
+		visited_dir* p_dir = visited_[i];
+
+		while (p_dir)
+		{
+			visited_dir* p_next = p_dir->next;
+
+			delete p_dir;
+			p_dir = p_next;
+		}
+	}
+
+	delete [] visited_;
+	visited_              = GNSDK_NULL;
+	visited_bucket_count_ = 0;
+	visited_count_        = 0;
+}
+
+
+#endif /* GNSDK_MUSICID_FILE */
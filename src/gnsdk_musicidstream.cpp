@@ -17,6 +17,7 @@
 #if GNSDK_MUSICID_STREAM
 
 #include "gnsdk_musicidstream.hpp"
+#include "gnsdk_audiobuffer.hpp"
 #include "metadata_music.hpp"
 
 
@@ -25,6 +26,10 @@ using namespace gracenote::metadata;
 using namespace gracenote::musicid_stream;
 
 
+/* Duration of audio passed to GNSDK per write unless a chunk duration is set */
+#define AUDIO_BUFFER_DURATION_MS	100
+
+
 
 
 static gnsdk_void_t GNSDK_CALLBACK_API 
@@ -306,6 +311,38 @@ GnMusicIdStreamOptions::NetworkInterface(gnsdk_cstr_t ipAddress) throw (GnError)
 	if (error) { throw GnError(); }
 }
 
+/*-----------------------------------------------------------------------------
+ *  Profile
+ */
+
+/* MusicID-Stream option keys, indexed by GnQueryProfile::gn_option */
+static const gnsdk_cstr_t s_profile_keys[GnQueryProfile::kOptionCount] =
+{
+	GNSDK_MUSICIDSTREAM_OPTION_LOOKUP_MODE,            /* kOptionLookupMode */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_CONTENT_DATA,    /* kOptionContentData */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_CLASSICAL_DATA,  /* kOptionClassicalData */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_SONIC_DATA,      /* kOptionSonicData */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_PLAYLIST,        /* kOptionPlaylist */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_EXTERNAL_IDS,    /* kOptionExternalIds */
+	GNSDK_MUSICIDSTREAM_OPTION_ENABLE_GLOBALIDS,       /* kOptionGlobalIds */
+	GNSDK_MUSICIDSTREAM_OPTION_ADDITIONAL_CREDITS,     /* kOptionAdditionalCredits */
+	GNSDK_MUSICIDSTREAM_OPTION_PREFERRED_LANG,         /* kOptionPreferredLanguage */
+	GNSDK_MUSICIDSTREAM_OPTION_RESULT_PREFER_XID,      /* kOptionPreferredExternalId */
+	GNSDK_MUSICIDSTREAM_OPTION_RESULT_PREFER_COVERART, /* kOptionPreferCoverart */
+	GNSDK_MUSICIDSTREAM_OPTION_RESULT_SINGLE,          /* kOptionResultSingle */
+	GNSDK_NULL,                                        /* kOptionRevisionCheck */
+	GNSDK_MUSICIDSTREAM_OPTION_RESULT_RANGE_START,     /* kOptionResultRangeStart */
+	GNSDK_MUSICIDSTREAM_OPTION_RESULT_RANGE_SIZE,      /* kOptionResultRangeSize */
+	GNSDK_QUERY_OPTION_NETWORK_INTERFACE               /* kOptionNetworkInterface */
+};
+
+void
+GnMusicIdStreamOptions::Profile(const GnQueryProfile& profile) throw (GnError)
+{
+	profile.apply(weakhandle_, gnsdk_musicidstream_channel_option_set, s_profile_keys);
+}
+
+
 /*-----------------------------------------------------------------------------
  *  Custom
  */
@@ -395,8 +432,6 @@ GnMusicIdStream::BuildDate()
 void
 GnMusicIdStream::AudioProcessStart(IGnAudioSource& audioSource) throw (GnError)
 {
-#define AUDIO_BUFFER_DURATION_MS 100
-	gnsdk_byte_t   *audioBuffer;
 	gnsdk_size_t audioBufferSize = 0;
 	gnsdk_error_t  error     = GNSDK_SUCCESS;
 	gnsdk_size_t bytesRead = 0;
@@ -423,23 +458,27 @@ GnMusicIdStream::AudioProcessStart(IGnAudioSource& audioSource) throw (GnError)
 		audioSource.NumberOfChannels() );
 	if (error) { throw GnError(); }
 
-	audioBufferSize = (AUDIO_BUFFER_DURATION_MS * audioSource.SamplesPerSecond() * audioSource.SampleSizeInBits()/8 * audioSource.NumberOfChannels())/1000;
-
-	audioBuffer = new gnsdk_byte_t[audioBufferSize];
+	audioBufferSize = gn_audio_reader::chunk_size(audioSource, options_.chunk_duration_ms_ ? options_.chunk_duration_ms_ : AUDIO_BUFFER_DURATION_MS);
 
 	// grab audio source which works as flag to tell rest of this class an
 	// audio pull loop is active and an audio source must be closed if audio is stopped
 	p_audioSource = &audioSource;
-	while (!error)
 	{
-		bytesRead = audioSource.GetData(audioBuffer, audioBufferSize);
-		if (bytesRead == 0)
+		// reader is scoped to the pull loop so a lent span is released before the source is closed
+		gn_audio_reader		audioReader(audioSource, audioBufferSize);
+		const gnsdk_byte_t*	audioData;
+
+		while (!error)
 		{
-			break;
-		}
+			bytesRead = audioReader.read(&audioData);
+			if (bytesRead == 0)
+			{
+				break;
+			}
 
-		error = gnsdk_musicidstream_channel_audio_write(get<gnsdk_musicidstream_channel_handle_t>(), audioBuffer, bytesRead);
+			error = gnsdk_musicidstream_channel_audio_write(get<gnsdk_musicidstream_channel_handle_t>(), audioData, bytesRead);
 
+		}
 	}
 	// only call end if no error and our audio source flag is still set, this indicates end was not called elsewhere
 	if (!error && p_audioSource)
@@ -453,8 +492,6 @@ GnMusicIdStream::AudioProcessStart(IGnAudioSource& audioSource) throw (GnError)
 		audioSource.SourceClose();
 	}
 
-	delete [] audioBuffer;
-
 	/* Lets not throw from here unless its a serious issue. */
 	if ((MIDSWARN_NotReady!= error) && GNSDKERR_SEVERE(error)) { throw GnError(); }
 }
@@ -789,5 +826,670 @@ callback_completed_with_error(
 }
 
 
+
+/******************************************************************************
+** GnMusicIdStreamPool
+*/
+
+/* Time a worker sleeps once every queued channel has been found without audio ready */
+#define MIDS_POOL_IDLE_POLL_MS		10
+
+/*
+ * Told when a queued callback task is done with its delegate, run or not
+ */
+class _mids_pool_callback_owner
+{
+public:
+	virtual
+	~_mids_pool_callback_owner() { }
+
+	virtual void
+	callback_done() = 0;
+};
+
+/*
+ * Delivers an album result on a callback thread. The result holds a reference
+ * to the response so it outlives the identification callback.
+ */
+class _mids_pool_result_task : public gn_task
+{
+public:
+	_mids_pool_result_task(_mids_pool_callback_owner* pOwner, IGnMusicIdStreamEvents* pDelegate, const GnResponseAlbums& result) :
+		owner_(pOwner), delegate_(pDelegate), result_(result) { }
+
+	~_mids_pool_result_task() { owner_->callback_done(); }
+
+	void
+	run()
+	{
+		gn_canceller canceller;
+
+		delegate_->MusicIdStreamAlbumResult(result_, canceller);
+	}
+
+private:
+	_mids_pool_callback_owner*	owner_;
+	IGnMusicIdStreamEvents*		delegate_;
+	GnResponseAlbums			result_;
+};
+
+/*
+ * Delivers an identification error on a callback thread
+ */
+class _mids_pool_error_task : public gn_task
+{
+public:
+	_mids_pool_error_task(_mids_pool_callback_owner* pOwner, IGnMusicIdStreamEvents* pDelegate, const GnError& error) :
+		owner_(pOwner), delegate_(pDelegate), error_(error) { }
+
+	~_mids_pool_error_task() { owner_->callback_done(); }
+
+	void
+	run()
+	{
+		delegate_->MusicIdStreamIdentifyCompletedWithError(error_);
+	}
+
+private:
+	_mids_pool_callback_owner*	owner_;
+	IGnMusicIdStreamEvents*		delegate_;
+	GnError						error_;
+};
+
+
+/*
+ * A pooled channel. Acts as the event delegate of its GnMusicIdStream, forwarding
+ * status events directly and queueing results for the callback threads.
+ */
+class GnMusicIdStreamPool::channel : public IGnMusicIdStreamEvents, public _mids_pool_callback_owner
+{
+public:
+	channel(GnMusicIdStreamPool* pPool, IGnAudioSource& audioSource, IGnMusicIdStreamEvents* pDelegate) :
+		pool_(pPool), source_(&audioSource), delegate_(pDelegate), stream_(GNSDK_NULL), reader_(GNSDK_NULL),
+		busy_(false), ended_(false), closed_(false), removing_(false), detached_(false), callbacks_pending_(0),
+		next_(GNSDK_NULL), next_ready_(GNSDK_NULL)
+	{
+	}
+
+	~channel()
+	{
+		delete reader_;
+		delete stream_;
+	}
+
+	/* end audio processing and close the audio source, once */
+	void
+	close()
+	{
+		if (closed_)
+		{
+			return;
+		}
+		closed_ = true;
+
+		/* give back any span or buffer before the source goes away */
+		delete reader_;
+		reader_ = GNSDK_NULL;
+
+		try
+		{
+			stream_->AudioProcessStop();
+		}
+		catch (GnError&)
+		{
+		}
+		source_->SourceClose();
+	}
+
+	void
+	StatusEvent(GnStatus status, gnsdk_uint32_t percentComplete, gnsdk_size_t bytesTotalSent, gnsdk_size_t bytesTotalReceived, IGnCancellable& canceller)
+	{
+		if (delegate_)
+		{
+			delegate_->StatusEvent(status, percentComplete, bytesTotalSent, bytesTotalReceived, canceller);
+		}
+	}
+
+	void
+	MusicIdStreamProcessingStatusEvent(GnMusicIdStreamProcessingStatus status, IGnCancellable& canceller)
+	{
+		if (delegate_)
+		{
+			delegate_->MusicIdStreamProcessingStatusEvent(status, canceller);
+		}
+	}
+
+	void
+	MusicIdStreamIdentifyingStatusEvent(GnMusicIdStreamIdentifyingStatus status, IGnCancellable& canceller)
+	{
+		if (delegate_)
+		{
+			delegate_->MusicIdStreamIdentifyingStatusEvent(status, canceller);
+		}
+	}
+
+	void
+	MusicIdStreamAlbumResult(GnResponseAlbums& result, IGnCancellable& canceller)
+	{
+		GNSDK_UNUSED(canceller);
+
+		if (callback_begin())
+		{
+			pool_->callbacks_.post(new _mids_pool_result_task(this, delegate_, result));
+		}
+	}
+
+	void
+	MusicIdStreamIdentifyCompletedWithError(GnError& completeError)
+	{
+		if (callback_begin())
+		{
+			pool_->callbacks_.post(new _mids_pool_error_task(this, delegate_, completeError));
+		}
+	}
+
+	/* count a callback task about to be queued, none once the channel is detached for removal */
+	bool
+	callback_begin()
+	{
+		gn_lock lock(pool_->mutex_);
+
+		if ((GNSDK_NULL == delegate_) || detached_)
+		{
+			return false;
+		}
+		callbacks_pending_ += 1;
+		return true;
+	}
+
+	void
+	callback_done()
+	{
+		gn_lock lock(pool_->mutex_);
+
+		callbacks_pending_ -= 1;
+		if (0 == callbacks_pending_)
+		{
+			pool_->idle_cond_.notify_all();
+		}
+	}
+
+	GnMusicIdStreamPool*	pool_;
+	IGnAudioSource*			source_;
+	IGnMusicIdStreamEvents*	delegate_;
+	GnMusicIdStream*		stream_;
+	gn_audio_reader*		reader_;
+
+	/* state below is guarded by the pool mutex, except ended_ which only the servicing worker touches */
+	bool					busy_;
+	bool					ended_;
+	bool					closed_;
+	bool					removing_;
+	bool					detached_;
+	gnsdk_uint32_t			callbacks_pending_;	/* callback tasks queued or running with delegate_ */
+	channel*				next_;
+	channel*				next_ready_;
+};
+
+
+class GnMusicIdStreamPool::worker : public gn_task
+{
+public:
+	worker() : pool_(GNSDK_NULL) { }
+
+	void
+	run() { pool_->_worker_run(); }
+
+	GnMusicIdStreamPool*	pool_;
+};
+
+
+GnMusicIdStreamPool::GnMusicIdStreamPool(gnsdk_uint32_t workerThreads, gnsdk_uint32_t callbackThreads, gnsdk_uint32_t callbackQueueSize) throw (GnError) :
+	channels_(GNSDK_NULL),
+	ready_head_(GNSDK_NULL),
+	ready_tail_(GNSDK_NULL),
+	channel_count_(0),
+	ready_count_(0),
+	idle_passes_(0),
+	stop_(false),
+	threads_(GNSDK_NULL),
+	workers_(GNSDK_NULL),
+	thread_count_(workerThreads ? workerThreads : gn_thread::hardware_concurrency()),
+	callbacks_(callbackThreads ? callbackThreads : 1, callbackQueueSize)
+{
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_MUSICIDSTREAM);
+	_gnsdk_internal::module_initialize(GNSDK_MODULE_DSP);
+
+	threads_ = new gn_thread[thread_count_];
+	workers_ = new worker[thread_count_];
+
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		workers_[i].pool_ = this;
+		if (!threads_[i].start(&workers_[i]))
+		{
+			{
+				gn_lock lock(mutex_);
+
+				stop_ = true;
+				ready_cond_.notify_all();
+			}
+			delete [] threads_;
+			delete [] workers_;
+			throw GnError(GNSDKERR_InitFailed, "Failed to create worker thread");
+		}
+	}
+}
+
+
+GnMusicIdStreamPool::~GnMusicIdStreamPool()
+{
+	channel* p_channel;
+
+	{
+		gn_lock lock(mutex_);
+
+		stop_ = true;
+		ready_cond_.notify_all();
+	}
+
+	/* joins workers */
+	delete [] threads_;
+	delete [] workers_;
+
+	for (p_channel = channels_; p_channel; p_channel = p_channel->next_)
+	{
+		p_channel->close();
+
+		gn_lock lock(mutex_);
+
+		p_channel->detached_ = true;
+	}
+
+	/* runs the results still queued, their tasks tell the channels so those are deleted after */
+	callbacks_.shutdown();
+
+	while (channels_)
+	{
+		p_channel = channels_;
+		channels_ = p_channel->next_;
+		delete p_channel;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddChannel
+ */
+GnMusicIdStream&
+GnMusicIdStreamPool::AddChannel(const GnUser& user, GnMusicIdStreamPreset preset, const GnLocale& locale, IGnAudioSource& audioSource, IGnMusicIdStreamEvents* pEventDelegate) throw (GnError)
+{
+	channel* p_channel = new channel(this, audioSource, pEventDelegate);
+
+	try
+	{
+		p_channel->stream_ = new GnMusicIdStream(user, preset, locale, p_channel);
+	}
+	catch (GnError&)
+	{
+		delete p_channel;
+		throw;
+	}
+
+	return _add_channel(p_channel);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddChannel
+ */
+GnMusicIdStream&
+GnMusicIdStreamPool::AddChannel(const GnUser& user, GnMusicIdStreamPreset preset, IGnAudioSource& audioSource, IGnMusicIdStreamEvents* pEventDelegate) throw (GnError)
+{
+	channel* p_channel = new channel(this, audioSource, pEventDelegate);
+
+	try
+	{
+		p_channel->stream_ = new GnMusicIdStream(user, preset, p_channel);
+	}
+	catch (GnError&)
+	{
+		delete p_channel;
+		throw;
+	}
+
+	return _add_channel(p_channel);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  RemoveChannel
+ */
+void
+GnMusicIdStreamPool::RemoveChannel(GnMusicIdStream& stream) throw (GnError)
+{
+	channel*  p_channel = GNSDK_NULL;
+	channel** pp_link;
+
+	{
+		gn_lock lock(mutex_);
+
+		for (pp_link = &channels_; *pp_link; pp_link = &(*pp_link)->next_)
+		{
+			if ((*pp_link)->stream_ == &stream)
+			{
+				p_channel = *pp_link;
+				break;
+			}
+		}
+		if ((GNSDK_NULL == p_channel) || p_channel->removing_)
+		{
+			throw GnError(GNSDKERR_NotFound, "Channel does not belong to this pool");
+		}
+
+		p_channel->removing_ = true;
+		while (p_channel->busy_)
+		{
+			idle_cond_.wait(mutex_);
+		}
+
+		/* unlink from the list of all channels; the pointer to pp_link may have moved while waiting */
+		for (pp_link = &channels_; *pp_link != p_channel; pp_link = &(*pp_link)->next_)
+		{
+		}
+		*pp_link = p_channel->next_;
+		channel_count_ -= 1;
+
+		/* unlink from the ready queue */
+		if (ready_head_ == p_channel)
+		{
+			ready_head_ = p_channel->next_ready_;
+			if (ready_tail_ == p_channel)
+			{
+				ready_tail_ = GNSDK_NULL;
+			}
+			ready_count_ -= 1;
+		}
+		else
+		{
+			for (channel* p_prev = ready_head_; p_prev; p_prev = p_prev->next_ready_)
+			{
+				if (p_prev->next_ready_ == p_channel)
+				{
+					p_prev->next_ready_ = p_channel->next_ready_;
+					if (ready_tail_ == p_channel)
+					{
+						ready_tail_ = p_prev;
+					}
+					ready_count_ -= 1;
+					break;
+				}
+			}
+		}
+	}
+
+	p_channel->close();
+
+	/* queued results hold the delegate, which the caller may free once this returns */
+	{
+		gn_lock lock(mutex_);
+
+		p_channel->detached_ = true;
+		while (p_channel->callbacks_pending_)
+		{
+			idle_cond_.wait(mutex_);
+		}
+	}
+
+	delete p_channel;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ChannelCount
+ */
+gnsdk_uint32_t
+GnMusicIdStreamPool::ChannelCount() const
+{
+	gn_lock lock(mutex_);
+
+	return channel_count_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _add_channel
+ */
+GnMusicIdStream&
+GnMusicIdStreamPool::_add_channel(channel* p_channel) throw (GnError)
+{
+	IGnAudioSource&	audioSource = *p_channel->source_;
+	gnsdk_error_t	error;
+
+	error = audioSource.SourceInit();
+	if (error)
+	{
+		gnsdk_error_info_t error_info;
+		error_info.error_api = "GnMusicIdStreamPool::AddChannel";
+		error_info.error_code = error;
+		error_info.error_description = "Failed to initialize audio source";
+		error_info.error_module = "GnMusicIdStream";
+		error_info.source_error_code = error_info.error_code;
+		error_info.source_error_module = error_info.error_module;
+
+		/* source must not be closed when initialization failed */
+		p_channel->closed_ = true;
+		delete p_channel;
+		throw GnError(&error_info);
+	}
+
+	try
+	{
+		p_channel->stream_->AudioProcessStart(audioSource.SamplesPerSecond(), audioSource.SampleSizeInBits(), audioSource.NumberOfChannels());
+	}
+	catch (GnError&)
+	{
+		p_channel->closed_ = true;
+		audioSource.SourceClose();
+		delete p_channel;
+		throw;
+	}
+
+	p_channel->reader_ = new gn_audio_reader(audioSource, gn_audio_reader::chunk_size(audioSource, chunk_duration_ms_.load() ? chunk_duration_ms_.load() : AUDIO_BUFFER_DURATION_MS));
+
+	gn_lock lock(mutex_);
+
+	p_channel->next_ = channels_;
+	channels_        = p_channel;
+	channel_count_  += 1;
+
+	if (ready_tail_)
+	{
+		ready_tail_->next_ready_ = p_channel;
+	}
+	else
+	{
+		ready_head_ = p_channel;
+	}
+	ready_tail_   = p_channel;
+	ready_count_ += 1;
+	idle_passes_  = 0;
+	ready_cond_.notify_one();
+
+	return *p_channel->stream_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _next_channel
+ *  Take the channel at the head of the ready queue, blocking while there is none.
+ *  Once every queued channel has been visited without finding audio, sleep for a
+ *  poll interval rather than spinning.
+ */
+GnMusicIdStreamPool::channel*
+GnMusicIdStreamPool::_next_channel()
+{
+	gn_lock  lock(mutex_);
+	channel* p_channel;
+
+	for (;;)
+	{
+		if (stop_)
+		{
+			return GNSDK_NULL;
+		}
+
+		if (GNSDK_NULL == ready_head_)
+		{
+			ready_cond_.wait(mutex_);
+			continue;
+		}
+
+		if (idle_passes_ >= ready_count_)
+		{
+			idle_passes_ = 0;
+			ready_cond_.wait(mutex_, MIDS_POOL_IDLE_POLL_MS);
+			continue;
+		}
+
+		p_channel   = ready_head_;
+		ready_head_ = p_channel->next_ready_;
+		if (GNSDK_NULL == ready_head_)
+		{
+			ready_tail_ = GNSDK_NULL;
+		}
+		p_channel->next_ready_ = GNSDK_NULL;
+		p_channel->busy_       = true;
+		ready_count_ -= 1;
+
+		return p_channel;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _service_channel
+ *  Move at most one buffer of audio from the channel's source to the channel.
+ *  Returns false if the source had no audio ready.
+ */
+bool
+GnMusicIdStreamPool::_service_channel(channel* p_channel)
+{
+	const gnsdk_byte_t*	audioData;
+	gnsdk_size_t		ready;
+	gnsdk_size_t		bytesRead;
+
+	ready = p_channel->source_->DataReady();
+	if (0 == ready)
+	{
+		return false;
+	}
+	if (IGnAudioSource::kDataReadyUnknown == ready)
+	{
+		ready = 0;
+	}
+
+	bytesRead = p_channel->reader_->read(&audioData, ready);
+	if (0 == bytesRead)
+	{
+		p_channel->ended_ = true;
+		return true;
+	}
+
+	try
+	{
+		p_channel->stream_->AudioProcess(audioData, bytesRead);
+	}
+	catch (GnError& e)
+	{
+		p_channel->ended_ = true;
+
+		/* as for AudioProcessStart only serious issues are reported */
+		if ((MIDSWARN_NotReady != e.ErrorCode()) && GNSDKERR_SEVERE(e.ErrorCode()) && p_channel->callback_begin())
+		{
+			callbacks_.post(new _mids_pool_error_task(p_channel, p_channel->delegate_, e));
+		}
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _release_channel
+ *  Return a serviced channel to the back of the ready queue, or close it if its
+ *  audio has ended.
+ */
+void
+GnMusicIdStreamPool::_release_channel(channel* p_channel, bool bProgressed)
+{
+	if (p_channel->ended_)
+	{
+		/* nobody else touches a busy channel, close it outside the pool lock */
+		p_channel->close();
+	}
+
+	gn_lock lock(mutex_);
+
+	p_channel->busy_ = false;
+
+	if (!p_channel->ended_ && !p_channel->removing_)
+	{
+		if (ready_tail_)
+		{
+			ready_tail_->next_ready_ = p_channel;
+		}
+		else
+		{
+			ready_head_ = p_channel;
+		}
+		ready_tail_   = p_channel;
+		ready_count_ += 1;
+	}
+
+	if (bProgressed)
+	{
+		idle_passes_ = 0;
+		ready_cond_.notify_one();
+	}
+	else
+	{
+		idle_passes_ += 1;
+	}
+
+	if (p_channel->removing_)
+	{
+		idle_cond_.notify_all();
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _worker_run
+ */
+void
+GnMusicIdStreamPool::_worker_run()
+{
+	channel*	p_channel;
+	bool		bProgressed;
+
+	while ((p_channel = _next_channel()) != GNSDK_NULL)
+	{
+		try
+		{
+			bProgressed = _service_channel(p_channel);
+		}
+		catch (...)
+		{
+			/* an audio source failing must not take the worker down */
+			p_channel->ended_ = true;
+			bProgressed       = true;
+		}
+
+		_release_channel(p_channel, bProgressed);
+	}
+}
+
+
 #endif /* GNSDK_MUSICID_STREAM */
 
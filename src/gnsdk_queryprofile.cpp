@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_queryprofile.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_queryprofile.hpp"
+#include "gnsdk_convert.hpp"
+
+using namespace gracenote;
+
+
+/* custom option array grows by this many entries */
+#define PROFILE_CUSTOM_GROW		4
+
+
+static gnsdk_cstr_t
+_bool_value(bool bEnable)
+{
+	return bEnable ? GNSDK_VALUE_TRUE : GNSDK_VALUE_FALSE;
+}
+
+
+/******************************************************************************
+** GnQueryProfile
+*/
+GnQueryProfile::GnQueryProfile() :
+	custom_(GNSDK_NULL), custom_count_(0), custom_capacity_(0)
+{
+	for (gnsdk_uint32_t i = 0; i < kOptionCount; i++)
+	{
+		values_[i] = GNSDK_NULL;
+	}
+}
+
+GnQueryProfile::GnQueryProfile(const GnQueryProfile& other) :
+	custom_(GNSDK_NULL), custom_count_(0), custom_capacity_(0)
+{
+	for (gnsdk_uint32_t i = 0; i < kOptionCount; i++)
+	{
+		values_[i] = GNSDK_NULL;
+	}
+	_copy(other);
+}
+
+GnQueryProfile&
+GnQueryProfile::operator= (const GnQueryProfile& other)
+{
+	if (this != &other)
+	{
+		Clear();
+		_copy(other);
+	}
+	return *this;
+}
+
+GnQueryProfile::~GnQueryProfile()
+{
+	Clear();
+	delete [] custom_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  LookupMode
+ */
+void
+GnQueryProfile::LookupMode(GnLookupMode lookupMode)
+{
+	gnsdk_cstr_t mode = gnconvert::_convertLookupModeCppC(lookupMode);
+
+	/* invalid modes are ignored, as by the options classes */
+	if (mode)
+	{
+		_set(kOptionLookupMode, mode);
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  LookupData
+ */
+void
+GnQueryProfile::LookupData(GnLookupData lookupData, bool bEnable)
+{
+	switch (lookupData)
+	{
+		case kLookupDataContent:
+			_set(kOptionContentData, _bool_value(bEnable));
+			break;
+
+		case kLookupDataClassical:
+			_set(kOptionClassicalData, _bool_value(bEnable));
+			break;
+
+		case kLookupDataSonicData:
+			_set(kOptionSonicData, _bool_value(bEnable));
+			break;
+
+		case kLookupDataPlaylist:
+			_set(kOptionPlaylist, _bool_value(bEnable));
+			break;
+
+		case kLookupDataExternalIds:
+			_set(kOptionExternalIds, _bool_value(bEnable));
+			break;
+
+		case kLookupDataGlobalIds:
+			_set(kOptionGlobalIds, _bool_value(bEnable));
+			break;
+
+		case kLookupDataAdditionalCredits:
+			_set(kOptionAdditionalCredits, _bool_value(bEnable));
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  PreferResultLanguage
+ */
+void
+GnQueryProfile::PreferResultLanguage(GnLanguage preferredLanguage)
+{
+	gnsdk_cstr_t language = gnconvert::_convertLangCppC(preferredLanguage);
+
+	if (language)
+	{
+		_set(kOptionPreferredLanguage, language);
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  PreferResultExternalId
+ */
+void
+GnQueryProfile::PreferResultExternalId(gnsdk_cstr_t strExternalId)
+{
+	_set(kOptionPreferredExternalId, strExternalId);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  PreferResultCoverart
+ */
+void
+GnQueryProfile::PreferResultCoverart(bool bEnable)
+{
+	_set(kOptionPreferCoverart, _bool_value(bEnable));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ResultSingle
+ */
+void
+GnQueryProfile::ResultSingle(bool bEnable)
+{
+	_set(kOptionResultSingle, _bool_value(bEnable));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  RevisionCheck
+ */
+void
+GnQueryProfile::RevisionCheck(bool bEnable)
+{
+	_set(kOptionRevisionCheck, _bool_value(bEnable));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ResultRangeStart
+ */
+void
+GnQueryProfile::ResultRangeStart(gnsdk_uint32_t resultStart)
+{
+	char buffer[16];
+
+	gnstd::gn_itoa(buffer, sizeof(buffer), resultStart);
+	_set(kOptionResultRangeStart, buffer);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ResultCount
+ */
+void
+GnQueryProfile::ResultCount(gnsdk_uint32_t resultCount)
+{
+	char buffer[16];
+
+	gnstd::gn_itoa(buffer, sizeof(buffer), resultCount);
+	_set(kOptionResultRangeSize, buffer);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  NetworkInterface
+ */
+void
+GnQueryProfile::NetworkInterface(gnsdk_cstr_t ipAddress)
+{
+	_set(kOptionNetworkInterface, ipAddress);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Custom
+ */
+void
+GnQueryProfile::Custom(gnsdk_cstr_t option, gnsdk_cstr_t value)
+{
+	gnsdk_uint32_t i;
+
+	if (GNSDK_NULL == option)
+	{
+		return;
+	}
+
+	value = gn_string_table::intern(value);
+
+	/* setting an option again replaces its value */
+	for (i = 0; i < custom_count_; i++)
+	{
+		if (0 == gnstd::gn_strcmp(custom_[i].key, option))
+		{
+			gn_string_table::release(custom_[i].value);
+			custom_[i].value = value;
+			return;
+		}
+	}
+
+	if (custom_count_ == custom_capacity_)
+	{
+		custom_option* grown = new custom_option[custom_capacity_ + PROFILE_CUSTOM_GROW];
+
+		for (i = 0; i < custom_count_; i++)
+		{
+			grown[i] = custom_[i];
+		}
+		delete [] custom_;
+		custom_           = grown;
+		custom_capacity_ += PROFILE_CUSTOM_GROW;
+	}
+
+	custom_[custom_count_].key   = gn_string_table::intern(option);
+	custom_[custom_count_].value = value;
+	custom_count_ += 1;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Custom
+ */
+void
+GnQueryProfile::Custom(gnsdk_cstr_t option, bool bEnable)
+{
+	Custom(option, _bool_value(bEnable));
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Clear
+ */
+void
+GnQueryProfile::Clear()
+{
+	gnsdk_uint32_t i;
+
+	for (i = 0; i < kOptionCount; i++)
+	{
+		gn_string_table::release(values_[i]);
+		values_[i] = GNSDK_NULL;
+	}
+
+	for (i = 0; i < custom_count_; i++)
+	{
+		gn_string_table::release(custom_[i].key);
+		gn_string_table::release(custom_[i].value);
+	}
+	custom_count_ = 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Count
+ */
+gnsdk_uint32_t
+GnQueryProfile::Count() const
+{
+	gnsdk_uint32_t count = custom_count_;
+
+	for (gnsdk_uint32_t i = 0; i < kOptionCount; i++)
+	{
+		if (values_[i])
+		{
+			count += 1;
+		}
+	}
+	return count;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  operator==
+ */
+bool
+GnQueryProfile::operator== (const GnQueryProfile& rhs) const
+{
+	gnsdk_uint32_t i;
+
+	/* values are interned, equal values share an address */
+	for (i = 0; i < kOptionCount; i++)
+	{
+		if (values_[i] != rhs.values_[i])
+		{
+			return false;
+		}
+	}
+
+	if (custom_count_ != rhs.custom_count_)
+	{
+		return false;
+	}
+
+	for (i = 0; i < custom_count_; i++)
+	{
+		if ((custom_[i].key != rhs.custom_[i].key) || (custom_[i].value != rhs.custom_[i].value))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _set
+ */
+void
+GnQueryProfile::_set(gn_option option, gnsdk_cstr_t value)
+{
+	gnsdk_cstr_t interned = gn_string_table::intern(value);
+
+	gn_string_table::release(values_[option]);
+	values_[option] = interned;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _copy
+ */
+void
+GnQueryProfile::_copy(const GnQueryProfile& other)
+{
+	gnsdk_uint32_t i;
+
+	for (i = 0; i < kOptionCount; i++)
+	{
+		values_[i] = other.values_[i] ? gn_string_table::retain(other.values_[i]) : GNSDK_NULL;
+	}
+
+	if (custom_capacity_ < other.custom_count_)
+	{
+		delete [] custom_;
+		custom_          = new custom_option[other.custom_count_];
+		custom_capacity_ = other.custom_count_;
+	}
+
+	for (i = 0; i < other.custom_count_; i++)
+	{
+		custom_[i].key   = gn_string_table::retain(other.custom_[i].key);
+		custom_[i].value = gn_string_table::retain(other.custom_[i].value);
+	}
+	custom_count_ = other.custom_count_;
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_snapshot.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "metadata_snapshot.hpp"
+
+using namespace gracenote;
+using namespace gracenote::metadata;
+
+
+#define SNAPSHOT_ARTIST_NAME	GNSDK_GDO_CHILD_ARTIST "/" GNSDK_GDO_CHILD_NAME_OFFICIAL "/" GNSDK_GDO_VALUE_DISPLAY
+#define SNAPSHOT_ARTIST_GNID	GNSDK_GDO_CHILD_ARTIST "/" GNSDK_GDO_CHILD_CONTRIBUTOR "/" GNSDK_GDO_VALUE_GNID
+#define SNAPSHOT_TITLE			GNSDK_GDO_CHILD_TITLE_OFFICIAL "/" GNSDK_GDO_VALUE_DISPLAY
+
+/* Field indices of the album and track field sets, in the order they are added */
+enum
+{
+	kAlbumTitle = 0,
+	kAlbumYear,
+	kAlbumLabel,
+	kAlbumGenre1,
+	kAlbumGenre2,
+	kAlbumGenre3,
+	kAlbumGnId,
+	kAlbumTui,
+	kAlbumTuiTag,
+	kAlbumArtistName,
+	kAlbumArtistGnId
+};
+
+enum
+{
+	kTrackTitle = 0,
+	kTrackNumber,
+	kTrackYear,
+	kTrackGenre1,
+	kTrackGenre2,
+	kTrackGenre3,
+	kTrackDuration,
+	kTrackGnId,
+	kTrackTui,
+	kTrackTuiTag,
+	kTrackArtistName,
+	kTrackArtistGnId
+};
+
+
+static void
+_snapshot_album_fields(GnFieldSet& fields) throw (GnError)
+{
+	fields.Add(SNAPSHOT_TITLE);
+	fields.Add(GNSDK_GDO_VALUE_YEAR);
+	fields.Add(GNSDK_GDO_VALUE_ALBUM_LABEL);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL1);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL2);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL3);
+	fields.Add(GNSDK_GDO_VALUE_GNID);
+	fields.Add(GNSDK_GDO_VALUE_TUI);
+	fields.Add(GNSDK_GDO_VALUE_TUI_TAG);
+	fields.Add(SNAPSHOT_ARTIST_NAME);
+	fields.Add(SNAPSHOT_ARTIST_GNID);
+}
+
+static void
+_snapshot_track_fields(GnFieldSet& fields) throw (GnError)
+{
+	fields.Add(SNAPSHOT_TITLE);
+	fields.Add(GNSDK_GDO_VALUE_TRACK_NUMBER);
+	fields.Add(GNSDK_GDO_VALUE_YEAR);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL1);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL2);
+	fields.Add(GNSDK_GDO_VALUE_GENRE_LEVEL3);
+	fields.Add(GNSDK_GDO_VALUE_DURATION);
+	fields.Add(GNSDK_GDO_VALUE_GNID);
+	fields.Add(GNSDK_GDO_VALUE_TUI);
+	fields.Add(GNSDK_GDO_VALUE_TUI_TAG);
+	fields.Add(SNAPSHOT_ARTIST_NAME);
+	fields.Add(SNAPSHOT_ARTIST_GNID);
+}
+
+
+template <typename T>
+static void
+_snapshot_reserve(T*& items, gnsdk_uint32_t count, gnsdk_uint32_t& capacity, gnsdk_uint32_t needed)
+{
+	gnsdk_uint32_t	new_capacity = capacity ? capacity : 16;
+	T*				new_items;
+
+	if (count + needed <= capacity)
+	{
+		return;
+	}
+
+	while (new_capacity < count + needed)
+	{
+		new_capacity *= 2;
+	}
+
+	new_items = new T[new_capacity];
+	for (gnsdk_uint32_t i = 0; i < count; i++)
+	{
+		new_items[i] = items[i];
+	}
+	delete [] items;
+
+	items    = new_items;
+	capacity = new_capacity;
+}
+
+static gnsdk_uint32_t
+_snapshot_pointer_hash(gnsdk_cstr_t p)
+{
+	gnsdk_size_t v = (gnsdk_size_t)p;
+
+	/* interned pointers are byte aligned only, mix the high bits down */
+	v ^= (v >> 16);
+	return (gnsdk_uint32_t)(v * 2654435761u);
+}
+
+/* contributors are keyed on their gnid, or on their name when they have none */
+static gnsdk_uint32_t
+_snapshot_contributor_hash(gnsdk_cstr_t name, gnsdk_cstr_t gnid)
+{
+	return _snapshot_pointer_hash(gnid[0] ? gnid : name);
+}
+
+
+/******************************************************************************
+** GnAlbumsSnapshot
+*/
+GnAlbumsSnapshot::GnAlbumsSnapshot() :
+	albums_(GNSDK_NULL),
+	album_count_(0),
+	album_capacity_(0),
+	tracks_(GNSDK_NULL),
+	track_count_(0),
+	track_capacity_(0),
+	contributors_(GNSDK_NULL),
+	contributor_count_(0),
+	contributor_capacity_(0),
+	contributor_slots_(GNSDK_NULL),
+	contributor_slot_count_(0)
+{
+}
+
+GnAlbumsSnapshot::GnAlbumsSnapshot(const GnResponseAlbums& response) throw (GnError) :
+	albums_(GNSDK_NULL),
+	album_count_(0),
+	album_capacity_(0),
+	tracks_(GNSDK_NULL),
+	track_count_(0),
+	track_capacity_(0),
+	contributors_(GNSDK_NULL),
+	contributor_count_(0),
+	contributor_capacity_(0),
+	contributor_slots_(GNSDK_NULL),
+	contributor_slot_count_(0)
+{
+	Add(response);
+}
+
+GnAlbumsSnapshot::~GnAlbumsSnapshot()
+{
+	Clear();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Add
+ */
+void
+GnAlbumsSnapshot::Add(const GnResponseAlbums& response) throw (GnError)
+{
+	GnFieldSet		album_fields;
+	GnFieldSet		track_fields;
+	GnFieldRecord	record;
+	gnsdk_uint32_t	count = response.ChildCount(GNSDK_GDO_CHILD_ALBUM);
+
+	/* one set of lookups serves every album of the response */
+	_snapshot_album_fields(album_fields);
+	_snapshot_track_fields(track_fields);
+
+	_snapshot_reserve(albums_, album_count_, album_capacity_, count);
+
+	for (gnsdk_uint32_t ord = 1; ord <= count; ord++)
+	{
+		_add(response.Child(GNSDK_GDO_CHILD_ALBUM, ord), album_fields, track_fields, record);
+	}
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Add
+ */
+gnsdk_uint32_t
+GnAlbumsSnapshot::Add(const GnAlbum& album) throw (GnError)
+{
+	GnFieldSet		album_fields;
+	GnFieldSet		track_fields;
+	GnFieldRecord	record;
+
+	_snapshot_album_fields(album_fields);
+	_snapshot_track_fields(track_fields);
+
+	return _add(album, album_fields, track_fields, record);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _add
+ */
+gnsdk_uint32_t
+GnAlbumsSnapshot::_add(const GnDataObject& album, const GnFieldSet& albumFields, const GnFieldSet& trackFields, GnFieldRecord& record)
+{
+	gnsdk_uint32_t	index = album_count_;
+	gnsdk_uint32_t	count;
+
+	_snapshot_reserve(albums_, album_count_, album_capacity_, 1);
+
+	album.Extract(albumFields, record);
+	{
+		GnAlbumSnapshot& a = albums_[index];
+
+		a.title     = strings_.intern(record.Value(kAlbumTitle));
+		a.year      = strings_.intern(record.Value(kAlbumYear));
+		a.label     = strings_.intern(record.Value(kAlbumLabel));
+		a.genre[0]  = strings_.intern(record.Value(kAlbumGenre1));
+		a.genre[1]  = strings_.intern(record.Value(kAlbumGenre2));
+		a.genre[2]  = strings_.intern(record.Value(kAlbumGenre3));
+		a.gnid      = strings_.intern(record.Value(kAlbumGnId));
+		a.tui       = strings_.intern(record.Value(kAlbumTui));
+		a.tui_tag   = strings_.intern(record.Value(kAlbumTuiTag));
+		a.artist    = record.Has(kAlbumArtistName) ? _contributor(record.Value(kAlbumArtistName), record.Value(kAlbumArtistGnId)) : GN_SNAPSHOT_NONE;
+		a.first_track = track_count_;
+		a.track_count = 0;
+	}
+
+	count = album.ChildCount(GNSDK_GDO_CHILD_TRACK);
+	_snapshot_reserve(tracks_, track_count_, track_capacity_, count);
+
+	for (gnsdk_uint32_t ord = 1; ord <= count; ord++)
+	{
+		GnDataObject		track = album.Child(GNSDK_GDO_CHILD_TRACK, ord);
+		GnTrackSnapshot&	t     = tracks_[track_count_];
+
+		track.Extract(trackFields, record);
+
+		t.title       = strings_.intern(record.Value(kTrackTitle));
+		t.number      = gnstd::gn_atoi(record.Value(kTrackNumber));
+		t.year        = strings_.intern(record.Value(kTrackYear));
+		t.genre[0]    = strings_.intern(record.Value(kTrackGenre1));
+		t.genre[1]    = strings_.intern(record.Value(kTrackGenre2));
+		t.genre[2]    = strings_.intern(record.Value(kTrackGenre3));
+		t.duration_ms = gnstd::gn_atoi(record.Value(kTrackDuration));
+		t.gnid        = strings_.intern(record.Value(kTrackGnId));
+		t.tui         = strings_.intern(record.Value(kTrackTui));
+		t.tui_tag     = strings_.intern(record.Value(kTrackTuiTag));
+		t.artist      = record.Has(kTrackArtistName) ? _contributor(record.Value(kTrackArtistName), record.Value(kTrackArtistGnId)) : GN_SNAPSHOT_NONE;
+		t.album       = index;
+
+		track_count_ += 1;
+	}
+
+	/* the album is published only once its tracks are complete */
+	albums_[index].track_count = track_count_ - albums_[index].first_track;
+	album_count_ += 1;
+
+	return index;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Clear
+ */
+void
+GnAlbumsSnapshot::Clear()
+{
+	delete [] albums_;
+	delete [] tracks_;
+	delete [] contributors_;
+	delete [] contributor_slots_;
+
+	albums_                 = GNSDK_NULL;
+	album_count_            = 0;
+	album_capacity_         = 0;
+	tracks_                 = GNSDK_NULL;
+	track_count_            = 0;
+	track_capacity_         = 0;
+	contributors_           = GNSDK_NULL;
+	contributor_count_      = 0;
+	contributor_capacity_   = 0;
+	contributor_slots_      = GNSDK_NULL;
+	contributor_slot_count_ = 0;
+
+	strings_.clear();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Album
+ */
+const GnAlbumSnapshot&
+GnAlbumsSnapshot::Album(gnsdk_uint32_t index) const throw (GnError)
+{
+	if (index >= album_count_)
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Album index out of range");
+	}
+
+	return albums_[index];
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Track
+ */
+const GnTrackSnapshot&
+GnAlbumsSnapshot::Track(gnsdk_uint32_t index) const throw (GnError)
+{
+	if (index >= track_count_)
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Track index out of range");
+	}
+
+	return tracks_[index];
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Contributor
+ */
+const GnContributorSnapshot&
+GnAlbumsSnapshot::Contributor(gnsdk_uint32_t index) const throw (GnError)
+{
+	if (index >= contributor_count_)
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Contributor index out of range");
+	}
+
+	return contributors_[index];
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _contributor
+ */
+gnsdk_uint32_t
+GnAlbumsSnapshot::_contributor(gnsdk_cstr_t name, gnsdk_cstr_t gnid)
+{
+	gnsdk_cstr_t	interned      = strings_.intern(name);
+	gnsdk_cstr_t	interned_gnid = strings_.intern(gnid);
+	gnsdk_uint32_t	slot;
+
+	/* keep the index table at most half full, slots hold contributor index + 1 */
+	if ((contributor_count_ + 1) * 2 > contributor_slot_count_)
+	{
+		gnsdk_uint32_t old_count = contributor_slot_count_;
+
+		delete [] contributor_slots_;
+		contributor_slot_count_ = old_count ? old_count * 2 : 64;
+		contributor_slots_      = new gnsdk_uint32_t[contributor_slot_count_];
+		for (slot = 0; slot < contributor_slot_count_; slot++)
+		{
+			contributor_slots_[slot] = 0;
+		}
+
+		for (gnsdk_uint32_t i = 0; i < contributor_count_; i++)
+		{
+			for (slot = _snapshot_contributor_hash(contributors_[i].name, contributors_[i].gnid) & (contributor_slot_count_ - 1); contributor_slots_[slot]; slot = (slot + 1) & (contributor_slot_count_ - 1))
+			{
+			}
+			contributor_slots_[slot] = i + 1;
+		}
+	}
+
+	/* interned strings are equal only if their pointers are, distinct artists sharing a name
+	 * have distinct gnids and the name only decides between contributors without one */
+	for (slot = _snapshot_contributor_hash(interned, interned_gnid) & (contributor_slot_count_ - 1); contributor_slots_[slot]; slot = (slot + 1) & (contributor_slot_count_ - 1))
+	{
+		const GnContributorSnapshot& c = contributors_[contributor_slots_[slot] - 1];
+
+		if (c.gnid == interned_gnid && (interned_gnid[0] || c.name == interned))
+		{
+			return contributor_slots_[slot] - 1;
+		}
+	}
+
+	_snapshot_reserve(contributors_, contributor_count_, contributor_capacity_, 1);
+
+	contributors_[contributor_count_].name = interned;
+	contributors_[contributor_count_].gnid = interned_gnid;
+	contributor_slots_[slot] = contributor_count_ + 1;
+
+	return contributor_count_++;
+}
@@ -14,8 +14,241 @@
 
 #include "gnsdk_std.hpp"
 
+/* Block-wise string primitives: SSE2 where the compiler targets it, a machine word at a time
+** elsewhere. Set GNWRAPPER_BLOCK_STRINGS to 0 for byte loops only, e.g. for memory checkers
+** that report the aligned reads past the terminator.
+*/
+#if !defined(GNWRAPPER_BLOCK_STRINGS)
+	#define GNWRAPPER_BLOCK_STRINGS		1
+#endif
+
+#if GNWRAPPER_BLOCK_STRINGS && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && (_M_IX86_FP >= 2) ) )
+	#define GNSTD_SSE2	1
+	#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(GNSDK_WINDOWS)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+/* blocks are read aligned and may extend past the terminator, but never into the next page */
+#define GNSTD_PAGE_SIZE		4096
+
+#if defined(__SANITIZE_ADDRESS__)
+	#define GNSTD_NO_SANITIZE	__attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+	#if __has_feature(address_sanitizer)
+		#define GNSTD_NO_SANITIZE	__attribute__((no_sanitize_address))
+	#endif
+#endif
+#if !defined(GNSTD_NO_SANITIZE)
+	#define GNSTD_NO_SANITIZE
+#endif
+
+#if defined(__GNUC__)
+	typedef gnsdk_uintptr_t __attribute__((__may_alias__))	gnstd_word_t;
+#else
+	typedef gnsdk_uintptr_t									gnstd_word_t;
+#endif
+
 using namespace gracenote;
 
+
+/*-----------------------------------------------------------------------------
+ *  _first_bit - index of the lowest set bit, mask must not be 0
+ */
+static inline gnsdk_uint32_t
+_first_bit(gnsdk_uint32_t mask)
+{
+#if defined(__GNUC__)
+	return (gnsdk_uint32_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (gnsdk_uint32_t)index;
+#else
+	gnsdk_uint32_t index = 0;
+	while (0 == (mask & 1))
+	{
+		mask >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+
+#if !GNSTD_SSE2
+/*-----------------------------------------------------------------------------
+ *  _word_has_zero - whether any byte of a word is 0
+ */
+static inline bool
+_word_has_zero(gnsdk_uintptr_t word)
+{
+	const gnsdk_uintptr_t ones  = ~(gnsdk_uintptr_t)0 / 0xFF;
+	const gnsdk_uintptr_t highs = ones << 7;
+
+	return 0 != ((word - ones) & ~word & highs);
+}
+#endif
+
+
+/*-----------------------------------------------------------------------------
+ *  _strnlen - length of s, at most max
+ */
+static GNSTD_NO_SANITIZE gnsdk_size_t
+_strnlen(gnsdk_cstr_t s, gnsdk_size_t max)
+{
+	gnsdk_cstr_t p = s;
+
+#if GNSTD_SSE2
+	const __m128i  zero   = _mm_setzero_si128();
+	gnsdk_uint32_t offset = (gnsdk_uint32_t)((gnsdk_uintptr_t)s & 15);
+	gnsdk_uint32_t mask;
+	gnsdk_size_t   len;
+
+	/* first block starts at the aligned address before s, its bytes before s are masked out */
+	p    = s - offset;
+	mask = (gnsdk_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero)) >> offset;
+	if (mask)
+	{
+		len = _first_bit(mask);
+		return (len < max) ? len : max;
+	}
+
+	for (len = 16 - offset; len < max; len += 16)
+	{
+		p   += 16;
+		mask = (gnsdk_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero));
+		if (mask)
+		{
+			len += _first_bit(mask);
+			break;
+		}
+	}
+
+	return (len < max) ? len : max;
+
+#else
+	gnsdk_cstr_t end = (max < (gnsdk_size_t)~(gnsdk_uintptr_t)s) ? s + max : (gnsdk_cstr_t)~(gnsdk_uintptr_t)0;
+
+	while ((p < end) && ((gnsdk_uintptr_t)p & (sizeof(gnstd_word_t) - 1)))
+	{
+		if (0 == *p)
+		{
+			return (gnsdk_size_t)(p - s);
+		}
+		p++;
+	}
+
+	while ((p < end) && !_word_has_zero(*(const gnstd_word_t*)p))
+	{
+		p += sizeof(gnstd_word_t);
+	}
+
+	while ((p < end) && *p)
+	{
+		p++;
+	}
+
+	return (p < end) ? (gnsdk_size_t)(p - s) : max;
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+ *  _strcmp - compare two strings a block at a time while neither block crosses a page
+ */
+static GNSTD_NO_SANITIZE gnsdk_int32_t
+_strcmp(gnsdk_cstr_t lhs, gnsdk_cstr_t rhs)
+{
+#if GNSTD_SSE2
+	const __m128i zero = _mm_setzero_si128();
+
+	for (;;)
+	{
+		if ( (((gnsdk_uintptr_t)lhs & (GNSTD_PAGE_SIZE - 1)) <= (GNSTD_PAGE_SIZE - 16))
+		  && (((gnsdk_uintptr_t)rhs & (GNSTD_PAGE_SIZE - 1)) <= (GNSTD_PAGE_SIZE - 16)) )
+		{
+			__m128i        l    = _mm_loadu_si128((const __m128i*)lhs);
+			__m128i        r    = _mm_loadu_si128((const __m128i*)rhs);
+			gnsdk_uint32_t mask;
+
+			/* bytes that differ or end lhs */
+			mask = (gnsdk_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(l, zero), _mm_xor_si128(_mm_cmpeq_epi8(l, r), _mm_set1_epi8(-1))));
+			if (mask)
+			{
+				gnsdk_uint32_t i = _first_bit(mask);
+				return lhs[i] - rhs[i];
+			}
+			lhs += 16;
+			rhs += 16;
+		}
+		else
+		{
+			if (*lhs != *rhs)
+			{
+				return *lhs - *rhs;
+			}
+			if (*lhs == '\0')
+			{
+				return 0;
+			}
+			++lhs;
+			++rhs;
+		}
+	}
+
+#else
+	/* words are only compared while both strings are equally aligned */
+	if (0 == (((gnsdk_uintptr_t)lhs ^ (gnsdk_uintptr_t)rhs) & (sizeof(gnstd_word_t) - 1)))
+	{
+		while ((gnsdk_uintptr_t)lhs & (sizeof(gnstd_word_t) - 1))
+		{
+			if (*lhs != *rhs)
+			{
+				return *lhs - *rhs;
+			}
+			if (*lhs == '\0')
+			{
+				return 0;
+			}
+			++lhs;
+			++rhs;
+		}
+
+		while ( (*(const gnstd_word_t*)lhs == *(const gnstd_word_t*)rhs) && !_word_has_zero(*(const gnstd_word_t*)lhs) )
+		{
+			lhs += sizeof(gnstd_word_t);
+			rhs += sizeof(gnstd_word_t);
+		}
+	}
+
+	while(*lhs == *rhs)
+	{
+		if (*lhs == '\0')
+		{
+			return 0;
+		}
+		++lhs;
+		++rhs;
+	}
+
+	return *lhs - *rhs;
+#endif
+}
+
+
 const char* gnstd::kEmptyString = "";
 
 bool
@@ -121,47 +354,125 @@ gnstd::gn_strcmp(gnsdk_cstr_t lhs, gnsdk_cstr_t rhs)
 	if ( (lhs == 0) || (rhs == 0) )
 		return 1;
 
-	while(*lhs == *rhs)
-	{
-		if (*lhs == '\0')
-		{
-			return 0;
-		}
-		++lhs;
-		++rhs;
-	}
-
-	return *lhs - *rhs;
+	return _strcmp(lhs, rhs);
 }
 
 gnsdk_size_t
 gnstd::gn_strlen(gnsdk_cstr_t s)
 {
-	gnsdk_size_t i = 0;
-
 	if ( GNSDK_NULL == s )
 		return 0;
 
+#if GNSTD_SSE2
+	return _strnlen(s, ~(gnsdk_size_t)0);
+#else
+	/* compilers replace this loop with the C library strlen */
+	gnsdk_size_t i = 0;
+
 	while (s[i])
 	{
 		i++;
 	}
 
 	return i;
+#endif
 }
 
 gnsdk_size_t
 gnstd::gn_strcpy(char* dest, gnsdk_size_t dest_size, gnsdk_cstr_t src)
 {
 	gnsdk_size_t count = 0;
+	gnsdk_size_t i     = 0;
 
 	if (dest && src)
 	{
-		while( ( count < dest_size ) && ( *dest++ = *src++ ) )
+		/* the terminator is copied when it fits */
+		count = _strnlen(src, dest_size);
+
+#if GNSTD_SSE2
+		/* the last block overlaps the one before it instead of finishing byte by byte */
+		if (count >= 16)
 		{
-			count++;
+			for (; i + 16 < count; i += 16)
+			{
+				_mm_storeu_si128((__m128i*)(dest + i), _mm_loadu_si128((const __m128i*)(src + i)));
+			}
+			_mm_storeu_si128((__m128i*)(dest + count - 16), _mm_loadu_si128((const __m128i*)(src + count - 16)));
+			i = count;
+		}
+		else if (count >= 8)
+		{
+			_mm_storel_epi64((__m128i*)dest, _mm_loadl_epi64((const __m128i*)src));
+			_mm_storel_epi64((__m128i*)(dest + count - 8), _mm_loadl_epi64((const __m128i*)(src + count - 8)));
+			i = count;
+		}
+#endif
+		for (; i < count; i++)
+		{
+			dest[i] = src[i];
+		}
+
+		if (count < dest_size)
+		{
+			dest[count] = 0;
 		}
 	}
 
 	return count;
 }
+
+
+/*-----------------------------------------------------------------------------
+ *  gn_file_stat
+ */
+bool
+gnstd::gn_file_stat(gnsdk_cstr_t path, gnsdk_uint64_t* p_size, gnsdk_uint64_t* p_mtime)
+{
+#if defined(GNSDK_WINDOWS)
+	struct __stat64 info;
+
+	if ((0 != _stat64(path, &info)) || (0 == (info.st_mode & _S_IFREG)))
+	{
+		return false;
+	}
+#else
+	struct stat info;
+
+	if ((0 != stat(path, &info)) || !S_ISREG(info.st_mode))
+	{
+		return false;
+	}
+#endif
+
+	*p_size  = (gnsdk_uint64_t)info.st_size;
+	*p_mtime = (gnsdk_uint64_t)info.st_mtime;
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  gn_fseek
+ */
+bool
+gnstd::gn_fseek(void* file, gnsdk_uint64_t offset)
+{
+#if defined(GNSDK_WINDOWS)
+	return 0 == _fseeki64((FILE*)file, (__int64)offset, SEEK_SET);
+#else
+	return 0 == fseeko((FILE*)file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  gn_file_replace
+ */
+bool
+gnstd::gn_file_replace(gnsdk_cstr_t src, gnsdk_cstr_t dest)
+{
+#if defined(GNSDK_WINDOWS)
+	return 0 != MoveFileExA(src, dest, MOVEFILE_REPLACE_EXISTING);
+#else
+	return 0 == rename(src, dest);
+#endif
+}
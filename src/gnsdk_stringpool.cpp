@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_stringpool.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_stringpool.hpp"
+#include "gnsdk_thread.hpp"
+
+#include <new>
+
+using namespace gracenote;
+
+
+/* Storage for interned strings, data follows the header */
+struct gn_string_pool::block
+{
+	block*			next;
+	gnsdk_size_t	size;
+	gnsdk_size_t	used;
+};
+
+
+static gnsdk_uint32_t
+_string_hash(gnsdk_cstr_t str, gnsdk_size_t* pLen)
+{
+	gnsdk_uint32_t	hash = 2166136261u;
+	gnsdk_size_t	len  = 0;
+
+	/* FNV-1a */
+	while (str[len])
+	{
+		hash ^= (gnsdk_uint8_t)str[len++];
+		hash *= 16777619u;
+	}
+
+	*pLen = len;
+	return hash;
+}
+
+
+gn_string_pool::gn_string_pool(gnsdk_size_t blockSize) :
+	blocks_(GNSDK_NULL),
+	block_size_(blockSize),
+	slots_(GNSDK_NULL),
+	slot_count_(0),
+	count_(0),
+	bytes_(0)
+{
+}
+
+gn_string_pool::~gn_string_pool()
+{
+	clear();
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  intern
+ */
+gnsdk_cstr_t
+gn_string_pool::intern(gnsdk_cstr_t str)
+{
+	gnsdk_uint32_t	hash;
+	gnsdk_uint32_t	slot;
+	gnsdk_size_t	len;
+
+	if (GNSDK_NULL == str)
+	{
+		str = gnstd::kEmptyString;
+	}
+
+	/* keep the table at most half full so probe sequences stay short */
+	if ((count_ + 1) * 2 > slot_count_)
+	{
+		_grow();
+	}
+
+	hash = _string_hash(str, &len);
+	for (slot = hash & (slot_count_ - 1); slots_[slot]; slot = (slot + 1) & (slot_count_ - 1))
+	{
+		if (0 == gnstd::gn_strcmp(slots_[slot], str))
+		{
+			return slots_[slot];
+		}
+	}
+
+	slots_[slot] = _store(str, len);
+	count_ += 1;
+
+	return slots_[slot];
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  clear
+ */
+void
+gn_string_pool::clear()
+{
+	block* p_block;
+
+	while (blocks_)
+	{
+		p_block = blocks_;
+		blocks_ = p_block->next;
+		delete [] (gnsdk_byte_t*)p_block;
+	}
+
+	delete [] slots_;
+	slots_      = GNSDK_NULL;
+	slot_count_ = 0;
+	count_      = 0;
+	bytes_      = 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _store
+ */
+gnsdk_str_t
+gn_string_pool::_store(gnsdk_cstr_t str, gnsdk_size_t len)
+{
+	block*		p_block = blocks_;
+	gnsdk_str_t	p_str;
+
+	if ((GNSDK_NULL == p_block) || (p_block->size - p_block->used < len + 1))
+	{
+		gnsdk_size_t size = (len + 1 > block_size_) ? len + 1 : block_size_;
+
+		p_block = (block*)new gnsdk_byte_t[sizeof(block) + size];
+		p_block->size = size;
+		p_block->used = 0;
+
+		/* an oversized string gets its own block behind the current one, which keeps its free space */
+		if (blocks_ && (size != block_size_))
+		{
+			p_block->next  = blocks_->next;
+			blocks_->next  = p_block;
+		}
+		else
+		{
+			p_block->next = blocks_;
+			blocks_       = p_block;
+		}
+	}
+
+	p_str = (gnsdk_str_t)(p_block + 1) + p_block->used;
+	gnstd::gn_strcpy(p_str, len + 1, str);
+	p_str[len] = 0;
+
+	p_block->used += len + 1;
+	bytes_        += len + 1;
+
+	return p_str;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _grow
+ */
+void
+gn_string_pool::_grow()
+{
+	gnsdk_cstr_t*	old_slots = slots_;
+	gnsdk_uint32_t	old_count = slot_count_;
+	gnsdk_uint32_t	slot;
+	gnsdk_size_t	len;
+
+	slot_count_ = slot_count_ ? slot_count_ * 2 : 256;
+	slots_      = new gnsdk_cstr_t[slot_count_];
+	for (slot = 0; slot < slot_count_; slot++)
+	{
+		slots_[slot] = GNSDK_NULL;
+	}
+
+	for (gnsdk_uint32_t i = 0; i < old_count; i++)
+	{
+		if (old_slots[i])
+		{
+			for (slot = _string_hash(old_slots[i], &len) & (slot_count_ - 1); slots_[slot]; slot = (slot + 1) & (slot_count_ - 1))
+			{
+			}
+			slots_[slot] = old_slots[i];
+		}
+	}
+
+	delete [] old_slots;
+}
+
+
+/******************************************************************************
+** gn_string_table
+*/
+
+/* number of independently locked parts of the table, a power of two */
+#define STRINGTABLE_SHARDS		16
+
+/* Shared string, data follows the header */
+struct gn_string_table_entry
+{
+	gn_string_table_entry*	next;
+	gn_atomic_uint32		refs;
+	gnsdk_uint32_t			hash;
+	gnsdk_size_t			length;
+	bool					listed;		/* made by intern(), in a shard */
+};
+
+struct gn_string_table_shard
+{
+	gn_string_table_shard() : buckets(GNSDK_NULL), bucket_count(0), count(0) { }
+
+	gn_mutex					lock;
+	gn_string_table_entry**		buckets;
+	gnsdk_uint32_t				bucket_count;
+	gnsdk_uint32_t				count;
+};
+
+/* constructed on first use, so strings interned by other static initializers find the table ready */
+static gn_string_table_shard*
+_string_shards()
+{
+	static gn_string_table_shard shards[STRINGTABLE_SHARDS];
+
+	return shards;
+}
+
+
+static gn_string_table_entry*
+_string_entry(gnsdk_cstr_t interned)
+{
+	return (gn_string_table_entry*)interned - 1;
+}
+
+static gn_string_table_entry*
+_string_entry_new(gnsdk_cstr_t str, gnsdk_size_t len, gnsdk_uint32_t hash, bool bListed)
+{
+	gn_string_table_entry*	p_entry;
+	gnsdk_str_t				p_str;
+
+	p_entry = new (new gnsdk_byte_t[sizeof(gn_string_table_entry) + len + 1]) gn_string_table_entry;
+	p_entry->next = GNSDK_NULL;
+	p_entry->refs.store(1);
+	p_entry->hash   = hash;
+	p_entry->length = len;
+	p_entry->listed = bListed;
+
+	p_str = (gnsdk_str_t)(p_entry + 1);
+	gnstd::gn_strcpy(p_str, len + 1, str);
+	p_str[len] = 0;
+
+	return p_entry;
+}
+
+static void
+_string_entry_delete(gn_string_table_entry* p_entry)
+{
+	p_entry->~gn_string_table_entry();
+	delete [] (gnsdk_byte_t*)p_entry;
+}
+
+static gn_string_table_shard&
+_string_shard(gnsdk_uint32_t hash)
+{
+	/* the low bits select the bucket, the high bits the shard */
+	return _string_shards()[(hash >> 28) & (STRINGTABLE_SHARDS - 1)];
+}
+
+static void
+_string_shard_grow(gn_string_table_shard& shard)
+{
+	gnsdk_uint32_t				bucket_count = shard.bucket_count ? shard.bucket_count * 2 : 64;
+	gn_string_table_entry**		buckets      = new gn_string_table_entry*[bucket_count];
+	gn_string_table_entry*		p_entry;
+	gnsdk_uint32_t				i;
+
+	for (i = 0; i < bucket_count; i++)
+	{
+		buckets[i] = GNSDK_NULL;
+	}
+
+	for (i = 0; i < shard.bucket_count; i++)
+	{
+		while (shard.buckets[i])
+		{
+			p_entry          = shard.buckets[i];
+			shard.buckets[i] = p_entry->next;
+
+			p_entry->next = buckets[p_entry->hash & (bucket_count - 1)];
+			buckets[p_entry->hash & (bucket_count - 1)] = p_entry;
+		}
+	}
+
+	delete [] shard.buckets;
+	shard.buckets      = buckets;
+	shard.bucket_count = bucket_count;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  intern
+ */
+gnsdk_cstr_t
+gn_string_table::intern(gnsdk_cstr_t str)
+{
+	gn_string_table_entry*	p_entry;
+	gnsdk_size_t			len;
+	gnsdk_uint32_t			hash;
+
+	if (GNSDK_NULL == str)
+	{
+		str = gnstd::kEmptyString;
+	}
+
+	hash = _string_hash(str, &len);
+
+	gn_string_table_shard&	shard = _string_shard(hash);
+	gn_lock					lock(shard.lock);
+
+	if (shard.bucket_count)
+	{
+		for (p_entry = shard.buckets[hash & (shard.bucket_count - 1)]; p_entry; p_entry = p_entry->next)
+		{
+			if ((p_entry->hash == hash) && (p_entry->length == len) && (0 == gnstd::gn_strcmp((gnsdk_cstr_t)(p_entry + 1), str)))
+			{
+				p_entry->refs.fetch_add(1);
+				return (gnsdk_cstr_t)(p_entry + 1);
+			}
+		}
+	}
+
+	if (shard.count >= shard.bucket_count)
+	{
+		_string_shard_grow(shard);
+	}
+
+	p_entry = _string_entry_new(str, len, hash, true);
+
+	p_entry->next = shard.buckets[hash & (shard.bucket_count - 1)];
+	shard.buckets[hash & (shard.bucket_count - 1)] = p_entry;
+	shard.count += 1;
+
+	return (gnsdk_cstr_t)(p_entry + 1);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  copy
+ */
+gnsdk_cstr_t
+gn_string_table::copy(gnsdk_cstr_t str)
+{
+	if (GNSDK_NULL == str)
+	{
+		str = gnstd::kEmptyString;
+	}
+
+	return (gnsdk_cstr_t)(_string_entry_new(str, gnstd::gn_strlen(str), 0, false) + 1);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  retain
+ */
+gnsdk_cstr_t
+gn_string_table::retain(gnsdk_cstr_t interned)
+{
+	/* the caller holds a reference, so the entry cannot be freed meanwhile */
+	if (interned)
+	{
+		_string_entry(interned)->refs.fetch_add(1);
+	}
+	return interned;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  release
+ */
+void
+gn_string_table::release(gnsdk_cstr_t interned)
+{
+	gn_string_table_entry*	p_entry;
+	gn_string_table_entry**	pp_link;
+	gnsdk_uint32_t			refs;
+
+	if (GNSDK_NULL == interned)
+	{
+		return;
+	}
+
+	p_entry = _string_entry(interned);
+
+	/* copies cannot be found by intern(), whoever drops the last reference frees them. Holding the
+	 * only reference, nobody else can add one */
+	if (!p_entry->listed)
+	{
+		if ((1 == p_entry->refs.load()) || (1 == p_entry->refs.fetch_sub(1)))
+		{
+			_string_entry_delete(p_entry);
+		}
+		return;
+	}
+
+	/* dropping a reference that is not the last needs no lock. The last one is only dropped under
+	 * the shard lock so intern() never finds an entry that is being freed */
+	for (refs = p_entry->refs.load(); refs > 1; refs = p_entry->refs.load())
+	{
+		if (p_entry->refs.compare_exchange(refs, refs - 1))
+		{
+			return;
+		}
+	}
+
+	gn_string_table_shard&	shard = _string_shard(p_entry->hash);
+	gn_lock					lock(shard.lock);
+
+	if (1 != p_entry->refs.fetch_sub(1))
+	{
+		return;
+	}
+
+	for (pp_link = &shard.buckets[p_entry->hash & (shard.bucket_count - 1)]; *pp_link != p_entry; pp_link = &(*pp_link)->next)
+	{
+	}
+	*pp_link     = p_entry->next;
+	shard.count -= 1;
+
+	_string_entry_delete(p_entry);
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  length
+ */
+gnsdk_size_t
+gn_string_table::length(gnsdk_cstr_t interned)
+{
+	return interned ? _string_entry(interned)->length : 0;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  count
+ */
+gnsdk_uint32_t
+gn_string_table::count()
+{
+	gn_string_table_shard*	shards = _string_shards();
+	gnsdk_uint32_t			count  = 0;
+
+	for (gnsdk_uint32_t i = 0; i < STRINGTABLE_SHARDS; i++)
+	{
+		gn_lock lock(shards[i].lock);
+
+		count += shards[i].count;
+	}
+
+	return count;
+}
@@ -0,0 +1,820 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_thread.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_thread.hpp"
+
+#if !defined(GNSDK_WINDOWS)
+	#include <errno.h>
+	#include <time.h>
+	#include <unistd.h>
+	#include <sys/time.h>
+#endif
+
+using namespace gracenote;
+
+
+/******************************************************************************
+** gn_mutex
+*/
+#if defined(GNSDK_WINDOWS)
+
+gn_mutex::gn_mutex()		{ InitializeCriticalSection(&native_); }
+gn_mutex::~gn_mutex()		{ DeleteCriticalSection(&native_); }
+void gn_mutex::lock()		{ EnterCriticalSection(&native_); }
+void gn_mutex::unlock()		{ LeaveCriticalSection(&native_); }
+
+#else
+
+gn_mutex::gn_mutex()		{ pthread_mutex_init(&native_, GNSDK_NULL); }
+gn_mutex::~gn_mutex()		{ pthread_mutex_destroy(&native_); }
+void gn_mutex::lock()		{ pthread_mutex_lock(&native_); }
+void gn_mutex::unlock()		{ pthread_mutex_unlock(&native_); }
+
+#endif
+
+
+/******************************************************************************
+** gn_condition
+*/
+#if defined(GNSDK_WINDOWS)
+
+gn_condition::gn_condition()		{ InitializeConditionVariable(&native_); }
+gn_condition::~gn_condition()		{ }
+void gn_condition::notify_one()		{ WakeConditionVariable(&native_); }
+void gn_condition::notify_all()		{ WakeAllConditionVariable(&native_); }
+
+void
+gn_condition::wait(gn_mutex& mutex)
+{
+	SleepConditionVariableCS(&native_, &mutex.native_, INFINITE);
+}
+
+bool
+gn_condition::wait(gn_mutex& mutex, gnsdk_uint32_t timeout_ms)
+{
+	return SleepConditionVariableCS(&native_, &mutex.native_, timeout_ms) ? true : false;
+}
+
+#else
+
+gn_condition::gn_condition()		{ pthread_cond_init(&native_, GNSDK_NULL); }
+gn_condition::~gn_condition()		{ pthread_cond_destroy(&native_); }
+void gn_condition::notify_one()		{ pthread_cond_signal(&native_); }
+void gn_condition::notify_all()		{ pthread_cond_broadcast(&native_); }
+
+void
+gn_condition::wait(gn_mutex& mutex)
+{
+	pthread_cond_wait(&native_, &mutex.native_);
+}
+
+bool
+gn_condition::wait(gn_mutex& mutex, gnsdk_uint32_t timeout_ms)
+{
+	struct timeval	now;
+	struct timespec	deadline;
+
+	gettimeofday(&now, GNSDK_NULL);
+	deadline.tv_sec  = now.tv_sec + (timeout_ms / 1000);
+	deadline.tv_nsec = (now.tv_usec * 1000) + ((timeout_ms % 1000) * 1000000);
+	if (deadline.tv_nsec >= 1000000000)
+	{
+		deadline.tv_sec  += 1;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	return (ETIMEDOUT != pthread_cond_timedwait(&native_, &mutex.native_, &deadline));
+}
+
+#endif
+
+
+/******************************************************************************
+** gn_task_queue
+*/
+gn_task_queue::gn_task_queue(gnsdk_uint32_t capacity) :
+	head_(GNSDK_NULL), tail_(GNSDK_NULL), size_(0), capacity_(capacity), closed_(false)
+{
+}
+
+gn_task_queue::~gn_task_queue()
+{
+	gn_task* task;
+
+	while ((task = try_pop()) != GNSDK_NULL)
+	{
+		delete task;
+	}
+}
+
+/*-----------------------------------------------------------------------------
+ *  push
+ */
+bool
+gn_task_queue::push(gn_task* task)
+{
+	gn_lock lock(mutex_);
+
+	while (!closed_ && capacity_ && (size_ >= capacity_))
+	{
+		not_full_.wait(mutex_);
+	}
+	if (closed_)
+	{
+		return false;
+	}
+
+	_append(task);
+	return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  try_push
+ */
+bool
+gn_task_queue::try_push(gn_task* task)
+{
+	gn_lock lock(mutex_);
+
+	if (closed_ || (capacity_ && (size_ >= capacity_)))
+	{
+		return false;
+	}
+
+	_append(task);
+	return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  pop
+ */
+gn_task*
+gn_task_queue::pop()
+{
+	gn_lock  lock(mutex_);
+	gn_task* task;
+
+	while (!closed_ && (GNSDK_NULL == head_))
+	{
+		not_empty_.wait(mutex_);
+	}
+
+	task = head_;
+	if (task)
+	{
+		head_ = task->next_;
+		if (GNSDK_NULL == head_)
+		{
+			tail_ = GNSDK_NULL;
+		}
+		task->next_ = GNSDK_NULL;
+		size_ -= 1;
+		not_full_.notify_one();
+	}
+
+	return task;
+}
+
+/*-----------------------------------------------------------------------------
+ *  try_pop
+ */
+gn_task*
+gn_task_queue::try_pop()
+{
+	gn_lock  lock(mutex_);
+	gn_task* task = head_;
+
+	if (task)
+	{
+		head_ = task->next_;
+		if (GNSDK_NULL == head_)
+		{
+			tail_ = GNSDK_NULL;
+		}
+		task->next_ = GNSDK_NULL;
+		size_ -= 1;
+		not_full_.notify_one();
+	}
+
+	return task;
+}
+
+/*-----------------------------------------------------------------------------
+ *  close
+ */
+void
+gn_task_queue::close()
+{
+	gn_lock lock(mutex_);
+
+	closed_ = true;
+	not_empty_.notify_all();
+	not_full_.notify_all();
+}
+
+/*-----------------------------------------------------------------------------
+ *  size
+ */
+gnsdk_uint32_t
+gn_task_queue::size() const
+{
+	gn_lock lock(mutex_);
+
+	return size_;
+}
+
+/*-----------------------------------------------------------------------------
+ *  _append
+ */
+void
+gn_task_queue::_append(gn_task* task)
+{
+	task->next_ = GNSDK_NULL;
+	if (tail_)
+	{
+		tail_->next_ = task;
+	}
+	else
+	{
+		head_ = task;
+	}
+	tail_  = task;
+	size_ += 1;
+
+	not_empty_.notify_one();
+}
+
+
+/******************************************************************************
+** gn_thread
+*/
+#if defined(GNSDK_WINDOWS)
+
+static DWORD WINAPI
+_gn_thread_entry(LPVOID arg)
+{
+	((gn_task*)arg)->run();
+	return 0;
+}
+
+#else
+
+static void*
+_gn_thread_entry(void* arg)
+{
+	((gn_task*)arg)->run();
+	return GNSDK_NULL;
+}
+
+#endif
+
+gn_thread::gn_thread() :
+	started_(false)
+{
+}
+
+gn_thread::~gn_thread()
+{
+	join();
+}
+
+/*-----------------------------------------------------------------------------
+ *  start
+ */
+bool
+gn_thread::start(gn_task* task)
+{
+	if (started_)
+	{
+		return false;
+	}
+
+#if defined(GNSDK_WINDOWS)
+	native_  = CreateThread(GNSDK_NULL, 0, _gn_thread_entry, task, 0, &id_);
+	started_ = (GNSDK_NULL != native_);
+#else
+	started_ = (0 == pthread_create(&native_, GNSDK_NULL, _gn_thread_entry, task));
+#endif
+
+	return started_;
+}
+
+/*-----------------------------------------------------------------------------
+ *  join
+ */
+void
+gn_thread::join()
+{
+	if (!started_)
+	{
+		return;
+	}
+
+#if defined(GNSDK_WINDOWS)
+	WaitForSingleObject(native_, INFINITE);
+	CloseHandle(native_);
+#else
+	pthread_join(native_, GNSDK_NULL);
+#endif
+
+	started_ = false;
+}
+
+/*-----------------------------------------------------------------------------
+ *  is_current
+ */
+bool
+gn_thread::is_current() const
+{
+	if (!started_)
+	{
+		return false;
+	}
+
+#if defined(GNSDK_WINDOWS)
+	return (GetCurrentThreadId() == id_);
+#else
+	return (0 != pthread_equal(native_, pthread_self()));
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+ *  hardware_concurrency
+ */
+gnsdk_uint32_t
+gn_thread::hardware_concurrency()
+{
+	gnsdk_uint32_t count = 1;
+
+#if defined(GNSDK_WINDOWS)
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	count = (gnsdk_uint32_t)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (online > 0)
+	{
+		count = (gnsdk_uint32_t)online;
+	}
+#endif
+
+	return count ? count : 1;
+}
+
+/*-----------------------------------------------------------------------------
+ *  sleep
+ */
+void
+gn_thread::sleep(gnsdk_uint32_t ms)
+{
+#if defined(GNSDK_WINDOWS)
+	Sleep(ms);
+#else
+	struct timespec duration;
+
+	duration.tv_sec  = ms / 1000;
+	duration.tv_nsec = (ms % 1000) * 1000000;
+	while ((0 != nanosleep(&duration, &duration)) && (EINTR == errno))
+	{
+	}
+#endif
+}
+
+/*-----------------------------------------------------------------------------
+ *  tick_ms
+ */
+gnsdk_uint64_t
+gn_thread::tick_ms()
+{
+#if defined(GNSDK_WINDOWS)
+	return (gnsdk_uint64_t)GetTickCount64();
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((gnsdk_uint64_t)now.tv_sec * 1000) + ((gnsdk_uint64_t)now.tv_nsec / 1000000);
+#else
+	struct timeval now;
+
+	gettimeofday(&now, GNSDK_NULL);
+	return ((gnsdk_uint64_t)now.tv_sec * 1000) + ((gnsdk_uint64_t)now.tv_usec / 1000);
+#endif
+}
+
+
+/******************************************************************************
+** gn_thread_pool
+*/
+class gn_thread_pool::worker : public gn_task
+{
+public:
+	worker() : pool_(GNSDK_NULL) { }
+
+	void
+	run()
+	{
+		gn_task* task;
+
+		while ((task = pool_->queue_.pop()) != GNSDK_NULL)
+		{
+			try
+			{
+				task->run();
+			}
+			catch (...)
+			{
+			}
+			delete task;
+		}
+	}
+
+	gn_thread_pool*	pool_;
+};
+
+
+gn_thread_pool::gn_thread_pool(gnsdk_uint32_t threadCount, gnsdk_uint32_t queueCapacity) throw (GnError) :
+	queue_(queueCapacity),
+	threads_(GNSDK_NULL),
+	workers_(GNSDK_NULL),
+	thread_count_(threadCount ? threadCount : gn_thread::hardware_concurrency()),
+	shutdown_(false)
+{
+	threads_ = new gn_thread[thread_count_];
+	workers_ = new worker[thread_count_];
+
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		workers_[i].pool_ = this;
+		if (!threads_[i].start(&workers_[i]))
+		{
+			shutdown();
+			delete [] threads_;
+			delete [] workers_;
+			throw GnError(GNSDKERR_InitFailed, "Failed to create worker thread");
+		}
+	}
+}
+
+gn_thread_pool::~gn_thread_pool()
+{
+	shutdown();
+
+	delete [] threads_;
+	delete [] workers_;
+}
+
+/*-----------------------------------------------------------------------------
+ *  post
+ */
+bool
+gn_thread_pool::post(gn_task* task)
+{
+	if (!queue_.push(task))
+	{
+		delete task;
+		return false;
+	}
+	return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  try_post
+ */
+bool
+gn_thread_pool::try_post(gn_task* task)
+{
+	return queue_.try_push(task);
+}
+
+/*-----------------------------------------------------------------------------
+ *  shutdown
+ */
+void
+gn_thread_pool::shutdown()
+{
+	if (shutdown_)
+	{
+		return;
+	}
+	shutdown_ = true;
+
+	queue_.close();
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		threads_[i].join();
+	}
+}
+
+
+/******************************************************************************
+** gn_work_stealing_pool
+*/
+
+/* initial number of slots of a worker deque, doubled as needed */
+#define WORK_DEQUE_INITIAL_SIZE		16
+
+class gn_work_stealing_pool::worker : public gn_task
+{
+public:
+	worker() : pool_(GNSDK_NULL), index_(0), ring_(GNSDK_NULL), size_(0), head_(0), count_(0) { }
+	~worker() { delete [] ring_; }
+
+	void
+	run()
+	{
+		gn_task* task;
+
+		for (;;)
+		{
+			task = pool_->_take(index_);
+			if (GNSDK_NULL == task)
+			{
+				gn_lock lock(pool_->mutex_);
+
+				/* announce the sleep before looking again, a post either sees it or its task is seen here */
+				pool_->sleeping_.fetch_add(1);
+				if ((0 == pool_->queued_.fetch_add(0)) && !pool_->shutdown_.load())
+				{
+					pool_->work_cond_.wait(pool_->mutex_);
+				}
+				pool_->sleeping_.fetch_sub(1);
+
+				if ((0 == pool_->queued_.fetch_add(0)) && pool_->shutdown_.load())
+				{
+					break;
+				}
+				continue;
+			}
+
+			pool_->running_.fetch_add(1);
+			if (pool_->blocked_.fetch_add(0))
+			{
+				gn_lock lock(pool_->mutex_);
+
+				pool_->space_cond_.notify_one();
+			}
+
+			try
+			{
+				task->run();
+			}
+			catch (...)
+			{
+			}
+			delete task;
+
+			pool_->running_.fetch_sub(1);
+		}
+	}
+
+	void
+	push_back(gn_task* task)
+	{
+		gn_lock lock(mutex_);
+
+		if (count_ == size_)
+		{
+			gnsdk_uint32_t	size = size_ ? size_ * 2 : WORK_DEQUE_INITIAL_SIZE;
+			gn_task**		ring = new gn_task*[size];
+
+			for (gnsdk_uint32_t i = 0; i < count_; ++i)
+			{
+				ring[i] = ring_[(head_ + i) % size_];
+			}
+			delete [] ring_;
+			ring_ = ring;
+			size_ = size;
+			head_ = 0;
+		}
+
+		ring_[(head_ + count_) % size_] = task;
+		count_ += 1;
+	}
+
+	gn_task*
+	pop_front()
+	{
+		gn_lock		lock(mutex_);
+		gn_task*	task;
+
+		if (0 == count_)
+		{
+			return GNSDK_NULL;
+		}
+
+		task    = ring_[head_];
+		head_   = (head_ + 1) % size_;
+		count_ -= 1;
+		return task;
+	}
+
+	gn_task*
+	pop_back()
+	{
+		gn_lock lock(mutex_);
+
+		if (0 == count_)
+		{
+			return GNSDK_NULL;
+		}
+
+		count_ -= 1;
+		return ring_[(head_ + count_) % size_];
+	}
+
+	gn_work_stealing_pool*	pool_;
+	gnsdk_uint32_t			index_;
+
+private:
+	gn_mutex				mutex_;
+	gn_task**				ring_;
+	gnsdk_uint32_t			size_;
+	gnsdk_uint32_t			head_;
+	gnsdk_uint32_t			count_;
+};
+
+
+gn_work_stealing_pool::gn_work_stealing_pool(gnsdk_uint32_t threadCount, gnsdk_uint32_t queueCapacity) throw (GnError) :
+	capacity_(queueCapacity),
+	threads_(GNSDK_NULL),
+	workers_(GNSDK_NULL),
+	thread_count_(threadCount ? threadCount : gn_thread::hardware_concurrency())
+{
+	threads_ = new gn_thread[thread_count_];
+	workers_ = new worker[thread_count_];
+
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		workers_[i].pool_  = this;
+		workers_[i].index_ = i;
+		if (!threads_[i].start(&workers_[i]))
+		{
+			shutdown();
+			delete [] threads_;
+			delete [] workers_;
+			throw GnError(GNSDKERR_InitFailed, "Failed to create worker thread");
+		}
+	}
+}
+
+gn_work_stealing_pool::~gn_work_stealing_pool()
+{
+	shutdown();
+
+	delete [] threads_;
+	delete [] workers_;
+}
+
+/*-----------------------------------------------------------------------------
+ *  post
+ */
+bool
+gn_work_stealing_pool::post(gn_task* task)
+{
+	gnsdk_uint32_t index = thread_count_;
+
+	if (capacity_ && (queued_.load() >= capacity_))
+	{
+		gn_lock lock(mutex_);
+
+		blocked_.fetch_add(1);
+		while ((queued_.fetch_add(0) >= capacity_) && !shutdown_.load())
+		{
+			space_cond_.wait(mutex_);
+		}
+		blocked_.fetch_sub(1);
+	}
+	posting_.fetch_add(1);
+	if (shutdown_.fetch_add(0))
+	{
+		posting_.fetch_sub(1);
+		delete task;
+		return false;
+	}
+
+	/* a worker keeps the tasks it posts, others are spread over the workers */
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		if (threads_[i].is_current())
+		{
+			index = i;
+			break;
+		}
+	}
+	if (index == thread_count_)
+	{
+		index = next_.fetch_add(1) % thread_count_;
+	}
+
+	workers_[index].push_back(task);
+	queued_.fetch_add(1);
+	posting_.fetch_sub(1);
+
+	if (sleeping_.fetch_add(0))
+	{
+		gn_lock lock(mutex_);
+
+		work_cond_.notify_one();
+	}
+	return true;
+}
+
+/*-----------------------------------------------------------------------------
+ *  shutdown
+ */
+void
+gn_work_stealing_pool::shutdown()
+{
+	{
+		gn_lock lock(mutex_);
+
+		if (shutdown_.fetch_or(1))
+		{
+			return;
+		}
+
+		work_cond_.notify_all();
+		space_cond_.notify_all();
+	}
+
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		threads_[i].join();
+	}
+
+	/* a post that missed the shutdown may still be pushing its task */
+	while (posting_.fetch_add(0))
+	{
+		gn_thread::sleep(1);
+	}
+	_run_left();
+}
+
+/*-----------------------------------------------------------------------------
+ *  _take
+ *  Take a task off a worker's own deque, or off another's. Returns GNSDK_NULL if none was found.
+ */
+gn_task*
+gn_work_stealing_pool::_take(gnsdk_uint32_t index)
+{
+	gn_task* task;
+
+	task = workers_[index].pop_front();
+	if (GNSDK_NULL == task)
+	{
+		for (gnsdk_uint32_t i = 1; i < thread_count_; ++i)
+		{
+			task = workers_[(index + i) % thread_count_].pop_back();
+			if (task)
+			{
+				stolen_.fetch_add(1);
+				break;
+			}
+		}
+	}
+
+	if (task)
+	{
+		queued_.fetch_sub(1);
+	}
+	return task;
+}
+
+/*-----------------------------------------------------------------------------
+ *  _run_left
+ *  Run tasks posted while the workers were stopping, on the thread shutting down.
+ */
+void
+gn_work_stealing_pool::_run_left()
+{
+	gn_task* task;
+
+	for (gnsdk_uint32_t i = 0; i < thread_count_; ++i)
+	{
+		while (GNSDK_NULL != (task = workers_[i].pop_front()))
+		{
+			queued_.fetch_sub(1);
+			try
+			{
+				task->run();
+			}
+			catch (...)
+			{
+			}
+			delete task;
+		}
+	}
+}
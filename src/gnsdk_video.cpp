@@ -249,6 +249,38 @@ GnVideoOptions::NetworkInterface(gnsdk_cstr_t ipAddress) throw (GnError)
 	if (error) { throw GnError(); }
 }
 
+/*-----------------------------------------------------------------------------
+ *  Profile
+ */
+
+/* Video option keys, indexed by GnQueryProfile::gn_option */
+static const gnsdk_cstr_t s_profile_keys[GnQueryProfile::kOptionCount] =
+{
+	GNSDK_NULL,                             /* kOptionLookupMode */
+	GNSDK_VIDEO_OPTION_ENABLE_CONTENT_DATA, /* kOptionContentData */
+	GNSDK_NULL,                             /* kOptionClassicalData */
+	GNSDK_NULL,                             /* kOptionSonicData */
+	GNSDK_NULL,                             /* kOptionPlaylist */
+	GNSDK_VIDEO_OPTION_ENABLE_EXTERNAL_IDS, /* kOptionExternalIds */
+	GNSDK_NULL,                             /* kOptionGlobalIds */
+	GNSDK_NULL,                             /* kOptionAdditionalCredits */
+	GNSDK_VIDEO_OPTION_PREFERRED_LANG,      /* kOptionPreferredLanguage */
+	GNSDK_NULL,                             /* kOptionPreferredExternalId */
+	GNSDK_NULL,                             /* kOptionPreferCoverart */
+	GNSDK_NULL,                             /* kOptionResultSingle */
+	GNSDK_NULL,                             /* kOptionRevisionCheck */
+	GNSDK_VIDEO_OPTION_RESULT_RANGE_START,  /* kOptionResultRangeStart */
+	GNSDK_VIDEO_OPTION_RESULT_RANGE_SIZE,   /* kOptionResultRangeSize */
+	GNSDK_QUERY_OPTION_NETWORK_INTERFACE    /* kOptionNetworkInterface */
+};
+
+void
+GnVideoOptions::Profile(const GnQueryProfile& profile) throw (GnError)
+{
+	profile.apply(weakhandle_, gnsdk_video_query_option_set, s_profile_keys);
+}
+
+
 /**
  *  Custom
  */
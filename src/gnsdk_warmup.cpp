@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2014 Gracenote.
+ *
+ * This software may not be used in any way or distributed without
+ * permission. All rights reserved.
+ *
+ * Some code herein may be covered by US and international patents.
+ */
+
+/* gnsdk_warmup.cpp
+ *
+ * Implementation of C++ wrapper for GNSDK
+ *
+ */
+#include "gnsdk_manager.hpp"
+#include "gnsdk_warmup.hpp"
+#include "gnsdk_thread.hpp"
+
+using namespace gracenote;
+
+
+/******************************************************************************
+** GnWarmUpPlan internals
+*/
+
+/* One declared locale, list or module set and the outcome of loading it */
+class GnWarmUpPlan::item
+{
+public:
+	explicit
+	item(GnWarmUpItemType type) :
+		type_(type), modules_(0), locale_group_(kLocaleGroupInvalid), list_type_(kListTypeInvalid),
+		language_(kLanguageInvalid), region_(kRegionDefault), descriptor_(kDescriptorDefault),
+		set_default_(false), ready_(false), elapsed_ms_(0), error_(GNSDK_NULL) { }
+
+	~item() { delete error_; }
+
+	void
+	reset()
+	{
+		delete error_;
+		error_      = GNSDK_NULL;
+		ready_      = false;
+		elapsed_ms_ = 0;
+	}
+
+	void
+	load(const GnUser& user)
+	{
+		gnsdk_uint64_t start = gn_thread::tick_ms();
+
+		try
+		{
+			switch (type_)
+			{
+			case kWarmUpItemModules:
+				GnManager::Preload(modules_);
+				break;
+
+			case kWarmUpItemLocale:
+				locale_ = GnLocale(locale_group_, language_, region_, descriptor_, user);
+				if (set_default_)
+				{
+					locale_.SetGroupDefault();
+				}
+				break;
+
+			case kWarmUpItemList:
+				list_ = GnList(list_type_, language_, region_, descriptor_, user);
+				break;
+			}
+			ready_ = true;
+		}
+		catch (GnError& e)
+		{
+			error_ = new GnError(e);
+		}
+		catch (...)
+		{
+			/* nothing may escape a warm up thread, the item reports a failure instead */
+			error_ = new GnError(GNSDKERR_Unknown, "Warm up item failed to load");
+		}
+
+		elapsed_ms_ = (gnsdk_uint32_t)(gn_thread::tick_ms() - start);
+	}
+
+	GnWarmUpItemType	type_;
+	gnsdk_uint32_t		modules_;
+	GnLocaleGroup		locale_group_;
+	GnListType			list_type_;
+	GnLanguage			language_;
+	GnRegion			region_;
+	GnDescriptor		descriptor_;
+	bool				set_default_;
+
+	bool				ready_;
+	gnsdk_uint32_t		elapsed_ms_;
+	GnError*			error_;
+	GnLocale			locale_;
+	GnList				list_;
+};
+
+
+/* Loads one item on a warm up thread */
+class GnWarmUpPlan::load_task : public gn_task
+{
+public:
+	load_task(item* pItem, const GnUser& user) : item_(pItem), user_(user) { }
+
+	void
+	run() { item_->load(user_); }
+
+private:
+	item*			item_;
+	const GnUser&	user_;
+};
+
+
+/******************************************************************************
+** GnWarmUpPlan
+*/
+GnWarmUpPlan::GnWarmUpPlan() :
+	items_(GNSDK_NULL),
+	count_(0),
+	capacity_(0),
+	threads_(0),
+	elapsed_ms_(0)
+{
+}
+
+GnWarmUpPlan::~GnWarmUpPlan()
+{
+	for (gnsdk_uint32_t i = 0; i < count_; i++)
+	{
+		delete items_[i];
+	}
+	delete [] items_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Modules
+ */
+void
+GnWarmUpPlan::Modules(gnsdk_uint32_t moduleMask)
+{
+	for (gnsdk_uint32_t i = 0; i < count_; i++)
+	{
+		if (kWarmUpItemModules == items_[i]->type_)
+		{
+			items_[i]->modules_ |= moduleMask;
+			return;
+		}
+	}
+
+	_add(kWarmUpItemModules)->modules_ = moduleMask;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddLocale
+ */
+void
+GnWarmUpPlan::AddLocale(GnLocaleGroup group, GnLanguage language, GnRegion region, GnDescriptor descriptor, bool bSetGroupDefault)
+{
+	item* p_item = _add(kWarmUpItemLocale);
+
+	p_item->locale_group_ = group;
+	p_item->language_     = language;
+	p_item->region_       = region;
+	p_item->descriptor_   = descriptor;
+	p_item->set_default_  = bSetGroupDefault;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  AddList
+ */
+void
+GnWarmUpPlan::AddList(GnListType listType, GnLanguage language, GnRegion region, GnDescriptor descriptor)
+{
+	item* p_item = _add(kWarmUpItemList);
+
+	p_item->list_type_  = listType;
+	p_item->language_   = language;
+	p_item->region_     = region;
+	p_item->descriptor_ = descriptor;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ItemType
+ */
+GnWarmUpItemType
+GnWarmUpPlan::ItemType(gnsdk_uint32_t itemIndex) const throw (GnError)
+{
+	return _item(itemIndex)->type_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ItemReady
+ */
+bool
+GnWarmUpPlan::ItemReady(gnsdk_uint32_t itemIndex) const throw (GnError)
+{
+	return _item(itemIndex)->ready_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ItemElapsedMs
+ */
+gnsdk_uint32_t
+GnWarmUpPlan::ItemElapsedMs(gnsdk_uint32_t itemIndex) const throw (GnError)
+{
+	return _item(itemIndex)->elapsed_ms_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  ItemError
+ */
+const GnError*
+GnWarmUpPlan::ItemError(gnsdk_uint32_t itemIndex) const throw (GnError)
+{
+	return _item(itemIndex)->error_;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  Ready
+ */
+bool
+GnWarmUpPlan::Ready() const
+{
+	for (gnsdk_uint32_t i = 0; i < count_; i++)
+	{
+		if (!items_[i]->ready_)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _add
+ */
+GnWarmUpPlan::item*
+GnWarmUpPlan::_add(GnWarmUpItemType type)
+{
+	if (count_ == capacity_)
+	{
+		gnsdk_uint32_t	capacity = capacity_ ? capacity_ * 2 : 8;
+		item**			items    = new item*[capacity];
+
+		for (gnsdk_uint32_t i = 0; i < count_; i++)
+		{
+			items[i] = items_[i];
+		}
+		delete [] items_;
+
+		items_    = items;
+		capacity_ = capacity;
+	}
+
+	items_[count_] = new item(type);
+	return items_[count_++];
+}
+
+
+/*-----------------------------------------------------------------------------
+ *  _item
+ */
+GnWarmUpPlan::item*
+GnWarmUpPlan::_item(gnsdk_uint32_t itemIndex) const throw (GnError)
+{
+	if (itemIndex >= count_)
+	{
+		throw GnError(GNSDKERR_InvalidArg, "Warm up item index out of range");
+	}
+
+	return items_[itemIndex];
+}
+
+
+/******************************************************************************
+** GnManager
+*/
+
+/*-----------------------------------------------------------------------------
+ *  WarmUp
+ */
+bool
+GnManager::WarmUp(const GnUser& user, GnWarmUpPlan& plan) throw (GnError)
+{
+	gnsdk_uint64_t start = gn_thread::tick_ms();
+	gnsdk_uint32_t parallel = 0;
+	gnsdk_uint32_t threads;
+	gnsdk_uint32_t i;
+
+	for (i = 0; i < plan.count_; i++)
+	{
+		plan.items_[i]->reset();
+	}
+
+	/* locales and lists live in storage provided by modules, so modules come first */
+	for (i = 0; i < plan.count_; i++)
+	{
+		if (kWarmUpItemModules == plan.items_[i]->type_)
+		{
+			plan.items_[i]->load(user);
+		}
+		else
+		{
+			parallel += 1;
+		}
+	}
+
+	if (parallel)
+	{
+		threads = plan.threads_ ? plan.threads_ : gn_thread::hardware_concurrency();
+		if (threads > parallel)
+		{
+			threads = parallel;
+		}
+
+		gn_thread_pool pool(threads, parallel);
+
+		for (i = 0; i < plan.count_; i++)
+		{
+			if (kWarmUpItemModules != plan.items_[i]->type_)
+			{
+				pool.post(new GnWarmUpPlan::load_task(plan.items_[i], user));
+			}
+		}
+
+		pool.shutdown();
+	}
+
+	plan.elapsed_ms_ = (gnsdk_uint32_t)(gn_thread::tick_ms() - start);
+
+	return plan.Ready();
+}